@@ -0,0 +1,444 @@
+/**
+ * @file Autopilot.cpp
+ * @brief Implémentation du joueur automatique par recherche de chemin.
+ */
+
+#include "Autopilot.hpp"
+#include "../includes/GridCells.hpp"
+#include "../includes/InputQueue.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+const uint32_t Autopilot::SEARCH_BUDGET;
+const uint32_t Autopilot::NO_CELL;
+
+namespace
+{
+	const Input MOVES[4] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };	///< Ordre des voisins.
+}
+
+/**
+ * @brief Constructeur : les tampons seront dimensionnés au premier tick.
+ */
+Autopilot::Autopilot()
+	: _cells(nullptr), _width(0), _area(0), _generation(0), _markGeneration(0), _closest(NO_CELL),
+	  _exhausted(false), _step(0), _pathGoal(NO_CELL), _expectedHead(NO_CELL),
+	  _lastFood(NO_CELL), _hunger(0), _searches(0)
+{}
+
+/**
+ * @brief Constructeur : dimensionne tout de suite les tampons pour un plateau.
+ *
+ * Le premier tick d'une partie de cette taille n'alloue alors rien, et sa
+ * durée est celle des suivants.
+ *
+ * @param width Largeur du plateau.
+ * @param height Hauteur du plateau.
+ */
+Autopilot::Autopilot(int width, int height) : Autopilot()
+{
+	resize(width, static_cast<size_t>(width) * height);
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+Autopilot::~Autopilot() {}
+
+/**
+ * @brief Choisit la direction du prochain tick et mesure le temps de planification.
+ *
+ * @param game Partie en cours.
+ * @return La direction vers la case suivante du chemin, ou NONE.
+ */
+Input Autopilot::nextInput(const GameState& game)
+{
+	uint64_t start = InputQueue::now();
+	const Grid& grid = game.getGrid();
+	const Snake& snake = game.getSnake();
+
+	prepare(grid);
+	uint32_t head = cellIndex(snake.getHead(), _width);
+	uint32_t food = grid.contains(game.getFood()) ? cellIndex(game.getFood(), _width) : NO_CELL;
+
+	if (food != _lastFood)
+	{
+		_lastFood = food;
+		_hunger = 0;
+	}
+	++_hunger;
+
+	Input input;
+	if (food != NO_CELL && _pathGoal == food && _expectedHead == head && _step < _path.size()
+		&& isPassable(_path[_step]))
+		input = follow(head);
+	else
+		input = plan(snake, head, food);
+	_planNs.record(InputQueue::now() - start);
+	return input;
+}
+
+/**
+ * @brief Durée de chaque appel à nextInput(), en nanosecondes.
+ */
+const Histogram& Autopilot::getPlanTimes() const
+{
+	return _planNs;
+}
+
+/**
+ * @brief Nombre de recherches A* effectuées (les ticks qui suivent un chemin n'en font aucune).
+ */
+uint64_t Autopilot::getSearches() const
+{
+	return _searches;
+}
+
+/**
+ * @brief Pointe sur la grille de la partie et dimensionne les tampons à sa surface.
+ *
+ * Les tampons ne sont alloués qu'au premier tick (sauf s'ils l'ont été à la
+ * construction), ou si la surface change.
+ *
+ * @param grid Grille de la partie.
+ */
+void Autopilot::prepare(const Grid& grid)
+{
+	size_t area = static_cast<size_t>(grid.getWidth()) * grid.getHeight();
+
+	_cells = grid.getRow(0);
+	if (area != _area || grid.getWidth() != _width)
+		resize(grid.getWidth(), area);
+}
+
+/**
+ * @brief Dimensionne les tampons pour un plateau ; le chemin en cours est oublié.
+ *
+ * @param width Largeur du plateau.
+ * @param area Nombre de cases du plateau.
+ */
+void Autopilot::resize(int width, size_t area)
+{
+	_width = width;
+	_area = area;
+	_visits.assign(area, Visit{ 0, 0, NO_CELL });
+	_marks.assign(area, 0);
+	_open.clear();
+	_open.reserve(4 * static_cast<size_t>(SEARCH_BUDGET));
+	_later.clear();
+	_later.reserve(4 * static_cast<size_t>(SEARCH_BUDGET));
+	_path.clear();
+	_path.reserve(static_cast<size_t>(SEARCH_BUDGET) + 1);
+	_generation = 0;
+	_markGeneration = 0;
+	_pathGoal = NO_CELL;
+}
+
+/**
+ * @brief Calcule un nouveau chemin et renvoie sa première direction.
+ *
+ * Le chemin vers la nourriture est retenu s'il est sûr (voir isSafe()), ou
+ * s'il n'est qu'un début de chemin faute de budget. Sinon, la tête suit la
+ * queue (voir followTail()), sans rien retenir : la queue se déplace à
+ * chaque tick.
+ *
+ * Après autant de ticks sans manger que le plateau a de cases, un chemin
+ * vers la nourriture est suivi même s'il n'est pas sûr : plutôt que de
+ * tourner indéfiniment, l'autopilote prend le risque.
+ *
+ * @param snake Le serpent.
+ * @param head Case de la tête.
+ * @param food Case de la nourriture (NO_CELL : aucune).
+ */
+Input Autopilot::plan(const Snake& snake, uint32_t head, uint32_t food)
+{
+	uint32_t tail = cellIndex(snake.getTail(), _width);
+
+	_path.clear();
+	_step = 0;
+	_pathGoal = NO_CELL;
+	clearMarks();
+	if (food != NO_CELL)
+	{
+		bool starving = _hunger > _area;
+		if (search(head, food))
+		{
+			tracePath(head, food);
+			if (starving || isSafe(snake, food))
+			{
+				_pathGoal = food;
+				return follow(head);
+			}
+		}
+		else if (_exhausted && _closest != NO_CELL)
+		{
+			// Budget épuisé : on avance vers la case la plus proche, la suite viendra
+			tracePath(head, _closest);
+			_pathGoal = food;
+			return follow(head);
+		}
+	}
+
+	// Passer sur la nourriture la mangerait : le serpent grandirait là où ce n'est pas sûr
+	clearMarks();
+	if (food != NO_CELL)
+		mark(food, false);
+	Input input = followTail(head, tail);
+	if (input != Input::NONE)
+		return input;
+	return escape(head, tail);
+}
+
+/**
+ * @brief Recherche A* d'un chemin de `from` à `goal`.
+ *
+ * Les cases franchissables sont celles que isPassable() accepte ; le but
+ * l'est toujours (la queue libère sa case au tick suivant).
+ *
+ * Chaque pas coûte 1 et la distance de Manhattan change de 1 à chaque pas :
+ * l'estimation d'une case voisine est celle de la case développée, ou la
+ * dépasse de 2. La file de priorité se réduit donc à deux piles (estimation
+ * courante, et courante + 2), en O(1) au lieu d'un tas ; dépiler la
+ * dernière case ajoutée privilégie les chemins les plus avancés.
+ *
+ * Rien n'est effacé entre deux recherches : une case n'est valable que si
+ * sa génération (Visit::generation) est celle de la recherche en cours.
+ *
+ * @param from Case de départ.
+ * @param goal Case d'arrivée.
+ * @return true si le but est atteint. Sinon, _exhausted indique si le budget
+ *         est épuisé, et _closest est la case atteinte la plus proche du but.
+ */
+bool Autopilot::search(uint32_t from, uint32_t goal)
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	const int dx[4] = { 0, 0, -1, 1 };
+	const int dy[4] = { -1, 1, 0, 0 };
+	const int goalX = static_cast<int>(goal % _width);
+	const int goalY = static_cast<int>(goal / _width);
+
+	if (++_generation == 0)
+	{
+		std::fill(_visits.begin(), _visits.end(), Visit{ 0, 0, NO_CELL });
+		_generation = 1;
+	}
+	++_searches;
+	_open.clear();
+	_later.clear();
+	_closest = NO_CELL;
+	_exhausted = false;
+
+	uint32_t closestDistance = UINT32_MAX;
+	uint32_t expanded = 0;
+	uint32_t estimate = cellDistance(from, goal, _width);
+	_visits[from] = Visit{ _generation, 0, NO_CELL };
+	_open.push_back(Node{ 0, from });
+
+	for (;;)
+	{
+		if (_open.empty())
+		{
+			if (_later.empty())
+				return false;
+			_open.swap(_later);
+			estimate += 2;
+		}
+		Node node = _open.back();
+		_open.pop_back();
+		if (node.cost != _visits[node.cell].cost)
+			continue; // Entrée périmée : la case a été atteinte depuis par un chemin plus court
+		if (node.cell == goal)
+			return true;
+
+		uint32_t distance = estimate - node.cost;
+		if (distance < closestDistance && node.cell != from)
+		{
+			closestDistance = distance;
+			_closest = node.cell;
+		}
+		if (++expanded > SEARCH_BUDGET)
+		{
+			_exhausted = true;
+			return false;
+		}
+
+		// Coordonnées calculées une fois par case développée, pas par voisine
+		int x = static_cast<int>(node.cell % _width);
+		int y = static_cast<int>(node.cell / _width);
+		for (int i = 0; i < 4; ++i)
+		{
+			uint32_t next = node.cell + offsets[i];
+			if (next != goal && !isPassable(next))
+				continue;
+
+			uint32_t cost = node.cost + 1;
+			Visit& visit = _visits[next];
+			if (visit.generation == _generation && visit.cost <= cost)
+				continue;
+			visit = Visit{ _generation, cost, node.cell };
+			// Un pas vers le but garde l'estimation, un pas qui s'en éloigne l'augmente de 2
+			bool closer = std::abs(x + dx[i] - goalX) + std::abs(y + dy[i] - goalY)
+				< std::abs(x - goalX) + std::abs(y - goalY);
+			(closer ? _open : _later).push_back(Node{ cost, next });
+		}
+	}
+}
+
+/**
+ * @brief Remplit _path avec le chemin trouvé par la dernière recherche, sans la case de départ.
+ *
+ * @param from Case de départ de la recherche.
+ * @param to Case atteinte par la recherche.
+ */
+void Autopilot::tracePath(uint32_t from, uint32_t to)
+{
+	_path.clear();
+	_step = 0;
+	for (uint32_t cell = to; cell != from; cell = _visits[cell].parent)
+		_path.push_back(cell);
+	std::reverse(_path.begin(), _path.end());
+}
+
+/**
+ * @brief Vérifie qu'après avoir suivi _path et mangé, la tête peut encore rejoindre la queue.
+ *
+ * Le corps est reconstitué tel qu'il sera après le repas : la tête sur la
+ * nourriture, puis le chemin parcouru à rebours, puis le début de l'ancien
+ * corps, sur la longueur du serpent plus un. Les cases de
+ * ce corps sont marquées occupées, celles que l'ancien corps aura quittées
+ * libres, puis une recherche relie la nouvelle tête à la nouvelle queue.
+ * Une recherche à court de budget a trouvé plus de place qu'il n'en faut :
+ * le chemin est alors jugé sûr.
+ *
+ * @param snake Le serpent, avant de suivre le chemin.
+ * @param food Case de la nourriture (dernière case de _path).
+ */
+bool Autopilot::isSafe(const Snake& snake, uint32_t food)
+{
+	size_t steps = _path.size();
+	size_t length = snake.getLength();
+
+	// Le corps après le repas : [_path à rebours, ancien corps], length + 1 cases
+	for (size_t j = 1; j < std::min(steps, length + 1); ++j)
+		mark(_path[steps - 1 - j], false);
+	for (size_t i = length + 1 > steps ? length + 1 - steps : 0; i < length; ++i)
+		mark(cellIndex(snake.getSegment(i), _width), true);
+	uint32_t newTail = steps > length ? _path[steps - 1 - length]
+		: cellIndex(snake.getSegment(length - steps), _width);
+
+	bool reached = search(food, newTail);
+	clearMarks();
+	return reached || _exhausted;
+}
+
+/**
+ * @brief Avance d'une case sur _path.
+ *
+ * @param head Case de la tête.
+ */
+Input Autopilot::follow(uint32_t head)
+{
+	uint32_t next = _path[_step++];
+
+	_expectedHead = next;
+	if (_step == _path.size())
+		_pathGoal = NO_CELL;
+	return directionTo(head, next, _width);
+}
+
+/**
+ * @brief Suit la queue de loin : la case voisine la plus éloignée de la queue d'où elle reste accessible.
+ *
+ * Le plus court chemin vers la queue enroulerait le serpent sur lui-même,
+ * parfois autour de la nourriture, qu'il ne pourrait alors plus atteindre ;
+ * s'éloigner de la queue déroule au contraire le corps. Une recherche à
+ * court de budget a trouvé assez de place : la case est retenue.
+ *
+ * @param head Case de la tête.
+ * @param tail Case de la queue (libérée au prochain tick).
+ * @return La direction choisie, ou NONE si la queue n'est accessible depuis aucune voisine.
+ */
+Input Autopilot::followTail(uint32_t head, uint32_t tail)
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	Input best = Input::NONE;
+	uint32_t bestDistance = 0;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		uint32_t next = head + offsets[i];
+		if (next != tail && !isPassable(next))
+			continue;
+		uint32_t distance = cellDistance(next, tail, _width);
+		if (best != Input::NONE && distance <= bestDistance)
+			continue;
+		if (next == tail || search(next, tail) || _exhausted)
+		{
+			best = MOVES[i];
+			bestDistance = distance;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Dernier recours : la case voisine libre qui a le plus de voisines libres.
+ *
+ * @param head Case de la tête.
+ * @param tail Case de la queue (libérée au prochain tick).
+ * @return La direction choisie, ou NONE si aucune case voisine n'est libre.
+ */
+Input Autopilot::escape(uint32_t head, uint32_t tail) const
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	Input best = Input::NONE;
+	int bestFree = -1;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		uint32_t next = head + offsets[i];
+		if (next != tail && !isPassable(next))
+			continue;
+		int free = 0;
+		for (int32_t offset : offsets)
+			free += isPassable(next + offset);
+		if (free > bestFree)
+		{
+			bestFree = free;
+			best = MOVES[i];
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Case que la tête peut occuper : vide ou nourriture, sauf marque contraire.
+ */
+bool Autopilot::isPassable(uint32_t cell) const
+{
+	uint32_t marked = _marks[cell];
+
+	if ((marked >> 1) == _markGeneration)
+		return marked & 1;
+	return isPassableCell(_cells[cell]);
+}
+
+/**
+ * @brief Efface toutes les marques, en changeant simplement de génération.
+ */
+void Autopilot::clearMarks()
+{
+	if (++_markGeneration >= (1u << 31))
+	{
+		std::fill(_marks.begin(), _marks.end(), 0);
+		_markGeneration = 1;
+	}
+}
+
+/**
+ * @brief Force une case libre ou occupée jusqu'au prochain clearMarks().
+ */
+void Autopilot::mark(uint32_t cell, bool open)
+{
+	_marks[cell] = (_markGeneration << 1) | (open ? 1 : 0);
+}
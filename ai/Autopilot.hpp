@@ -0,0 +1,110 @@
+/**
+ * @file Autopilot.hpp
+ * @brief Déclaration de la classe Autopilot, joueur automatique par recherche de chemin.
+ *
+ * L'autopilote cherche (A*) un chemin de la tête à la nourriture sur la
+ * grille d'occupation, le suit tant qu'il reste valable, et se rabat sur la
+ * poursuite de sa propre queue lorsque manger l'enfermerait. Ses tampons
+ * de recherche sont dimensionnés une fois sur la surface du plateau (dès
+ * la construction si elle est connue) puis réutilisés à chaque tick :
+ * planifier n'alloue plus rien.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../core/GameState.hpp"
+#include "../core/Histogram.hpp"
+#include "../includes/IController.hpp"
+
+/**
+ * @class Autopilot
+ * @brief Contrôleur qui mène le serpent à la nourriture par le plus court chemin sûr.
+ *
+ * À chaque tick :
+ * - le chemin calculé précédemment est suivi s'il mène toujours à la
+ *   nourriture et que sa case suivante est libre (O(1)) ;
+ * - sinon, A* (distance de Manhattan) cherche un nouveau chemin, retenu
+ *   seulement si, une fois la nourriture mangée, la tête peut encore
+ *   rejoindre la queue (le serpent n'est pas enfermé) ;
+ * - à défaut, le serpent suit sa queue en s'en tenant le plus loin
+ *   possible, ou à défaut encore se dirige vers la case voisine la plus
+ *   dégagée.
+ *
+ * Chaque recherche développe au plus SEARCH_BUDGET cases, ce qui borne la
+ * durée d'un tick quelle que soit la taille du plateau : une recherche à
+ * court de budget suit le début du chemin vers la case la plus proche du
+ * but, et sera reprise plus loin.
+ */
+class Autopilot : public IController
+{
+	public:
+		static const uint32_t SEARCH_BUDGET = 1 << 12;	///< Cases développées au plus par recherche.
+
+		Autopilot();
+		Autopilot(int width, int height);
+		Autopilot(const Autopilot&) = delete;
+		Autopilot& operator=(const Autopilot&) = delete;
+		~Autopilot();
+
+		Input				nextInput(const GameState& game) override;
+		const Histogram&	getPlanTimes() const;
+		uint64_t			getSearches() const;
+
+	private:
+		static const uint32_t NO_CELL = UINT32_MAX;	///< Case absente.
+
+		/**
+		 * @brief Case en attente dans la file de priorité d'A*.
+		 */
+		struct Node
+		{
+			uint32_t	cost;		///< Coût depuis le départ au moment de l'ajout.
+			uint32_t	cell;		///< Indice de la case.
+		};
+
+		/**
+		 * @brief État d'une case pendant une recherche, regroupé pour n'occuper qu'une ligne de cache.
+		 */
+		struct Visit
+		{
+			uint32_t	generation;	///< Recherche qui a atteint la case (les autres champs n'ont de sens que pour elle).
+			uint32_t	cost;		///< Coût depuis le départ.
+			uint32_t	parent;		///< Case précédente sur le meilleur chemin.
+		};
+
+		void		prepare(const Grid& grid);
+		void		resize(int width, size_t area);
+		Input		plan(const Snake& snake, uint32_t head, uint32_t food);
+		bool		search(uint32_t from, uint32_t goal);
+		void		tracePath(uint32_t from, uint32_t to);
+		bool		isSafe(const Snake& snake, uint32_t food);
+		Input		follow(uint32_t head);
+		Input		followTail(uint32_t head, uint32_t tail);
+		Input		escape(uint32_t head, uint32_t tail) const;
+		bool		isPassable(uint32_t cell) const;
+		void		clearMarks();
+		void		mark(uint32_t cell, bool open);
+
+		const Cell*				_cells;			///< Grille de la partie en cours (le temps d'un appel).
+		int						_width;			///< Largeur du plateau.
+		size_t					_area;			///< Nombre de cases des tampons.
+		std::vector<Visit>		_visits;		///< État de chaque case pour la recherche en cours.
+		std::vector<uint32_t>	_marks;			///< Cases forcées libres ou occupées (génération << 1 | libre).
+		std::vector<Node>		_open;			///< Cases à l'estimation courante (vidée, jamais libérée).
+		std::vector<Node>		_later;			///< Cases à l'estimation courante + 2.
+		std::vector<uint32_t>	_path;			///< Chemin suivi, de la première case au but.
+		uint32_t				_generation;	///< Génération de la recherche en cours.
+		uint32_t				_markGeneration;	///< Génération des marques en vigueur.
+		uint32_t				_closest;		///< Case la plus proche du but atteinte par la dernière recherche.
+		bool					_exhausted;		///< La dernière recherche a épuisé son budget.
+		size_t					_step;			///< Prochaine case de _path.
+		uint32_t				_pathGoal;		///< Nourriture visée par _path (NO_CELL : à recalculer).
+		uint32_t				_expectedHead;	///< Position de la tête si _path a été suivi.
+		uint32_t				_lastFood;		///< Nourriture vue au tick précédent.
+		size_t					_hunger;		///< Ticks écoulés depuis que la nourriture a changé.
+		uint64_t				_searches;		///< Recherches effectuées.
+		Histogram				_planNs;		///< Durée de chaque appel à nextInput().
+};
@@ -0,0 +1,552 @@
+/**
+ * @file HamiltonCycle.cpp
+ * @brief Implémentation de la construction et du cache des circuits hamiltoniens.
+ */
+
+#include "HamiltonCycle.hpp"
+#include "../includes/GridCells.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+# error "Cycle caches are stored little-endian"
+#endif
+
+const uint32_t HamiltonCycle::OFF_CYCLE;
+
+namespace
+{
+	const char		MAGIC[4] = { 'N', 'I', 'B', 'H' };	///< Signature du fichier.
+	const uint32_t	VERSION = 1;						///< Version du format.
+	const size_t	HEADER_SIZE = 64;					///< Taille de l'en-tête, en octets.
+
+	/**
+	 * @brief En-tête du fichier de cache, tel qu'il est écrit.
+	 */
+	struct CacheHeader
+	{
+		char		magic[4];	///< "NIBH".
+		uint32_t	version;	///< Version du format.
+		uint32_t	width;		///< Largeur du plateau.
+		uint32_t	height;		///< Hauteur du plateau.
+		uint64_t	seed;		///< Graine des obstacles.
+		uint64_t	hash;		///< Empreinte des obstacles.
+		uint64_t	length;		///< Nombre de cases du circuit.
+		uint8_t		padding[HEADER_SIZE - 40];	///< Complète l'en-tête à 64 octets (alignement des tableaux).
+	};
+	static_assert(sizeof(CacheHeader) == HEADER_SIZE, "cycle cache header must be 64 bytes");
+
+	/**
+	 * @brief Case que le circuit peut emprunter : tout sauf les murs et les obstacles.
+	 */
+	bool isUsable(const Cell* cells, uint32_t cell)
+	{
+		return cells[cell] != Cell::WALL && cells[cell] != Cell::OBSTACLE;
+	}
+}
+
+/**
+ * @brief Construit le circuit du plateau d'une partie.
+ *
+ * Seuls les murs et les obstacles comptent : le serpent et la nourriture
+ * sont ignorés, si bien que le circuit vaut pour toutes les parties de même
+ * plateau et de mêmes obstacles.
+ *
+ * @param game Partie dont le plateau est parcouru.
+ * @throw std::runtime_error si aucun bloc de 2x2 cases n'est libre.
+ */
+HamiltonCycle::HamiltonCycle(const GameState& game)
+	: _width(game.getGrid().getWidth()), _height(game.getGrid().getHeight()),
+	  _seed(obstacleSeed(game)), _hash(obstacleHash(game)), _length(0), _order(nullptr), _path(nullptr)
+{
+	build(game.getGrid());
+}
+
+/**
+ * @brief Relit un circuit depuis le cache, sans le recalculer.
+ *
+ * Le fichier est projeté en mémoire puis parcouru une fois pour vérifier
+ * le circuit (voir check()) : HamiltonPilot indexe ensuite les deux
+ * tableaux sans contrôle.
+ *
+ * @param path Fichier de cache (voir cachePath()).
+ * @param game Partie dont le plateau doit correspondre au cache.
+ * @throw std::runtime_error si le fichier est illisible, d'un autre format,
+ *        calculé pour un autre plateau, ou si son circuit est incohérent.
+ */
+HamiltonCycle::HamiltonCycle(const std::string& path, const GameState& game)
+	: _width(game.getGrid().getWidth()), _height(game.getGrid().getHeight()),
+	  _seed(obstacleSeed(game)), _hash(obstacleHash(game)), _length(0), _file(path),
+	  _order(nullptr), _path(nullptr)
+{
+	size_t area = static_cast<size_t>(_width) * _height;
+	CacheHeader header;
+
+	if (_file.size() < HEADER_SIZE)
+		throw std::runtime_error(path + " is not a cycle cache");
+	std::memcpy(&header, _file.data(), HEADER_SIZE);
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+		throw std::runtime_error(path + " is not a cycle cache");
+	if (header.width != static_cast<uint32_t>(_width) || header.height != static_cast<uint32_t>(_height)
+		|| header.seed != _seed || header.hash != _hash || header.length == 0 || header.length > area
+		|| _file.size() != HEADER_SIZE + (area + header.length) * sizeof(uint32_t))
+		throw std::runtime_error(path + ": cycle cache for another board");
+
+	_length = header.length;
+	_order = reinterpret_cast<const uint32_t*>(_file.data() + HEADER_SIZE);
+	_path = _order + area;
+	check(game.getGrid(), path);
+}
+
+/**
+ * @brief Destructeur : libère la projection éventuelle.
+ */
+HamiltonCycle::~HamiltonCycle() {}
+
+/**
+ * @brief Relit le circuit du cache ou, à défaut, le construit et l'y écrit.
+ *
+ * Un cache impossible à écrire (répertoire absent ou en lecture seule)
+ * n'empêche pas de jouer : le circuit construit est renvoyé quand même.
+ * Un répertoire qui n'est pas privé (voir isPrivateDirectory()) n'est ni
+ * lu ni écrit : un autre utilisateur pourrait y placer ou modifier le
+ * fichier projeté.
+ *
+ * @param game Partie dont le plateau est parcouru.
+ * @param directory Répertoire du cache (vide : aucun cache).
+ * @param cached [out] Si non nul, indique que le circuit vient du cache.
+ * @return Le circuit du plateau.
+ * @throw std::runtime_error si le plateau n'a aucun circuit.
+ */
+std::unique_ptr<HamiltonCycle> HamiltonCycle::load(const GameState& game, const std::string& directory,
+	bool* cached)
+{
+	bool usable = isPrivateDirectory(directory);
+	std::string path = cachePath(directory, game);
+
+	if (usable)
+	{
+		try {
+			std::unique_ptr<HamiltonCycle> cycle(new HamiltonCycle(path, game));
+			if (cached)
+				*cached = true;
+			return cycle;
+		} catch (const std::runtime_error&) {
+			// Absent, périmé ou corrompu : on le recalcule
+		}
+	}
+
+	std::unique_ptr<HamiltonCycle> cycle(new HamiltonCycle(game));
+	if (cached)
+		*cached = false;
+	if (usable)
+	{
+		try {
+			cycle->save(path);
+		} catch (const std::runtime_error&) {
+			// Cache en lecture seule : le circuit sera recalculé la prochaine fois
+		}
+	}
+	return cycle;
+}
+
+/**
+ * @brief Fichier de cache d'un plateau : sa taille et la graine de ses obstacles le désignent.
+ *
+ * @param directory Répertoire du cache.
+ * @param game Partie dont le plateau est parcouru.
+ */
+std::string HamiltonCycle::cachePath(const std::string& directory, const GameState& game)
+{
+	std::ostringstream path;
+
+	path << directory << "/nibbler-cycle-" << game.getGrid().getWidth() << "x" << game.getGrid().getHeight()
+		<< "-" << std::hex << obstacleSeed(game) << ".bin";
+	return path.str();
+}
+
+/**
+ * @brief Répertoire de cache par défaut : $XDG_CACHE_HOME/nibbler, sinon ~/.cache/nibbler.
+ *
+ * Les répertoires manquants sont créés avec les droits 0700.
+ *
+ * @return Le répertoire, ou une chaîne vide si aucun n'est connu (ni
+ *         XDG_CACHE_HOME ni HOME).
+ */
+std::string HamiltonCycle::defaultCacheDirectory()
+{
+	const char* xdg = std::getenv("XDG_CACHE_HOME");
+	const char* home = std::getenv("HOME");
+	std::string base;
+
+	if (xdg && *xdg == '/')
+		base = xdg;
+	else if (home && *home == '/')
+		base = std::string(home) + "/.cache";
+	else
+		return "";
+	mkdir(base.c_str(), 0700);
+	std::string directory = base + "/nibbler";
+	mkdir(directory.c_str(), 0700);
+	return directory;
+}
+
+/**
+ * @brief Indique qu'un répertoire n'est accessible qu'à l'utilisateur courant.
+ *
+ * Le répertoire doit exister (sans être un lien symbolique), appartenir à
+ * l'utilisateur et n'accorder aucun droit au groupe ni aux autres.
+ *
+ * @param directory Répertoire à examiner.
+ */
+bool HamiltonCycle::isPrivateDirectory(const std::string& directory)
+{
+	struct stat info;
+
+	if (directory.empty() || lstat(directory.c_str(), &info) != 0)
+		return false;
+	return S_ISDIR(info.st_mode) && info.st_uid == getuid() && (info.st_mode & 077) == 0;
+}
+
+/**
+ * @brief Écrit le circuit dans un fichier de cache.
+ *
+ * Le fichier est écrit sous un nom temporaire puis renommé : un circuit
+ * projeté depuis l'ancien fichier reste valable.
+ *
+ * @param path Chemin du fichier.
+ * @throw std::runtime_error si le fichier ne peut pas être écrit.
+ */
+void HamiltonCycle::save(const std::string& path) const
+{
+	size_t area = static_cast<size_t>(_width) * _height;
+	std::string tempPath = path + ".tmp";
+	CacheHeader header;
+
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.width = static_cast<uint32_t>(_width);
+	header.height = static_cast<uint32_t>(_height);
+	header.seed = _seed;
+	header.hash = _hash;
+	header.length = _length;
+
+	std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+	if (!file)
+		throw std::runtime_error("Failed to open " + tempPath);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(_order), area * sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(_path), _length * sizeof(uint32_t));
+	file.close();
+	if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0)
+	{
+		std::remove(tempPath.c_str());
+		throw std::runtime_error("Failed to write " + path);
+	}
+}
+
+/**
+ * @brief Largeur du plateau.
+ */
+int HamiltonCycle::getWidth() const
+{
+	return _width;
+}
+
+/**
+ * @brief Hauteur du plateau.
+ */
+int HamiltonCycle::getHeight() const
+{
+	return _height;
+}
+
+/**
+ * @brief Nombre de cases du circuit.
+ */
+size_t HamiltonCycle::getLength() const
+{
+	return _length;
+}
+
+/**
+ * @brief Indique que le circuit a été relu du cache.
+ */
+bool HamiltonCycle::isMapped() const
+{
+	return _file.data() != nullptr;
+}
+
+/**
+ * @brief Position de chaque case sur le circuit (OFF_CYCLE hors circuit), ligne par ligne.
+ */
+const uint32_t* HamiltonCycle::getOrder() const
+{
+	return _order;
+}
+
+/**
+ * @brief Cases du circuit dans l'ordre de parcours (getLength() cases).
+ */
+const uint32_t* HamiltonCycle::getPath() const
+{
+	return _path;
+}
+
+/**
+ * @brief Graine qui a placé les obstacles, ou 0 s'il n'y en a pas.
+ */
+uint64_t HamiltonCycle::obstacleSeed(const GameState& game)
+{
+	return game.getObstacles().empty() ? 0 : game.getSeed();
+}
+
+/**
+ * @brief Empreinte des obstacles, pour écarter un cache qui ne correspond plus au plateau.
+ */
+uint64_t HamiltonCycle::obstacleHash(const GameState& game)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	for (const Point& p : game.getObstacles())
+	{
+		hash = (hash ^ ((static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32) | static_cast<uint32_t>(p.y)))
+			* 0x100000001b3ULL;
+		hash ^= hash >> 29;
+	}
+	return hash;
+}
+
+/**
+ * @brief Construit le circuit puis numérote ses cases.
+ *
+ * @param grid Grille de la partie.
+ */
+void HamiltonCycle::build(const Grid& grid)
+{
+	_next.assign(static_cast<size_t>(_width) * _height, OFF_CYCLE);
+	linkBlocks(grid);
+	insertPairs(grid);
+	number();
+	std::vector<uint32_t>().swap(_next);
+}
+
+/**
+ * @brief Raccorde en un seul circuit les blocs de 2x2 cases libres.
+ *
+ * Chaque bloc est d'abord un circuit de quatre cases, parcouru dans le
+ * sens des aiguilles d'une montre. Un parcours en largeur regroupe les
+ * blocs voisins en composantes ; seule la plus grande est gardée, ses
+ * autres cases seront reprises par insertPairs(). Le long de chaque arête
+ * de l'arbre du parcours, les deux côtés qui se font face sont remplacés
+ * par deux arêtes qui les croisent, ce qui fusionne les deux circuits.
+ *
+ * @param grid Grille de la partie.
+ */
+void HamiltonCycle::linkBlocks(const Grid& grid)
+{
+	const Cell* cells = grid.getRow(0);
+	const uint32_t w = static_cast<uint32_t>(_width);
+	const size_t columns = static_cast<size_t>(_width - 2) / 2;
+	const size_t blocks = columns * static_cast<size_t>((_height - 2) / 2);
+
+	// Case en haut à gauche de chaque bloc
+	auto corner = [&](size_t block) {
+		return static_cast<uint32_t>((1 + 2 * (block / columns)) * w + 1 + 2 * (block % columns));
+	};
+	auto isFree = [&](size_t block) {
+		uint32_t c = corner(block);
+		return isUsable(cells, c) && isUsable(cells, c + 1) && isUsable(cells, c + w) && isUsable(cells, c + w + 1);
+	};
+
+	std::vector<uint32_t> component(blocks, OFF_CYCLE);
+	std::vector<uint32_t> parent(blocks, OFF_CYCLE);
+	std::vector<uint32_t> queue;
+	queue.reserve(blocks);
+	uint32_t best = OFF_CYCLE;
+	size_t bestSize = 0;
+
+	for (size_t root = 0; root < blocks; ++root)
+	{
+		if (component[root] != OFF_CYCLE || !isFree(root))
+			continue;
+		queue.clear();
+		queue.push_back(static_cast<uint32_t>(root));
+		component[root] = static_cast<uint32_t>(root);
+		for (size_t i = 0; i < queue.size(); ++i)
+		{
+			size_t block = queue[i];
+			size_t x = block % columns;
+			size_t neighbours[4] = { block - columns, block + columns, block - 1, block + 1 };
+			bool inside[4] = { block >= columns, block + columns < blocks, x > 0, x + 1 < columns };
+			for (int n = 0; n < 4; ++n)
+			{
+				if (!inside[n] || component[neighbours[n]] != OFF_CYCLE || !isFree(neighbours[n]))
+					continue;
+				component[neighbours[n]] = static_cast<uint32_t>(root);
+				parent[neighbours[n]] = static_cast<uint32_t>(block);
+				queue.push_back(static_cast<uint32_t>(neighbours[n]));
+			}
+		}
+		if (queue.size() > bestSize)
+		{
+			bestSize = queue.size();
+			best = static_cast<uint32_t>(root);
+		}
+	}
+
+	for (size_t block = 0; block < blocks; ++block)
+	{
+		if (component[block] != best || best == OFF_CYCLE)
+			continue;
+		uint32_t c = corner(block);
+		_next[c] = c + 1;
+		_next[c + 1] = c + w + 1;
+		_next[c + w + 1] = c + w;
+		_next[c + w] = c;
+	}
+	for (size_t block = 0; block < blocks; ++block)
+	{
+		if (component[block] != best || parent[block] == OFF_CYCLE)
+			continue;
+		size_t first = std::min<size_t>(block, parent[block]);
+		size_t second = std::max<size_t>(block, parent[block]);
+		uint32_t a = corner(first);
+		uint32_t b = corner(second);
+		if (second == first + 1)
+		{
+			// Côte à côte : le côté droit de a et le côté gauche de b se croisent
+			_next[a + 1] = b;
+			_next[b + w] = a + w + 1;
+		}
+		else
+		{
+			// L'un sous l'autre : le bas de a et le haut de b se croisent
+			_next[a + w + 1] = b + 1;
+			_next[b] = a + w;
+		}
+	}
+}
+
+/**
+ * @brief Insère dans le circuit les cases libres qui n'y sont pas, deux par deux.
+ *
+ * Une arête a -> b du circuit, et les deux cases u et v qui la longent d'un
+ * même côté, forment un carré : si u et v sont libres et hors du circuit,
+ * a -> b devient a -> u -> v -> b. Les passes se répètent tant qu'elles
+ * insèrent des cases, chaque insertion pouvant en permettre d'autres.
+ *
+ * @param grid Grille de la partie.
+ */
+void HamiltonCycle::insertPairs(const Grid& grid)
+{
+	const Cell* cells = grid.getRow(0);
+	const uint32_t w = static_cast<uint32_t>(_width);
+	const uint32_t area = static_cast<uint32_t>(_next.size());
+	bool inserted = true;
+
+	while (inserted)
+	{
+		inserted = false;
+		for (uint32_t a = 0; a < area; ++a)
+		{
+			uint32_t b = _next[a];
+			if (b == OFF_CYCLE)
+				continue;
+			// Une arête horizontale est longée en haut et en bas, une verticale à gauche et à droite
+			bool horizontal = b == a + 1 || a == b + 1;
+			uint32_t sides[2][2] = { { a - (horizontal ? w : 1), b - (horizontal ? w : 1) },
+				{ a + (horizontal ? w : 1), b + (horizontal ? w : 1) } };
+			for (const uint32_t* side : sides)
+			{
+				uint32_t u = side[0];
+				uint32_t v = side[1];
+				if (_next[u] != OFF_CYCLE || _next[v] != OFF_CYCLE || !isUsable(cells, u) || !isUsable(cells, v))
+					continue;
+				_next[a] = u;
+				_next[u] = v;
+				_next[v] = b;
+				inserted = true;
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Vérifie un circuit relu du cache avant de s'en servir.
+ *
+ * Le chemin doit passer une seule fois par des cases utilisables du
+ * plateau, chacune voisine de la suivante (la dernière de la première), et
+ * les positions doivent en être l'inverse exact : OFF_CYCLE pour toutes les
+ * autres cases.
+ *
+ * @param grid Grille de la partie.
+ * @param path Fichier de cache (pour le message d'erreur).
+ * @throw std::runtime_error si le circuit est incohérent.
+ */
+void HamiltonCycle::check(const Grid& grid, const std::string& path) const
+{
+	const Cell* cells = grid.getRow(0);
+	const size_t area = static_cast<size_t>(_width) * _height;
+	size_t onCycle = 0;
+
+	for (size_t cell = 0; cell < area; ++cell)
+	{
+		uint32_t position = _order[cell];
+		if (position == OFF_CYCLE)
+			continue;
+		if (position >= _length || _path[position] != cell)
+			throw std::runtime_error(path + ": corrupted cycle cache");
+		++onCycle;
+	}
+	if (onCycle != _length)
+		throw std::runtime_error(path + ": corrupted cycle cache");
+
+	for (size_t i = 0; i < _length; ++i)
+	{
+		uint32_t a = _path[i];
+		uint32_t b = _path[i + 1 < _length ? i + 1 : 0];
+		if (a >= area || _order[a] != i || !isUsable(cells, a) || cellDistance(a, b, _width) != 1)
+			throw std::runtime_error(path + ": corrupted cycle cache");
+	}
+}
+
+/**
+ * @brief Numérote les cases en parcourant le circuit depuis sa première case (ligne par ligne).
+ *
+ * @throw std::runtime_error si le circuit est vide.
+ */
+void HamiltonCycle::number()
+{
+	size_t area = _next.size();
+	size_t start = 0;
+
+	while (start < area && _next[start] == OFF_CYCLE)
+		++start;
+	if (start == area)
+		throw std::runtime_error("HamiltonCycle: the board has no free 2x2 area");
+
+	_orderStore.assign(area, OFF_CYCLE);
+	_pathStore.clear();
+	_pathStore.reserve(area);
+	uint32_t cell = static_cast<uint32_t>(start);
+	do
+	{
+		_orderStore[cell] = static_cast<uint32_t>(_pathStore.size());
+		_pathStore.push_back(cell);
+		cell = _next[cell];
+	} while (cell != start);
+
+	_length = _pathStore.size();
+	_order = _orderStore.data();
+	_path = _pathStore.data();
+}
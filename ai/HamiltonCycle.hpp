@@ -0,0 +1,90 @@
+/**
+ * @file HamiltonCycle.hpp
+ * @brief Déclaration de la classe HamiltonCycle, circuit passant une fois par chaque case du plateau.
+ *
+ * Le circuit est construit par blocs de 2x2 cases : chaque bloc sans
+ * obstacle forme un petit circuit, et un arbre couvrant des blocs les
+ * raccorde en un seul. Les cases restantes (bande d'une case sur un côté
+ * impair, blocs entamés par un obstacle) sont ensuite insérées deux par
+ * deux le long du circuit. Sans obstacle, toutes les cases sont couvertes
+ * dès qu'un côté intérieur du plateau est pair ; avec deux côtés impairs,
+ * il en reste une (un circuit sur une grille passe par autant de cases
+ * « noires » que de « blanches »).
+ *
+ * Le résultat ne dépend que du plateau et des obstacles : il est conservé
+ * dans un fichier de cache, relu par projection (mmap) sans rien recalculer.
+ * Le cache n'est lu et écrit que dans un répertoire privé de l'utilisateur
+ * (voir defaultCacheDirectory()), et un circuit relu est vérifié avant
+ * d'être utilisé : un fichier incohérent est reconstruit.
+ *
+ * Format du cache (entiers natifs, little-endian) : en-tête de 64 octets
+ * ("NIBH", version (u32), largeur (u32), hauteur (u32), graine des
+ * obstacles (u64), empreinte des obstacles (u64), longueur du circuit
+ * (u64)), puis la position de chaque case sur le circuit (u32 par case,
+ * OFF_CYCLE hors circuit), puis les cases du circuit dans l'ordre (u32).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../core/GameState.hpp"
+#include "../core/MappedFile.hpp"
+
+/**
+ * @class HamiltonCycle
+ * @brief Ordre de parcours des cases libres d'un plateau (murs et obstacles exclus).
+ *
+ * Les cases sont désignées par leur indice dans la grille (y * largeur + x).
+ * Non copiable : un circuit relu du cache reste projeté jusqu'à sa destruction.
+ */
+class HamiltonCycle
+{
+	public:
+		static const uint32_t OFF_CYCLE = UINT32_MAX;	///< Position d'une case hors du circuit.
+
+		explicit HamiltonCycle(const GameState& game);
+		HamiltonCycle(const std::string& path, const GameState& game);
+		HamiltonCycle(const HamiltonCycle&) = delete;
+		HamiltonCycle& operator=(const HamiltonCycle&) = delete;
+		~HamiltonCycle();
+
+		static std::unique_ptr<HamiltonCycle>	load(const GameState& game, const std::string& directory,
+													bool* cached = nullptr);
+		static std::string	cachePath(const std::string& directory, const GameState& game);
+		static std::string	defaultCacheDirectory();
+		static bool			isPrivateDirectory(const std::string& directory);
+
+		void			save(const std::string& path) const;
+		int				getWidth() const;
+		int				getHeight() const;
+		size_t			getLength() const;
+		bool			isMapped() const;
+		const uint32_t*	getOrder() const;
+		const uint32_t*	getPath() const;
+
+	private:
+		static uint64_t	obstacleSeed(const GameState& game);
+		static uint64_t	obstacleHash(const GameState& game);
+
+		void	build(const Grid& grid);
+		void	linkBlocks(const Grid& grid);
+		void	insertPairs(const Grid& grid);
+		void	number();
+		void	check(const Grid& grid, const std::string& path) const;
+
+		int						_width;		///< Largeur du plateau.
+		int						_height;	///< Hauteur du plateau.
+		uint64_t				_seed;		///< Graine des obstacles (0 sans obstacle).
+		uint64_t				_hash;		///< Empreinte des obstacles.
+		size_t					_length;	///< Nombre de cases du circuit.
+		std::vector<uint32_t>	_next;		///< Case suivante sur le circuit (construction seulement).
+		std::vector<uint32_t>	_orderStore;	///< Positions, si le circuit a été construit.
+		std::vector<uint32_t>	_pathStore;		///< Cases dans l'ordre, si le circuit a été construit.
+		MappedFile				_file;		///< Cache projeté, si le circuit en a été relu.
+		const uint32_t*			_order;		///< Position de chaque case sur le circuit.
+		const uint32_t*			_path;		///< Cases du circuit, dans l'ordre.
+};
@@ -0,0 +1,456 @@
+/**
+ * @file HamiltonPilot.cpp
+ * @brief Implémentation du joueur automatique qui suit un circuit hamiltonien.
+ */
+
+#include <algorithm>
+#include "HamiltonPilot.hpp"
+#include "../includes/GridCells.hpp"
+#include "../includes/InputQueue.hpp"
+
+const uint32_t HamiltonPilot::NO_CELL;
+const size_t HamiltonPilot::MAX_DETOUR;
+const uint32_t HamiltonPilot::DETOUR_BUDGET;
+const size_t HamiltonPilot::REGION_LIMIT;
+const uint32_t HamiltonPilot::ENTRY_RETRY;
+
+/**
+ * @brief Constructeur : le circuit doit rester valable aussi longtemps que le contrôleur.
+ *
+ * @param cycle Circuit du plateau de jeu.
+ */
+HamiltonPilot::HamiltonPilot(const HamiltonCycle& cycle)
+	: _cycle(cycle), _order(cycle.getOrder()), _path(cycle.getPath()),
+	  _length(static_cast<uint32_t>(cycle.getLength())), _width(cycle.getWidth()), _cells(nullptr),
+	  _base(0), _tail(NO_CELL), _aligned(false), _expectedHead(NO_CELL), _expectedLength(0), _detourStep(0),
+	  _entry(NO_CELL), _entryFood(NO_CELL), _entryWait(0), _lastFood(NO_CELL), _hunger(0), _shortcuts(0)
+{
+	_detour.reserve(MAX_DETOUR + 1);
+	_region.reserve(REGION_LIMIT);
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+HamiltonPilot::~HamiltonPilot() {}
+
+/**
+ * @brief Choisit la direction du prochain tick et mesure le temps de décision.
+ *
+ * L'alignement du serpent n'est vérifié (en O(longueur)) que si la partie
+ * n'a pas suivi la case visée au tick précédent : nouvelle partie, ou
+ * serpent pas encore aligné.
+ *
+ * @param game Partie en cours, sur le plateau du circuit.
+ * @return La direction de la case choisie, ou NONE si le plateau n'est pas celui du circuit.
+ */
+Input HamiltonPilot::nextInput(const GameState& game)
+{
+	uint64_t start = InputQueue::now();
+	const Grid& grid = game.getGrid();
+	const Snake& snake = game.getSnake();
+	Input input = Input::NONE;
+
+	if (grid.getWidth() == _cycle.getWidth() && grid.getHeight() == _cycle.getHeight())
+	{
+		_cells = grid.getRow(0);
+		uint32_t head = cellIndex(snake.getHead(), _width);
+		uint32_t food = grid.contains(game.getFood()) ? cellIndex(game.getFood(), _width) : NO_CELL;
+
+		if (head != _expectedHead)
+		{
+			_detour.clear();
+			_detourStep = 0;
+			_entryFood = NO_CELL;
+		}
+		if (food != _lastFood)
+		{
+			_lastFood = food;
+			_hunger = 0;
+		}
+		else
+			++_hunger;
+		if (!_aligned || head != _expectedHead || snake.getLength() != _expectedLength)
+			_aligned = isAligned(snake);
+		uint32_t next = _aligned ? follow(game, head, food)
+			: realign(snake, head, cellIndex(snake.getTail(), _width));
+		if (next != NO_CELL)
+		{
+			input = directionTo(head, next, _width);
+			_expectedHead = next;
+			_expectedLength = snake.getLength() + (next == food ? 1 : 0);
+		}
+	}
+	_planNs.record(InputQueue::now() - start);
+	return input;
+}
+
+/**
+ * @brief Durée de chaque appel à nextInput(), en nanosecondes.
+ */
+const Histogram& HamiltonPilot::getPlanTimes() const
+{
+	return _planNs;
+}
+
+/**
+ * @brief Nombre de pas qui ont sauté une partie du circuit.
+ */
+uint64_t HamiltonPilot::getShortcuts() const
+{
+	return _shortcuts;
+}
+
+/**
+ * @brief Vérifie que les segments situés sur le circuit s'y suivent dans l'ordre, de la queue vers la tête.
+ *
+ * Les segments hors du circuit (détours vers la nourriture) sont ignorés.
+ *
+ * @param snake Le serpent.
+ */
+bool HamiltonPilot::isAligned(const Snake& snake) const
+{
+	uint32_t base = HamiltonCycle::OFF_CYCLE;
+	uint32_t previous = 0;
+
+	for (size_t i = snake.getLength(); i-- > 0;)
+	{
+		uint32_t order = _order[cellIndex(snake.getSegment(i), _width)];
+		if (order == HamiltonCycle::OFF_CYCLE)
+			continue;
+		if (base == HamiltonCycle::OFF_CYCLE)
+		{
+			base = order;
+			continue;
+		}
+		uint32_t position = (order + _length - base) % _length;
+		if (position <= previous)
+			return false;
+		previous = position;
+	}
+	return base != HamiltonCycle::OFF_CYCLE;
+}
+
+/**
+ * @brief Case suivante d'un serpent aligné : la plus avancée du circuit sans dépasser la nourriture.
+ *
+ * Les cases candidates sont les voisines de la tête situées après elle sur
+ * le circuit, toutes libres. La nourriture (ou, si elle est hors du
+ * circuit, la case d'où partira le détour) borne le saut. Si elle est
+ * derrière la tête, la tête suit le circuit pas à pas : la queue, qui saute
+ * les cases laissées libres par les raccourcis, rattrape la nourriture plus
+ * vite, et le corps se resserre au lieu de s'étaler sur tout le circuit.
+ *
+ * À défaut, la tête peut toujours entrer dans la queue, qui se libère au
+ * même tick : la tête prend alors la position la plus avancée du circuit
+ * et le corps reste aligné. C'est le cas d'un serpent qui occupe tout le
+ * circuit.
+ *
+ * @param game Partie en cours.
+ * @param head Case de la tête.
+ * @param food Case de la nourriture (NO_CELL : aucune).
+ * @return Case choisie, ou NO_CELL si aucune voisine n'est libre.
+ */
+uint32_t HamiltonPilot::follow(const GameState& game, uint32_t head, uint32_t food)
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	const Snake& snake = game.getSnake();
+	size_t back = snake.getLength() - 1;
+	size_t front = 0;
+	uint32_t tail = cellIndex(snake.getTail(), _width);
+
+	_tail = _order[tail] != HamiltonCycle::OFF_CYCLE ? tail : NO_CELL;
+
+	// Positions comptées depuis le segment du circuit le plus proche de la queue ;
+	// celle de la tête est, si elle fait un détour, celle du dernier segment du circuit
+	while (back > 0 && _order[cellIndex(snake.getSegment(back), _width)] == HamiltonCycle::OFF_CYCLE)
+		--back;
+	while (front < back && _order[cellIndex(snake.getSegment(front), _width)] == HamiltonCycle::OFF_CYCLE)
+		++front;
+	uint32_t origin = cellIndex(snake.getSegment(back), _width);
+	if (_order[origin] == HamiltonCycle::OFF_CYCLE)
+		return escape(head, tail);
+	_base = _order[origin];
+	uint32_t position = relative(cellIndex(snake.getSegment(front), _width));
+
+	if (_detourStep < _detour.size())
+	{
+		uint32_t next = _detour[_detourStep];
+		if (isAdjacent(head, next) && (isPassable(next) || next == tail))
+		{
+			++_detourStep;
+			return next;
+		}
+		_detour.clear();
+		_detourStep = 0;
+	}
+
+	uint32_t limit = position + 1;
+	if (food != NO_CELL && _order[food] == HamiltonCycle::OFF_CYCLE)
+	{
+		// Nourriture en cul-de-sac : mangée en dernier, ou quand le serpent a trop attendu
+		bool starving = _hunger > 2 * static_cast<uint64_t>(_length);
+		if (isAdjacent(head, food) && (game.getGrid().getFreeCount() == 0 || starving))
+			return food;
+		if (head == _entry && _entryFood == food && planDetour(head, food, position))
+		{
+			_detourStep = 1;
+			return _detour[0];
+		}
+		bool stale = _entry == NO_CELL ? ++_entryWait >= ENTRY_RETRY
+			: relative(_entry) <= position || !isPassable(_entry);
+		if (_entryFood != food || stale)
+		{
+			_entry = entryAfter(food, position);
+			_entryFood = food;
+			_entryWait = 0;
+		}
+		if (_entry != NO_CELL)
+			limit = relative(_entry);
+	}
+	else if (food != NO_CELL && relative(food) > position)
+		limit = relative(food);
+
+	uint32_t best = NO_CELL;
+	uint32_t bestPosition = 0;
+	uint32_t nearest = NO_CELL;
+	uint32_t nearestPosition = UINT32_MAX;
+	for (int32_t offset : offsets)
+	{
+		uint32_t next = head + offset;
+		if (_order[next] == HamiltonCycle::OFF_CYCLE || !isPassable(next))
+			continue;
+		uint32_t ahead = relative(next);
+		if (ahead <= position)
+			continue;
+		if (ahead <= limit && (best == NO_CELL || ahead > bestPosition))
+		{
+			best = next;
+			bestPosition = ahead;
+		}
+		if (ahead < nearestPosition)
+		{
+			nearest = next;
+			nearestPosition = ahead;
+		}
+	}
+	if (best != NO_CELL)
+	{
+		if (bestPosition > position + 1)
+			++_shortcuts;
+		return best;
+	}
+	if (nearest != NO_CELL)
+		return nearest;
+	if (_tail != NO_CELL && isAdjacent(head, _tail))
+		return _tail;
+	return escape(head, tail);
+}
+
+/**
+ * @brief Case suivante d'un serpent pas encore aligné : la suite du circuit si elle est libre.
+ *
+ * Après autant de pas sur le circuit que le serpent a de segments, son
+ * corps en occupe une portion dans l'ordre.
+ *
+ * @param snake Le serpent.
+ * @param head Case de la tête.
+ * @param tail Case de la queue.
+ */
+uint32_t HamiltonPilot::realign(const Snake& snake, uint32_t head, uint32_t tail) const
+{
+	if (_order[head] != HamiltonCycle::OFF_CYCLE)
+	{
+		uint32_t next = _path[(_order[head] + 1) % _length];
+		bool reverse = snake.getLength() > 1 && next == cellIndex(snake.getSegment(1), _width);
+		if (!reverse && (isPassable(next) || next == tail))
+			return next;
+	}
+	return escape(head, tail);
+}
+
+/**
+ * @brief Dernier recours : la voisine libre qui a le plus de voisines libres, de préférence sur le circuit.
+ *
+ * @param head Case de la tête.
+ * @param tail Case de la queue (libérée au prochain tick).
+ * @return Case choisie, ou NO_CELL si aucune voisine n'est libre.
+ */
+uint32_t HamiltonPilot::escape(uint32_t head, uint32_t tail) const
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	uint32_t best = NO_CELL;
+	int bestScore = -1;
+
+	for (int32_t offset : offsets)
+	{
+		uint32_t next = head + offset;
+		if (next != tail && !isPassable(next))
+			continue;
+		int score = _order[next] != HamiltonCycle::OFF_CYCLE ? 1 : 0;
+		for (int32_t around : offsets)
+			score += 2 * isPassable(next + around);
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = next;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Première case du circuit après `after` d'où un détour mène à une nourriture hors du circuit.
+ *
+ * Les candidates bordent les cases hors du circuit qui entourent la
+ * nourriture (au plus REGION_LIMIT) ; la plus proche de la tête qui admet
+ * un détour est retenue. Le détour lui-même est recalculé en y arrivant.
+ *
+ * @param food Case de la nourriture, hors du circuit.
+ * @param after Position de la tête.
+ * @return Case choisie, ou NO_CELL si aucune ne convient.
+ */
+uint32_t HamiltonPilot::entryAfter(uint32_t food, uint32_t after)
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	uint32_t best = NO_CELL;
+	uint32_t bestPosition = UINT32_MAX;
+
+	_region.clear();
+	_region.push_back(food);
+	for (size_t i = 0; i < _region.size(); ++i)
+		for (int32_t offset : offsets)
+		{
+			uint32_t next = _region[i] + offset;
+			if (_region.size() < REGION_LIMIT && _order[next] == HamiltonCycle::OFF_CYCLE && isPassable(next)
+				&& std::find(_region.begin(), _region.end(), next) == _region.end())
+				_region.push_back(next);
+		}
+
+	for (uint32_t cell : _region)
+		for (int32_t offset : offsets)
+		{
+			uint32_t entry = cell + offset;
+			if (_order[entry] == HamiltonCycle::OFF_CYCLE || !isPassable(entry))
+				continue;
+			uint32_t position = relative(entry);
+			if (position > after && position < bestPosition && planDetour(entry, food, position))
+			{
+				best = entry;
+				bestPosition = position;
+			}
+		}
+	_detour.clear();
+	return best;
+}
+
+/**
+ * @brief Cherche un détour hors du circuit qui part de `from`, passe par la nourriture et revient sur le circuit.
+ *
+ * Le détour (au plus MAX_DETOUR cases hors du circuit) revient sur une case
+ * libre du circuit située après `after`, ou sur la queue : le corps reste
+ * aligné. La recherche en profondeur essaie au plus DETOUR_BUDGET cases.
+ *
+ * @param from Case du circuit d'où part le détour.
+ * @param food Case de la nourriture, hors du circuit.
+ * @param after Position de `from` sur le circuit.
+ * @return true si un détour a été trouvé ; il est alors rangé dans _detour, case de retour comprise.
+ */
+bool HamiltonPilot::planDetour(uint32_t from, uint32_t food, uint32_t after)
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+	uint32_t budget = DETOUR_BUDGET;
+
+	_detour.clear();
+	_detourStep = 0;
+	for (int32_t offset : offsets)
+	{
+		uint32_t next = from + offset;
+		if (_order[next] == HamiltonCycle::OFF_CYCLE && isPassable(next)
+			&& extendDetour(from, next, food, after, false, budget))
+			return true;
+	}
+	_detour.clear();
+	return false;
+}
+
+/**
+ * @brief Étape de planDetour() : ajoute `cell` au détour puis cherche la suite.
+ *
+ * @param from Case de départ du détour.
+ * @param cell Case ajoutée, hors du circuit et libre.
+ * @param food Case de la nourriture.
+ * @param after Position de `from` sur le circuit.
+ * @param fed La nourriture est déjà sur le détour.
+ * @param budget Cases qu'il reste à essayer.
+ */
+bool HamiltonPilot::extendDetour(uint32_t from, uint32_t cell, uint32_t food, uint32_t after, bool fed,
+	uint32_t& budget)
+{
+	const int32_t offsets[4] = { -_width, _width, -1, 1 };
+
+	if (budget == 0)
+		return false;
+	--budget;
+	_detour.push_back(cell);
+	fed = fed || cell == food;
+	for (int32_t offset : offsets)
+	{
+		uint32_t next = cell + offset;
+		if (fed && next != from && isExit(next, after))
+		{
+			_detour.push_back(next);
+			return true;
+		}
+	}
+	if (_detour.size() < MAX_DETOUR)
+		for (int32_t offset : offsets)
+		{
+			uint32_t next = cell + offset;
+			if (_order[next] == HamiltonCycle::OFF_CYCLE && isPassable(next)
+				&& std::find(_detour.begin(), _detour.end(), next) == _detour.end()
+				&& extendDetour(from, next, food, after, fed, budget))
+				return true;
+		}
+	_detour.pop_back();
+	return false;
+}
+
+/**
+ * @brief Case du circuit où un détour peut revenir : libre et après `after`, ou la queue.
+ *
+ * La queue se libère avant que la tête n'y arrive : elle avance à chaque
+ * pas du détour sauf au repas, et un détour compte au moins deux pas.
+ */
+bool HamiltonPilot::isExit(uint32_t cell, uint32_t after) const
+{
+	if (cell == _tail)
+		return true;
+	return _order[cell] != HamiltonCycle::OFF_CYCLE && isPassable(cell) && relative(cell) > after;
+}
+
+/**
+ * @brief Indique que deux cases sont voisines.
+ */
+bool HamiltonPilot::isAdjacent(uint32_t a, uint32_t b) const
+{
+	uint32_t width = static_cast<uint32_t>(_width);
+	return a + 1 == b || b + 1 == a || a + width == b || b + width == a;
+}
+
+/**
+ * @brief Position d'une case du circuit comptée depuis la queue.
+ */
+uint32_t HamiltonPilot::relative(uint32_t cell) const
+{
+	uint32_t order = _order[cell];
+	return order >= _base ? order - _base : order + _length - _base;
+}
+
+/**
+ * @brief Case que la tête peut occuper : vide ou nourriture.
+ */
+bool HamiltonPilot::isPassable(uint32_t cell) const
+{
+	return isPassableCell(_cells[cell]);
+}
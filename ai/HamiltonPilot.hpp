@@ -0,0 +1,95 @@
+/**
+ * @file HamiltonPilot.hpp
+ * @brief Déclaration de la classe HamiltonPilot, joueur automatique qui remplit tout le plateau.
+ *
+ * Le serpent suit un circuit hamiltonien (voir HamiltonCycle) : son corps
+ * occupe toujours une portion du circuit, dans l'ordre, et la case suivante
+ * de la tête est toujours libre. Il ne peut donc pas mourir, et finit par
+ * remplir toutes les cases du circuit. Des raccourcis vers la nourriture
+ * réduisent le nombre de ticks sans jamais rompre cette propriété.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "HamiltonCycle.hpp"
+#include "../core/GameState.hpp"
+#include "../core/Histogram.hpp"
+#include "../includes/IController.hpp"
+
+/**
+ * @class HamiltonPilot
+ * @brief Contrôleur qui suit un circuit hamiltonien et prend les raccourcis sûrs.
+ *
+ * Les positions sont mesurées sur le circuit à partir de la queue : le
+ * serpent est « aligné » quand les positions de ses segments croissent de
+ * la queue à la tête. Toute case du circuit située après la tête est alors
+ * libre, et la tête peut y sauter : parmi ses voisines, elle prend la plus
+ * avancée qui ne dépasse pas la nourriture. Chaque tick coûte O(1).
+ *
+ * Une nourriture hors du circuit (près d'un obstacle, ou dernière case d'un
+ * plateau aux deux côtés impairs) est mangée par un court détour : la tête
+ * quitte le circuit, passe par la nourriture et revient sur une case du
+ * circuit située plus loin, ce qui garde le corps aligné. Si aucun détour
+ * n'existe (cul-de-sac), la nourriture est mangée quand elle est la
+ * dernière case libre, ou après deux tours de circuit sans manger : le
+ * serpent y entre alors quitte à mourir, plutôt que de tourner sans fin.
+ *
+ * En début de partie, le serpent suit le circuit jusqu'à être aligné.
+ */
+class HamiltonPilot : public IController
+{
+	public:
+		explicit HamiltonPilot(const HamiltonCycle& cycle);
+		HamiltonPilot(const HamiltonPilot&) = delete;
+		HamiltonPilot& operator=(const HamiltonPilot&) = delete;
+		~HamiltonPilot();
+
+		Input				nextInput(const GameState& game) override;
+		const Histogram&	getPlanTimes() const;
+		uint64_t			getShortcuts() const;
+
+	private:
+		static const uint32_t NO_CELL = UINT32_MAX;	///< Case absente.
+		static const size_t MAX_DETOUR = 12;		///< Cases d'un détour hors du circuit, au plus.
+		static const uint32_t DETOUR_BUDGET = 512;	///< Cases essayées au plus par recherche de détour.
+		static const size_t REGION_LIMIT = 16;		///< Cases hors du circuit explorées autour de la nourriture.
+		static const uint32_t ENTRY_RETRY = 64;		///< Ticks entre deux recherches infructueuses d'entrée.
+
+		bool		isAligned(const Snake& snake) const;
+		uint32_t	follow(const GameState& game, uint32_t head, uint32_t food);
+		uint32_t	realign(const Snake& snake, uint32_t head, uint32_t tail) const;
+		uint32_t	escape(uint32_t head, uint32_t tail) const;
+		uint32_t	entryAfter(uint32_t food, uint32_t after);
+		bool		planDetour(uint32_t from, uint32_t food, uint32_t after);
+		bool		extendDetour(uint32_t from, uint32_t cell, uint32_t food, uint32_t after, bool fed,
+						uint32_t& budget);
+		bool		isExit(uint32_t cell, uint32_t after) const;
+		bool		isAdjacent(uint32_t a, uint32_t b) const;
+		uint32_t	relative(uint32_t cell) const;
+		bool		isPassable(uint32_t cell) const;
+
+		const HamiltonCycle&	_cycle;			///< Circuit suivi.
+		const uint32_t*			_order;			///< Position de chaque case sur le circuit.
+		const uint32_t*			_path;			///< Cases du circuit, dans l'ordre.
+		uint32_t				_length;		///< Nombre de cases du circuit.
+		int						_width;			///< Largeur du plateau.
+		const Cell*				_cells;			///< Grille de la partie en cours (le temps d'un appel).
+		uint32_t				_base;			///< Position sur le circuit du segment le plus proche de la queue.
+		uint32_t				_tail;			///< Case de la queue si elle est sur le circuit, NO_CELL sinon.
+		bool					_aligned;		///< Le corps suit le circuit dans l'ordre.
+		uint32_t				_expectedHead;	///< Case visée au tick précédent.
+		size_t					_expectedLength;	///< Longueur attendue du serpent à ce tick.
+		std::vector<uint32_t>	_detour;		///< Détour en cours hors du circuit, jusqu'à la case de retour.
+		size_t					_detourStep;	///< Prochaine case de _detour.
+		std::vector<uint32_t>	_region;		///< Tampon : cases hors du circuit autour de la nourriture.
+		uint32_t				_entry;			///< Case du circuit d'où partira le détour vers la nourriture.
+		uint32_t				_entryFood;		///< Nourriture pour laquelle _entry a été choisie.
+		uint32_t				_entryWait;		///< Ticks depuis la dernière recherche infructueuse de _entry.
+		uint32_t				_lastFood;		///< Nourriture vue au tick précédent.
+		uint64_t				_hunger;		///< Ticks écoulés depuis que la nourriture a changé.
+		uint64_t				_shortcuts;		///< Pas qui ont sauté une partie du circuit.
+		Histogram				_planNs;		///< Durée de chaque appel à nextInput().
+};
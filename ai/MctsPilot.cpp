@@ -0,0 +1,453 @@
+/**
+ * @file MctsPilot.cpp
+ * @brief Implémentation du joueur automatique par recherche arborescente Monte-Carlo.
+ */
+
+#include "MctsPilot.hpp"
+#include "../includes/InputQueue.hpp"
+#include <cmath>
+#include <cstdlib>
+
+const uint32_t MctsPilot::MAX_NODES;
+const int32_t MctsPilot::VIRTUAL_LOSS;
+const size_t MctsPilot::MAX_DEPTH;
+const size_t MctsPilot::ROLLOUT_DEPTH;
+const int64_t MctsPilot::VALUE_SCALE;
+
+namespace
+{
+	const Input MOVES[4] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };	///< Coup de chaque direction.
+	const int DX[4] = { 0, 0, -1, 1 };		///< Déplacement horizontal de chaque direction.
+	const int DY[4] = { -1, 1, 0, 0 };		///< Déplacement vertical de chaque direction.
+	const double EXPLORATION = 0.2;			///< Poids de l'exploration dans la borne UCT.
+	const double MEAL_DISCOUNT = 0.9;		///< Part du bonus de nourriture conservée à chaque tick d'attente.
+	const uint64_t ZOBRIST_SEED = 0x5a6f62726973744bULL;	///< Graine des clés Zobrist.
+	const uint64_t DEATH_KEY = 0x9e3779b97f4a7c15ULL;		///< Marque les positions perdues.
+	const size_t KEY_TABLES = 4;			///< Rôles d'une case dans la clé : corps, tête, queue, nourriture.
+
+	/**
+	 * @brief Direction opposée (les directions opposées ne diffèrent que par leur bit de poids faible).
+	 */
+	int reverseOf(Direction direction)
+	{
+		return static_cast<int>(direction) ^ 1;
+	}
+}
+
+/**
+ * @brief Constructeur : réserve l'arbre et la table, les états de travail viendront au premier tick.
+ *
+ * @param pool Threads de recherche (un état de travail par thread).
+ * @param budgetNs Durée de recherche par tick, en nanosecondes.
+ */
+MctsPilot::MctsPilot(ThreadPool& pool, uint64_t budgetNs)
+	: _pool(pool), _budgetNs(budgetNs), _nodes(new Node[MAX_NODES]), _nodeCount(0), _table(2 * MAX_NODES),
+	  _width(0), _height(0), _playouts(0), _searchNs(0)
+{
+	Rng rng(ZOBRIST_SEED);
+	_depthKeys.assign(MAX_DEPTH + 1, 0);
+	for (size_t depth = 1; depth <= MAX_DEPTH; ++depth)
+		_depthKeys[depth] = rng.next();
+	for (unsigned i = 0; i < pool.getThreadCount(); ++i)
+	{
+		_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+		_workers.back()->rng.seed(ZOBRIST_SEED + i + 1);
+		_workers.back()->path.reserve(MAX_DEPTH + 1);
+		_workers.back()->playouts = 0;
+	}
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+MctsPilot::~MctsPilot() {}
+
+/**
+ * @brief Recherche pendant le budget sur tous les threads du pool, puis joue le coup le plus visité.
+ *
+ * @param game Partie en cours.
+ * @return La direction choisie, ou NONE si la partie est terminée.
+ */
+Input MctsPilot::nextInput(const GameState& game)
+{
+	uint64_t start = InputQueue::now();
+	Input input = Input::NONE;
+
+	if (!game.isFinished())
+	{
+		prepare(game);
+		uint64_t rootKey = keyOf(game);
+		uint32_t root = expand(rootKey);
+
+		uint64_t deadline = start + _budgetNs;
+		for (size_t i = 0; i < _workers.size(); ++i)
+		{
+			Worker* worker = _workers[i].get();
+			worker->playouts = 0;
+			_pool.submit([this, worker, &game, rootKey, root, deadline]() {
+				search(*worker, game, rootKey, root, deadline);
+			});
+		}
+		_pool.wait();
+		for (const std::unique_ptr<Worker>& worker : _workers)
+			_playouts += worker->playouts;
+		_searchNs += InputQueue::now() - start;
+
+		int reverse = reverseOf(game.getSnake().getDirection());
+		int32_t bestVisits = -1;
+		for (int move = 0; move < 4; ++move)
+		{
+			uint32_t child = _nodes[root].children[move].load(std::memory_order_acquire);
+			if (move == reverse || child == TranspositionTable::NO_NODE)
+				continue;
+			int32_t visits = _nodes[child].visits.load(std::memory_order_relaxed);
+			if (visits > bestVisits)
+			{
+				bestVisits = visits;
+				input = MOVES[move];
+			}
+		}
+	}
+	_planNs.record(InputQueue::now() - start);
+	return input;
+}
+
+/**
+ * @brief Durée de chaque appel à nextInput(), en nanosecondes.
+ */
+const Histogram& MctsPilot::getPlanTimes() const
+{
+	return _planNs;
+}
+
+/**
+ * @brief Simulations faites depuis la construction, tous threads confondus.
+ */
+uint64_t MctsPilot::getPlayouts() const
+{
+	return _playouts;
+}
+
+/**
+ * @brief Temps de recherche cumulé (mur), en nanosecondes.
+ */
+uint64_t MctsPilot::getSearchNs() const
+{
+	return _searchNs;
+}
+
+/**
+ * @brief Nœuds actuellement alloués dans l'arbre.
+ */
+size_t MctsPilot::getNodeCount() const
+{
+	uint32_t count = _nodeCount.load(std::memory_order_relaxed);
+	return count < MAX_NODES ? count : MAX_NODES;
+}
+
+/**
+ * @brief Prépare une recherche : clés et états de travail du plateau, arbre vidé.
+ *
+ * @param game Partie en cours.
+ */
+void MctsPilot::prepare(const GameState& game)
+{
+	const Grid& grid = game.getGrid();
+
+	if (grid.getWidth() != _width || grid.getHeight() != _height)
+	{
+		_width = grid.getWidth();
+		_height = grid.getHeight();
+		Rng rng(ZOBRIST_SEED + 1);
+		_zobrist.resize(KEY_TABLES * static_cast<size_t>(_width) * _height);
+		for (uint64_t& key : _zobrist)
+			key = rng.next();
+		for (const std::unique_ptr<Worker>& worker : _workers)
+			worker->state.reset();
+	}
+	for (const std::unique_ptr<Worker>& worker : _workers)
+		if (!worker->state)
+			worker->state.reset(new GameState(game));
+	reset();
+}
+
+/**
+ * @brief Vide l'arbre et la table en O(1) (aucune recherche en cours).
+ */
+void MctsPilot::reset()
+{
+	_nodeCount.store(0, std::memory_order_relaxed);
+	_table.clear();
+}
+
+/**
+ * @brief Boucle de recherche d'un thread : des simulations jusqu'à l'échéance (au moins une).
+ */
+void MctsPilot::search(Worker& worker, const GameState& root, uint64_t rootKey, uint32_t rootNode,
+	uint64_t deadline)
+{
+	do
+	{
+		playout(worker, root, rootKey, rootNode);
+		++worker.playouts;
+	} while (InputQueue::now() < deadline);
+}
+
+/**
+ * @brief Une simulation : descente UCT, ajout d'un nœud, déroulement, puis remontée de la récompense.
+ *
+ * @param worker Données du thread.
+ * @param root Partie à la racine.
+ * @param rootKey Clé Zobrist de la racine.
+ * @param rootNode Nœud de la racine.
+ */
+void MctsPilot::playout(Worker& worker, const GameState& root, uint64_t rootKey, uint32_t rootNode)
+{
+	GameState& state = *worker.state;
+	uint64_t key = rootKey;
+	uint32_t node = rootNode;
+	size_t depth = 0;
+	size_t firstMeal = ROLLOUT_DEPTH;
+
+	state.copyFrom(root);
+	worker.path.clear();
+	worker.path.push_back(node);
+	_nodes[node].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+	while (depth < MAX_DEPTH && !state.isFinished())
+	{
+		int move = select(node, state.getSnake().getDirection());
+		key = advance(state, key, move) ^ _depthKeys[depth] ^ _depthKeys[depth + 1];
+		++depth;
+		if (firstMeal == ROLLOUT_DEPTH && state.getScore() > root.getScore())
+			firstMeal = depth;
+
+		std::atomic<uint32_t>& link = _nodes[node].children[move];
+		uint32_t child = link.load(std::memory_order_acquire);
+		bool added = child == TranspositionTable::NO_NODE;
+		if (added)
+		{
+			child = expand(key);
+			if (child == TranspositionTable::NO_NODE)
+				break;
+			// Un autre thread a pu relier ce coup entre-temps : son nœud l'emporte
+			uint32_t expected = TranspositionTable::NO_NODE;
+			if (!link.compare_exchange_strong(expected, child, std::memory_order_acq_rel))
+				child = expected;
+		}
+		node = child;
+		worker.path.push_back(node);
+		_nodes[node].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+		if (added)
+			break;
+	}
+
+	double reward = rollout(worker, state, root.getScore(), depth, firstMeal);
+	int64_t value = static_cast<int64_t>(std::lround(reward * VALUE_SCALE));
+	for (uint32_t visited : worker.path)
+	{
+		_nodes[visited].value.fetch_add(value, std::memory_order_relaxed);
+		_nodes[visited].visits.fetch_add(1 - VIRTUAL_LOSS, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Coup à jouer depuis un nœud : le premier jamais essayé, sinon la meilleure borne UCT.
+ *
+ * @param node Nœud courant.
+ * @param current Direction du serpent (son opposé n'est pas un coup).
+ * @return Indice de la direction (UP, DOWN, LEFT, RIGHT).
+ */
+int MctsPilot::select(uint32_t node, Direction current) const
+{
+	const Node& parent = _nodes[node];
+	int reverse = reverseOf(current);
+	int32_t parentVisits = parent.visits.load(std::memory_order_relaxed);
+	double logVisits = std::log(static_cast<double>(parentVisits > 1 ? parentVisits : 1));
+	int best = -1;
+	double bestScore = -1.0;
+
+	for (int move = 0; move < 4; ++move)
+	{
+		if (move == reverse)
+			continue;
+		uint32_t child = parent.children[move].load(std::memory_order_acquire);
+		if (child == TranspositionTable::NO_NODE)
+			return move;
+		int32_t visits = _nodes[child].visits.load(std::memory_order_relaxed);
+		if (visits <= 0)
+			return move;
+		double mean = static_cast<double>(_nodes[child].value.load(std::memory_order_relaxed))
+			/ VALUE_SCALE / visits;
+		double score = mean + EXPLORATION * std::sqrt(logVisits / visits);
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = move;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Nœud d'une position : celui de la table s'il existe, sinon un nouveau.
+ *
+ * @param key Clé Zobrist de la position.
+ * @return Indice du nœud, ou NO_NODE si l'arbre est plein.
+ */
+uint32_t MctsPilot::expand(uint64_t key)
+{
+	uint32_t found = _table.find(key);
+	if (found != TranspositionTable::NO_NODE)
+		return found;
+
+	uint32_t index = _nodeCount.fetch_add(1, std::memory_order_relaxed);
+	if (index >= MAX_NODES)
+		return TranspositionTable::NO_NODE;
+	Node& node = _nodes[index];
+	node.visits.store(0, std::memory_order_relaxed);
+	node.value.store(0, std::memory_order_relaxed);
+	for (std::atomic<uint32_t>& child : node.children)
+		child.store(TranspositionTable::NO_NODE, std::memory_order_relaxed);
+
+	// Table pleine pour cette clé : le nœud reste propre à ce chemin
+	uint32_t stored = _table.insert(key, index);
+	return stored != TranspositionTable::NO_NODE ? stored : index;
+}
+
+/**
+ * @brief Termine la partie au hasard jusqu'à ROLLOUT_DEPTH ticks depuis la racine, et en donne la récompense.
+ *
+ * Sept fois sur huit, le coup sûr qui rapproche le plus de la
+ * nourriture est joué ; sinon un coup sûr au hasard. La récompense vaut
+ * 1 pour une partie gagnée, et sinon la moyenne de la part de l'horizon
+ * survécue et d'un bonus de nourriture qui décroît géométriquement avec
+ * le tick du premier repas (MEAL_DISCOUNT), 0 sans repas. Une décroissance
+ * linéaire sur tout l'horizon écartait trop peu les coups vers la
+ * nourriture des autres.
+ *
+ * @param worker Données du thread (générateur).
+ * @param state Partie après la descente dans l'arbre.
+ * @param rootScore Score à la racine.
+ * @param depth Ticks déjà joués depuis la racine.
+ * @param firstMeal Tick du premier repas depuis la racine (ROLLOUT_DEPTH : pas encore).
+ */
+double MctsPilot::rollout(Worker& worker, GameState& state, int rootScore, size_t depth, size_t firstMeal) const
+{
+	while (depth < ROLLOUT_DEPTH && !state.isFinished())
+	{
+		const Point& head = state.getSnake().getHead();
+		const Point& food = state.getFood();
+		int reverse = reverseOf(state.getSnake().getDirection());
+		int safe[4];
+		int safeCount = 0;
+		int closest = -1;
+		int closestDistance = 0;
+
+		for (int move = 0; move < 4; ++move)
+		{
+			Point next(head.x + DX[move], head.y + DY[move]);
+			if (move == reverse || !isSafe(state, next))
+				continue;
+			safe[safeCount++] = move;
+			int distance = std::abs(food.x - next.x) + std::abs(food.y - next.y);
+			if (closest < 0 || distance < closestDistance)
+			{
+				closest = move;
+				closestDistance = distance;
+			}
+		}
+		int move = reverse ^ 1;
+		if (safeCount > 0)
+			move = worker.rng.bounded(8) != 0 ? closest : safe[worker.rng.bounded(static_cast<uint64_t>(safeCount))];
+		state.queueDirection(MOVES[move]);
+		state.update();
+		++depth;
+		if (firstMeal == ROLLOUT_DEPTH && state.getScore() > rootScore)
+			firstMeal = depth;
+	}
+
+	if (state.isWon())
+		return 1.0;
+	double survived = state.isFinished() ? static_cast<double>(depth) / ROLLOUT_DEPTH : 1.0;
+	double meal = firstMeal < ROLLOUT_DEPTH ? std::pow(MEAL_DISCOUNT, static_cast<double>(firstMeal)) : 0.0;
+	return 0.5 * survived + 0.5 * meal;
+}
+
+/**
+ * @brief Joue un coup sur l'état de travail et met sa clé Zobrist à jour en O(1).
+ *
+ * @param state Partie à faire avancer d'un tick.
+ * @param key Clé de la position avant le coup.
+ * @param move Indice de la direction.
+ * @return Clé de la position après le coup.
+ */
+uint64_t MctsPilot::advance(GameState& state, uint64_t key, int move) const
+{
+	const Snake& snake = state.getSnake();
+	Point oldHead = snake.getHead();
+	Point oldTail = snake.getTail();
+	Point oldFood = state.getFood();
+	size_t oldLength = snake.getLength();
+
+	state.queueDirection(MOVES[move]);
+	state.update();
+	if (state.isFinished() && !state.isWon())
+		return key ^ DEATH_KEY ^ static_cast<uint64_t>(move + 1);
+
+	const Point& head = snake.getHead();
+	key ^= cellKey(1, oldHead) ^ cellKey(1, head) ^ cellKey(0, head);
+	key ^= cellKey(2, oldTail) ^ cellKey(2, snake.getTail());
+	key ^= cellKey(3, oldFood) ^ cellKey(3, state.getFood());
+	if (snake.getLength() == oldLength)
+		key ^= cellKey(0, oldTail);
+	return key;
+}
+
+/**
+ * @brief Clé Zobrist d'une position à la racine, calculée en entier (O(longueur)).
+ *
+ * La clé combine les cases du corps, la tête, la queue et la nourriture ;
+ * pendant la descente s'y ajoute la profondeur (voir playout()).
+ */
+uint64_t MctsPilot::keyOf(const GameState& state) const
+{
+	const Snake& snake = state.getSnake();
+	uint64_t key = cellKey(1, snake.getHead()) ^ cellKey(2, snake.getTail()) ^ cellKey(3, state.getFood());
+	BodyView body = snake.getBody();
+
+	for (const Point& p : body.first)
+		key ^= cellKey(0, p);
+	for (const Point& p : body.second)
+		key ^= cellKey(0, p);
+	return key;
+}
+
+/**
+ * @brief Clé aléatoire d'une case pour un rôle donné (0 pour une case hors du plateau).
+ *
+ * @param table Rôle : 0 corps, 1 tête, 2 queue, 3 nourriture.
+ * @param p Case.
+ */
+uint64_t MctsPilot::cellKey(size_t table, const Point& p) const
+{
+	if (p.x < 0 || p.y < 0 || p.x >= _width || p.y >= _height)
+		return 0;
+	size_t area = static_cast<size_t>(_width) * _height;
+	return _zobrist[table * area + static_cast<size_t>(p.y) * _width + p.x];
+}
+
+/**
+ * @brief Case où la tête peut entrer sans mourir au prochain tick : vide, nourriture ou queue.
+ */
+bool MctsPilot::isSafe(const GameState& state, const Point& p) const
+{
+	const Grid& grid = state.getGrid();
+	if (!grid.contains(p))
+		return false;
+	Cell cell = grid.at(p);
+	if (cell == Cell::EMPTY || cell == Cell::FOOD)
+		return true;
+	const Snake& snake = state.getSnake();
+	const Point& tail = snake.getTail();
+	return cell == Cell::SNAKE && p.x == tail.x && p.y == tail.y && snake.getLength() > 2;
+}
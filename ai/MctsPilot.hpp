@@ -0,0 +1,121 @@
+/**
+ * @file MctsPilot.hpp
+ * @brief Déclaration de la classe MctsPilot, joueur automatique par recherche arborescente Monte-Carlo.
+ *
+ * À chaque tick, plusieurs threads (ceux d'un ThreadPool) développent le
+ * même arbre de recherche pendant un budget de temps fixé, puis le coup le
+ * plus visité depuis la racine est joué. L'arbre est partagé sans verrou :
+ * compteurs atomiques, perte virtuelle pour disperser les threads, et table
+ * de transposition (clés Zobrist) pour fusionner les positions identiques.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "TranspositionTable.hpp"
+#include "../core/GameState.hpp"
+#include "../core/Histogram.hpp"
+#include "../core/Rng.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../includes/IController.hpp"
+
+/**
+ * @class MctsPilot
+ * @brief Contrôleur UCT multi-thread sur des copies de GameState.
+ *
+ * Une simulation (« playout ») copie la partie dans l'état de travail de
+ * son thread (GameState::copyFrom(), sans allocation), descend l'arbre en
+ * choisissant à chaque nœud le coup de meilleure borne UCT, ajoute un
+ * nœud, puis termine la partie au hasard (en préférant les coups sûrs qui
+ * rapprochent de la nourriture) sur ROLLOUT_DEPTH ticks depuis la racine.
+ * La récompense, entre 0 et 1, mêle la survie et la rapidité du premier
+ * repas.
+ *
+ * Pendant la descente, chaque nœud traversé reçoit VIRTUAL_LOSS visites
+ * sans récompense, retirées à la remontée : les autres threads explorent
+ * entre-temps d'autres branches.
+ *
+ * La clé d'une position inclut sa profondeur : seules les positions
+ * identiques atteintes au même tick sont fusionnées, ce qui garde l'arbre
+ * sans cycle (le serpent peut revenir à une position déjà vue) et des
+ * récompenses comparables, mesurées depuis la racine. Pour la même raison,
+ * l'arbre est vidé à chaque tick (en O(1), voir TranspositionTable::clear()).
+ *
+ * Les coups simulés suivent le générateur de la partie copiée : sur une
+ * partie qui se déroule normalement, les nourritures de l'arbre sont
+ * celles qui apparaîtront réellement.
+ */
+class MctsPilot : public IController
+{
+	public:
+		static const uint32_t MAX_NODES = 1 << 18;		///< Nœuds de l'arbre au plus.
+		static const int32_t VIRTUAL_LOSS = 3;			///< Visites sans récompense ajoutées pendant une descente.
+		static const size_t MAX_DEPTH = 48;				///< Profondeur de l'arbre au plus.
+		static const size_t ROLLOUT_DEPTH = 96;			///< Ticks simulés depuis la racine, arbre compris.
+
+		MctsPilot(ThreadPool& pool, uint64_t budgetNs);
+		MctsPilot(const MctsPilot&) = delete;
+		MctsPilot& operator=(const MctsPilot&) = delete;
+		~MctsPilot();
+
+		Input				nextInput(const GameState& game) override;
+		const Histogram&	getPlanTimes() const;
+		uint64_t			getPlayouts() const;
+		uint64_t			getSearchNs() const;
+		size_t				getNodeCount() const;
+
+	private:
+		static const int64_t VALUE_SCALE = 1 << 16;		///< Récompense 1 en virgule fixe.
+
+		/**
+		 * @brief Nœud de l'arbre : une position, ses statistiques et ses quatre coups.
+		 */
+		struct Node
+		{
+			std::atomic<int32_t>	visits;			///< Visites, pertes virtuelles en cours comprises.
+			std::atomic<uint32_t>	children[4];	///< Nœud atteint par chaque direction (NO_NODE : pas encore).
+			std::atomic<int64_t>	value;			///< Somme des récompenses (VALUE_SCALE = 1).
+		};
+
+		/**
+		 * @brief Données propres à un thread de recherche (sur leurs propres lignes de cache).
+		 */
+		struct alignas(64) Worker
+		{
+			std::unique_ptr<GameState>	state;		///< État de travail, recopié à chaque simulation.
+			std::vector<uint32_t>		path;		///< Nœuds traversés par la simulation en cours.
+			Rng							rng;		///< Tirages des déroulements.
+			uint64_t					playouts;	///< Simulations faites pendant la recherche en cours.
+		};
+
+		void		prepare(const GameState& game);
+		void		reset();
+		void		search(Worker& worker, const GameState& root, uint64_t rootKey, uint32_t rootNode,
+						uint64_t deadline);
+		void		playout(Worker& worker, const GameState& root, uint64_t rootKey, uint32_t rootNode);
+		int			select(uint32_t node, Direction current) const;
+		uint32_t	expand(uint64_t key);
+		double		rollout(Worker& worker, GameState& state, int rootScore, size_t depth, size_t firstMeal) const;
+		uint64_t	advance(GameState& state, uint64_t key, int move) const;
+		uint64_t	keyOf(const GameState& state) const;
+		uint64_t	cellKey(size_t table, const Point& p) const;
+		bool		isSafe(const GameState& state, const Point& p) const;
+
+		ThreadPool&					_pool;			///< Threads de recherche.
+		uint64_t					_budgetNs;		///< Durée de recherche par tick.
+		std::unique_ptr<Node[]>		_nodes;			///< Nœuds de l'arbre.
+		std::atomic<uint32_t>		_nodeCount;		///< Nœuds alloués.
+		TranspositionTable			_table;			///< Clé de position → nœud.
+		std::vector<uint64_t>		_zobrist;		///< Clés aléatoires : corps, tête, queue, nourriture (une table par rôle).
+		std::vector<uint64_t>		_depthKeys;		///< Clé aléatoire de chaque profondeur (0 à la racine).
+		int							_width;			///< Largeur du plateau des clés.
+		int							_height;		///< Hauteur du plateau des clés.
+		std::vector<std::unique_ptr<Worker>>	_workers;	///< Un état par thread du pool.
+		uint64_t					_playouts;		///< Simulations faites depuis la construction.
+		uint64_t					_searchNs;		///< Temps de recherche cumulé.
+		Histogram					_planNs;		///< Durée de chaque appel à nextInput().
+};
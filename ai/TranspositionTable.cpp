@@ -0,0 +1,131 @@
+/**
+ * @file TranspositionTable.cpp
+ * @brief Implémentation de la table de transposition sans verrou.
+ */
+
+#include "TranspositionTable.hpp"
+#include <stdexcept>
+
+const uint32_t TranspositionTable::NO_NODE;
+const uint32_t TranspositionTable::MAX_NODES;
+const size_t TranspositionTable::PROBES;
+
+namespace
+{
+	const uint64_t NODE_MASK = (1ULL << 24) - 1;	///< Indice du nœud plus un.
+	const uint64_t TAG_MASK = ~((1ULL << 32) - 1);	///< Bits de poids fort de la clé.
+	const int GENERATION_SHIFT = 24;				///< Position de la génération.
+}
+
+/**
+ * @brief Constructeur : alloue au moins `slots` cases, toutes vides.
+ *
+ * @param slots Nombre de cases souhaité (arrondi à la puissance de deux supérieure).
+ * @throw std::invalid_argument si `slots` est nul.
+ */
+TranspositionTable::TranspositionTable(size_t slots)
+	: _mask(0), _generation(1)
+{
+	if (slots == 0)
+		throw std::invalid_argument("TranspositionTable: no slots");
+	size_t size = 1;
+	while (size < slots)
+		size <<= 1;
+	_entries.reset(new std::atomic<uint64_t>[size]);
+	_mask = size - 1;
+	for (size_t i = 0; i < size; ++i)
+		_entries[i].store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+TranspositionTable::~TranspositionTable() {}
+
+/**
+ * @brief Nœud associé à une clé.
+ *
+ * @param key Clé Zobrist de la position.
+ * @return Indice du nœud, ou NO_NODE si la clé n'est pas dans la table.
+ */
+uint32_t TranspositionTable::find(uint64_t key) const
+{
+	for (size_t probe = 0; probe < PROBES; ++probe)
+	{
+		uint64_t entry = _entries[(key + probe) & _mask].load(std::memory_order_acquire);
+		if (!isLive(entry))
+			return NO_NODE;
+		if ((entry & TAG_MASK) == (key & TAG_MASK))
+			return static_cast<uint32_t>((entry & NODE_MASK) - 1);
+	}
+	return NO_NODE;
+}
+
+/**
+ * @brief Associe un nœud à une clé, sauf si un autre thread l'a fait avant.
+ *
+ * @param key Clé Zobrist de la position.
+ * @param node Indice du nœud (au plus MAX_NODES - 1).
+ * @return Le nœud désormais associé à la clé (`node` ou celui déjà inséré),
+ *         ou NO_NODE si les cases de la clé sont toutes prises.
+ */
+uint32_t TranspositionTable::insert(uint64_t key, uint32_t node)
+{
+	uint64_t wanted = pack(key, node);
+
+	for (size_t probe = 0; probe < PROBES; ++probe)
+	{
+		std::atomic<uint64_t>& slot = _entries[(key + probe) & _mask];
+		uint64_t entry = slot.load(std::memory_order_acquire);
+		for (;;)
+		{
+			if (isLive(entry))
+			{
+				if ((entry & TAG_MASK) == (key & TAG_MASK))
+					return static_cast<uint32_t>((entry & NODE_MASK) - 1);
+				break;
+			}
+			// Case vide ou périmée : en cas d'échec, `entry` reçoit la valeur qui l'a prise
+			if (slot.compare_exchange_weak(entry, wanted, std::memory_order_acq_rel, std::memory_order_acquire))
+				return node;
+		}
+	}
+	return NO_NODE;
+}
+
+/**
+ * @brief Vide la table (sans accès concurrent en cours).
+ */
+void TranspositionTable::clear()
+{
+	if (++_generation > 0xFF)
+	{
+		for (size_t i = 0; i <= _mask; ++i)
+			_entries[i].store(0, std::memory_order_relaxed);
+		_generation = 1;
+	}
+}
+
+/**
+ * @brief Nombre de cases de la table.
+ */
+size_t TranspositionTable::getSlots() const
+{
+	return _mask + 1;
+}
+
+/**
+ * @brief Indique qu'une entrée appartient à la génération courante.
+ */
+bool TranspositionTable::isLive(uint64_t entry) const
+{
+	return entry != 0 && ((entry >> GENERATION_SHIFT) & 0xFF) == _generation;
+}
+
+/**
+ * @brief Entrée associant `node` à `key` dans la génération courante.
+ */
+uint64_t TranspositionTable::pack(uint64_t key, uint32_t node) const
+{
+	return (key & TAG_MASK) | (_generation << GENERATION_SHIFT) | (static_cast<uint64_t>(node) + 1);
+}
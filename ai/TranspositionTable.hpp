@@ -0,0 +1,56 @@
+/**
+ * @file TranspositionTable.hpp
+ * @brief Déclaration de la classe TranspositionTable, table sans verrou clé Zobrist → nœud.
+ *
+ * Une même position peut être atteinte par plusieurs suites de coups ; la
+ * table associe sa clé Zobrist au nœud de l'arbre de recherche qui la
+ * représente, afin que ses statistiques soient partagées. Lectures et
+ * insertions se font depuis plusieurs threads sans verrou : chaque entrée
+ * tient dans un seul mot de 64 bits, écrit par compare-and-swap.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class TranspositionTable
+ * @brief Adressage ouvert (sondage linéaire borné), effacement en O(1) par génération.
+ *
+ * Une entrée contient les 32 bits de poids fort de la clé, la génération
+ * de la table (8 bits) et l'indice du nœud plus un (24 bits) ; les bits de
+ * poids faible de la clé choisissent la case. Une entrée d'une génération
+ * passée compte comme vide : clear() n'a qu'à changer de génération, et ne
+ * remet la table à zéro qu'une fois toutes les 255 générations.
+ *
+ * Non copiable : des threads de recherche peuvent y accéder.
+ */
+class TranspositionTable
+{
+	public:
+		static const uint32_t NO_NODE = UINT32_MAX;			///< Clé absente.
+		static const uint32_t MAX_NODES = (1u << 24) - 1;	///< Indices de nœuds représentables.
+
+		explicit TranspositionTable(size_t slots);
+		TranspositionTable(const TranspositionTable&) = delete;
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
+		~TranspositionTable();
+
+		uint32_t	find(uint64_t key) const;
+		uint32_t	insert(uint64_t key, uint32_t node);
+		void		clear();
+		size_t		getSlots() const;
+
+	private:
+		static const size_t PROBES = 8;	///< Cases examinées au plus par clé.
+
+		bool		isLive(uint64_t entry) const;
+		uint64_t	pack(uint64_t key, uint32_t node) const;
+
+		std::unique_ptr<std::atomic<uint64_t>[]>	_entries;	///< Cases de la table.
+		size_t										_mask;		///< Nombre de cases moins un (puissance de deux).
+		uint64_t									_generation;	///< Génération courante (1 à 255).
+};
@@ -0,0 +1,124 @@
+/**
+ * @file FloodAi.cpp
+ * @brief Implémentation du contrôleur à remplissage.
+ */
+
+#include "FloodAi.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+	const Input MOVES[4] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };	///< Coup de chaque direction.
+	const int DX[4] = { 0, 0, -1, 1 };		///< Déplacement horizontal de chaque direction.
+	const int DY[4] = { -1, 1, 0, 0 };		///< Déplacement vertical de chaque direction.
+
+	/**
+	 * @brief Case où la tête peut entrer sans mourir : vide, nourriture, ou queue qui va se libérer.
+	 */
+	bool isSafe(const BoardView& board, int x, int y)
+	{
+		Cell cell = board.at(x, y);
+		if (cell == Cell::EMPTY || cell == Cell::FOOD)
+			return true;
+		const Point& tail = board.tail();
+		return cell == Cell::SNAKE && x == tail.x && y == tail.y && board.body.size() > 2;
+	}
+}
+
+/**
+ * @brief Constructeur : les tableaux du parcours viendront avec le premier plateau.
+ */
+FloodAi::FloodAi()
+	: _pass(0)
+{}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+FloodAi::~FloodAi() {}
+
+/**
+ * @brief Direction la plus proche de la nourriture parmi celles qui laissent assez de place.
+ *
+ * @param board Vue de la partie.
+ * @return La direction choisie, ou NONE si aucune case voisine n'est sûre.
+ */
+Input FloodAi::decide(const BoardView& board)
+{
+	size_t area = static_cast<size_t>(board.width) * board.height;
+	if (_seen.size() != area)
+	{
+		_seen.assign(area, 0);
+		_queue.resize(area);
+		_pass = 0;
+	}
+
+	const Point& head = board.head();
+	int reverse = static_cast<int>(board.direction) ^ 1;
+	size_t limit = board.body.size() + 1;
+	Input best = Input::NONE;
+	size_t bestRoom = 0;
+	int bestDistance = 0;
+
+	for (int move = 0; move < 4; ++move)
+	{
+		int x = head.x + DX[move];
+		int y = head.y + DY[move];
+		if (move == reverse || !isSafe(board, x, y))
+			continue;
+		size_t room = reachable(board, x, y, limit);
+		int distance = std::abs(board.food.x - x) + std::abs(board.food.y - y);
+		// Assez de place l'emporte ; sinon, la plus grande poche ; à place égale, la nourriture
+		if (best == Input::NONE || room > bestRoom || (room == bestRoom && distance < bestDistance))
+		{
+			best = MOVES[move];
+			bestRoom = room;
+			bestDistance = distance;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Cases sûres accessibles depuis une case, en s'arrêtant à `limit`.
+ *
+ * @param board Vue de la partie.
+ * @param x Colonne de départ (case sûre).
+ * @param y Ligne de départ (case sûre).
+ * @param limit Nombre de cases au-delà duquel la place suffit.
+ * @return Le nombre de cases trouvées, au plus `limit`.
+ */
+size_t FloodAi::reachable(const BoardView& board, int x, int y, size_t limit)
+{
+	if (++_pass == 0)
+	{
+		std::fill(_seen.begin(), _seen.end(), 0);
+		_pass = 1;
+	}
+
+	size_t head = 0;
+	size_t tail = 0;
+	uint32_t start = static_cast<uint32_t>(y * board.width + x);
+	_seen[start] = _pass;
+	_queue[tail++] = start;
+	while (head < tail && tail < limit)
+	{
+		uint32_t index = _queue[head++];
+		int cx = static_cast<int>(index % board.width);
+		int cy = static_cast<int>(index / board.width);
+		for (int move = 0; move < 4; ++move)
+		{
+			int nx = cx + DX[move];
+			int ny = cy + DY[move];
+			if (!isSafe(board, nx, ny))
+				continue;
+			uint32_t next = static_cast<uint32_t>(ny * board.width + nx);
+			if (_seen[next] == _pass)
+				continue;
+			_seen[next] = _pass;
+			_queue[tail++] = next;
+		}
+	}
+	return std::min(tail, limit);
+}
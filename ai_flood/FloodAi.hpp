@@ -0,0 +1,39 @@
+/**
+ * @file FloodAi.hpp
+ * @brief Déclaration de la classe FloodAi, contrôleur glouton qui évite de s'enfermer.
+ */
+
+#pragma once
+
+#include "../includes/IBoardController.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class FloodAi
+ * @brief Se rapproche de la nourriture, sauf si la case visée l'enferme dans une poche trop petite.
+ *
+ * Pour chaque direction sûre, un remplissage (parcours en largeur) compte
+ * les cases accessibles depuis la case visée, jusqu'à la longueur du
+ * serpent. Parmi les directions qui laissent assez de place, la plus
+ * proche de la nourriture est jouée ; à défaut, celle qui en laisse le
+ * plus. Les tableaux du parcours sont alloués une fois par taille de
+ * plateau, et les cases visitées marquées par un numéro de passage : rien
+ * n'est remis à zéro entre deux parcours.
+ */
+class FloodAi : public IBoardController
+{
+	public:
+		FloodAi();
+		~FloodAi();
+
+		Input decide(const BoardView& board) override;
+
+	private:
+		size_t	reachable(const BoardView& board, int x, int y, size_t limit);
+
+		std::vector<uint32_t>	_seen;		///< Numéro du dernier parcours passé par chaque case.
+		std::vector<uint32_t>	_queue;		///< File du parcours (indices de cases).
+		uint32_t				_pass;		///< Numéro du parcours courant.
+};
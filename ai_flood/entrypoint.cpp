@@ -0,0 +1,29 @@
+/**
+ * @file entrypoint.cpp
+ * @brief Point d'entrée du contrôleur à remplissage.
+ *
+ * Ce fichier contient les fonctions exportées par la bibliothèque
+ * libai_flood.so, chargée avec `--ai`.
+ */
+
+#include "FloodAi.hpp"
+
+/**
+ * @brief Point d'entrée utilisé par dlsym() pour créer dynamiquement le contrôleur.
+ *
+ * @return Un pointeur vers un objet FloodAi qui implémente l'interface IBoardController.
+ */
+extern "C" IBoardController* createController()
+{
+	return new FloodAi();
+}
+
+/**
+ * @brief Détruit un contrôleur créé par createController(), dans la bibliothèque qui l'a alloué.
+ *
+ * @param controller Le contrôleur à détruire (peut être nul).
+ */
+extern "C" void destroyController(IBoardController* controller)
+{
+	delete controller;
+}
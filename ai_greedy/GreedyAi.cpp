@@ -0,0 +1,65 @@
+/**
+ * @file GreedyAi.cpp
+ * @brief Implémentation du contrôleur glouton.
+ */
+
+#include "GreedyAi.hpp"
+#include <cstdlib>
+
+namespace
+{
+	const Input MOVES[4] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };	///< Coup de chaque direction.
+	const int DX[4] = { 0, 0, -1, 1 };		///< Déplacement horizontal de chaque direction.
+	const int DY[4] = { -1, 1, 0, 0 };		///< Déplacement vertical de chaque direction.
+
+	/**
+	 * @brief Case où la tête peut entrer sans mourir : vide, nourriture, ou queue qui va se libérer.
+	 */
+	bool isSafe(const BoardView& board, int x, int y)
+	{
+		Cell cell = board.at(x, y);
+		if (cell == Cell::EMPTY || cell == Cell::FOOD)
+			return true;
+		const Point& tail = board.tail();
+		return cell == Cell::SNAKE && x == tail.x && y == tail.y && board.body.size() > 2;
+	}
+}
+
+/**
+ * @brief Constructeur par défaut.
+ */
+GreedyAi::GreedyAi() {}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+GreedyAi::~GreedyAi() {}
+
+/**
+ * @brief Direction sûre la plus proche de la nourriture.
+ *
+ * @param board Vue de la partie.
+ * @return La direction choisie, ou NONE si aucune case voisine n'est sûre.
+ */
+Input GreedyAi::decide(const BoardView& board)
+{
+	const Point& head = board.head();
+	int reverse = static_cast<int>(board.direction) ^ 1;
+	Input best = Input::NONE;
+	int bestDistance = 0;
+
+	for (int move = 0; move < 4; ++move)
+	{
+		int x = head.x + DX[move];
+		int y = head.y + DY[move];
+		if (move == reverse || !isSafe(board, x, y))
+			continue;
+		int distance = std::abs(board.food.x - x) + std::abs(board.food.y - y);
+		if (best == Input::NONE || distance < bestDistance)
+		{
+			best = MOVES[move];
+			bestDistance = distance;
+		}
+	}
+	return best;
+}
@@ -0,0 +1,26 @@
+/**
+ * @file GreedyAi.hpp
+ * @brief Déclaration de la classe GreedyAi, contrôleur glouton chargé dynamiquement.
+ */
+
+#pragma once
+
+#include "../includes/IBoardController.hpp"
+
+/**
+ * @class GreedyAi
+ * @brief Se rapproche de la nourriture par une case sûre, sans regarder plus loin.
+ *
+ * Parmi les directions qui n'entraînent pas de collision au prochain tick,
+ * choisit celle qui rapproche le plus de la nourriture (distance de
+ * Manhattan). Sans mémoire ni allocation : sert de référence au classement
+ * (`--rank`) et d'exemple minimal de bibliothèque `libai_*.so`.
+ */
+class GreedyAi : public IBoardController
+{
+	public:
+		GreedyAi();
+		~GreedyAi();
+
+		Input decide(const BoardView& board) override;
+};
@@ -0,0 +1,29 @@
+/**
+ * @file entrypoint.cpp
+ * @brief Point d'entrée du contrôleur glouton.
+ *
+ * Ce fichier contient les fonctions exportées par la bibliothèque
+ * libai_greedy.so, chargée avec `--ai`.
+ */
+
+#include "GreedyAi.hpp"
+
+/**
+ * @brief Point d'entrée utilisé par dlsym() pour créer dynamiquement le contrôleur.
+ *
+ * @return Un pointeur vers un objet GreedyAi qui implémente l'interface IBoardController.
+ */
+extern "C" IBoardController* createController()
+{
+	return new GreedyAi();
+}
+
+/**
+ * @brief Détruit un contrôleur créé par createController(), dans la bibliothèque qui l'a alloué.
+ *
+ * @param controller Le contrôleur à détruire (peut être nul).
+ */
+extern "C" void destroyController(IBoardController* controller)
+{
+	delete controller;
+}
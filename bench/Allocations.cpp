@@ -0,0 +1,69 @@
+/**
+ * @file Allocations.cpp
+ * @brief operator new compté, pour vérifier qu'une boucle mesurée n'alloue rien.
+ *
+ * Le remplacement vaut pour tout le programme, y compris les bibliothèques
+ * chargées avec dlopen() : elles résolvent operator new dans l'exécutable.
+ * Il est seul dans son fichier pour que le compilateur ne voie jamais
+ * ensemble un new et le free() qui lui correspond.
+ */
+
+#include "Bench.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<uint64_t>	g_allocations(0);	///< Appels à operator new depuis le lancement.
+}
+
+/**
+ * @brief Nombre d'appels à operator new depuis le lancement du programme.
+ */
+uint64_t allocationCount()
+{
+	return g_allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief operator new compté.
+ */
+void* operator new(size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+/**
+ * @brief operator new[] compté.
+ */
+void* operator new[](size_t size)
+{
+	return ::operator new(size);
+}
+
+/**
+ * @brief Libère un bloc de operator new (toutes les formes de delete).
+ */
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
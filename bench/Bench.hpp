@@ -0,0 +1,57 @@
+/**
+ * @file Bench.hpp
+ * @brief Déclarations communes aux benchmarks du moteur de jeu.
+ *
+ * Chaque benchmark écrit ses résultats sur la sortie standard au format CSV
+ * (une ligne d'en-tête puis une ligne par mesure) afin de pouvoir comparer
+ * les résultats d'un commit à l'autre.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "../core/Snake.hpp"
+#include "../includes/Input.hpp"
+
+class GameState;
+
+/**
+ * @brief Horloge utilisée par tous les benchmarks.
+ */
+using BenchClock = std::chrono::steady_clock;
+
+/**
+ * @brief Nombre de nanosecondes écoulées depuis un instant donné.
+ *
+ * @param start Instant de départ.
+ * @return Durée écoulée en nanosecondes.
+ */
+inline double elapsedNs(BenchClock::time_point start)
+{
+	return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+/**
+ * @brief Puits global empêchant le compilateur d'éliminer les calculs mesurés.
+ */
+extern volatile long g_benchSink;
+
+uint64_t	allocationCount();
+Snake	makeLongSnake(int length, int width, int height);
+Input	steerToFood(const GameState& state);
+void	benchAutopilot();
+void	benchBatch();
+void	benchCore();
+void	benchEnv();
+void	benchHamilton();
+void	benchMatches();
+void	benchMcts();
+void	benchNcurses();
+void	benchReplay();
+void	benchOpenGL();
+void	benchSDL();
+void	benchSnapshot();
+void	benchStartup();
+void	benchSwitch();
+void	benchTick();
@@ -0,0 +1,127 @@
+/**
+ * @file BenchAutopilot.cpp
+ * @brief Benchmark de l'autopilote : temps de planification par tick et qualité de jeu.
+ *
+ * Joue des parties complètes dirigées par l'autopilote, le même pour toutes
+ * les parties d'un plateau (ses tampons, dimensionnés à sa construction,
+ * sont réutilisés d'une partie à l'autre). Le temps de planification est
+ * mesuré à chaque tick, en temps réel par l'autopilote (plan_*_ns) et en
+ * temps CPU du thread par le benchmark (plan_cpu_*_ns). Sur un plateau de
+ * 1000x1000, le tick le plus long en temps CPU doit rester sous la
+ * milliseconde, sans quoi le benchmark échoue : le temps CPU ne compte pas
+ * les moments où le système a préempté le thread, que le temps réel compte.
+ */
+
+#include "Bench.hpp"
+#include "../ai/Autopilot.hpp"
+#include "../core/GameState.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+namespace
+{
+	const uint64_t PLAN_MAX_LIMIT_NS = 1000000;	///< Limite du tick le plus long (temps CPU) sur les grands plateaux.
+	const int LARGE_BOARD = 1000;					///< Côté à partir duquel la limite s'applique.
+
+	/**
+	 * @brief Plateau joué par le benchmark.
+	 */
+	struct Board
+	{
+		int			size;		///< Côté du plateau.
+		bool		obstacles;	///< Obstacles activés.
+		uint64_t	games;		///< Parties jouées.
+	};
+
+	/**
+	 * @brief Totaux d'une série de parties.
+	 */
+	struct AutopilotTotals
+	{
+		uint64_t	games;		///< Parties gagnées ou perdues.
+		uint64_t	wins;		///< Parties gagnées (score limite ou plateau rempli).
+		uint64_t	ticks;		///< Ticks joués.
+		uint64_t	score;		///< Somme des scores.
+		uint64_t	searches;	///< Recherches A* effectuées.
+		double		ns;			///< Durée totale (planification et mises à jour).
+		Histogram	plan;		///< Temps de planification de chaque tick (temps réel).
+		Histogram	planCpu;	///< Temps de planification de chaque tick (temps CPU du thread).
+	};
+
+	/**
+	 * @brief Temps CPU consommé par le thread appelant, en nanosecondes.
+	 */
+	uint64_t threadCpuNs()
+	{
+		struct timespec now;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+		return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+	}
+
+	/**
+	 * @brief Joue toutes les parties d'un plateau avec un même autopilote.
+	 */
+	AutopilotTotals playBoard(const Board& board)
+	{
+		Autopilot autopilot(board.size, board.size);
+		AutopilotTotals totals = { 0, 0, 0, 0, 0, 0, Histogram(), Histogram() };
+
+		for (uint64_t seed = 1; seed <= board.games; ++seed)
+		{
+			GameState state(board.size, board.size, board.obstacles, seed);
+			BenchClock::time_point start = BenchClock::now();
+			while (!state.isFinished())
+			{
+				uint64_t cpuStart = threadCpuNs();
+				Input input = autopilot.nextInput(state);
+				totals.planCpu.record(threadCpuNs() - cpuStart);
+				state.queueDirection(input);
+				state.update();
+				++totals.ticks;
+			}
+			totals.ns += elapsedNs(start);
+			++totals.games;
+			totals.score += state.getScore();
+			if (state.isWon())
+				++totals.wins;
+		}
+		totals.searches = autopilot.getSearches();
+		totals.plan = autopilot.getPlanTimes();
+		return totals;
+	}
+}
+
+/**
+ * @brief Temps de planification, victoires et ticks par partie, par plateau.
+ */
+void benchAutopilot()
+{
+	const Board boards[] = { { 30, false, 200 }, { 100, true, 100 }, { 1000, false, 10 }, { 1000, true, 10 } };
+
+	bool tooSlow = false;
+	std::cout << "bench,board,obstacles,games,wins,mean_score,ticks_per_game,searches,"
+	          << "plan_p50_ns,plan_p99_ns,plan_max_ns,plan_cpu_p99_ns,plan_cpu_max_ns,ns_per_tick\n";
+	for (const Board& board : boards)
+	{
+		AutopilotTotals totals = playBoard(board);
+		const Histogram& plan = totals.plan;
+
+		std::cout << "autopilot," << board.size << "x" << board.size << "," << (board.obstacles ? "yes" : "no")
+		          << "," << totals.games << "," << totals.wins << ","
+		          << static_cast<double>(totals.score) / totals.games << ","
+		          << totals.ticks / totals.games << "," << totals.searches << ","
+		          << plan.percentile(50) << "," << plan.percentile(99) << "," << plan.getMax() << ","
+		          << totals.planCpu.percentile(99) << "," << totals.planCpu.getMax() << ","
+		          << totals.ns / totals.ticks << "\n";
+		if (board.size >= LARGE_BOARD && totals.planCpu.getMax() > PLAN_MAX_LIMIT_NS)
+			tooSlow = true;
+	}
+
+	if (tooSlow)
+	{
+		std::cerr << "autopilot: slowest planning tick exceeds " << PLAN_MAX_LIMIT_NS
+		          << " ns of CPU time on a large board" << std::endl;
+		std::exit(1);
+	}
+}
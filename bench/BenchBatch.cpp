@@ -0,0 +1,185 @@
+/**
+ * @file BenchBatch.cpp
+ * @brief Conformité et débit de la simulation par lots (BatchSim).
+ *
+ * La conformité fait avancer en parallèle des parties scalaires (GameState)
+ * et leurs copies dans un BatchSim avec les mêmes directions aléatoires, et
+ * compare chaque partie après chaque tick. Toute divergence arrête le
+ * benchmark avec un code de retour non nul ; le projet n'ayant pas de suite
+ * de tests, ce benchmark en tient lieu pour BatchSim.
+ *
+ * Le débit compare ensuite le nombre de pas de partie par seconde des deux
+ * chemins pour des lots de tailles croissantes.
+ */
+
+#include "Bench.hpp"
+#include "../core/BatchSim.hpp"
+#include "../core/Rng.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Tire une direction pour chaque partie (souvent « garder la direction »).
+ */
+static void randomDirections(Rng& rng, std::vector<uint8_t>& directions)
+{
+	for (uint8_t& d : directions)
+	{
+		uint64_t r = rng.bounded(8);
+		d = r < 4 ? static_cast<uint8_t>(r) : BatchSim::KEEP_DIRECTION;
+	}
+}
+
+/**
+ * @brief Fait suivre à chaque serpent un cycle hamiltonien du plateau.
+ *
+ * Le cycle remonte par la première colonne intérieure et parcourt les autres
+ * en serpentin (la hauteur intérieure doit être paire). Un serpent qui part
+ * de la première ligne vers la droite ne meurt jamais : les parties finissent
+ * par victoire ou plateau plein, ce qui couvre les chemins de nourriture.
+ */
+static void cycleDirections(const BatchSim& batch, int width, int height, std::vector<uint8_t>& directions)
+{
+	for (size_t i = 0; i < directions.size(); ++i)
+	{
+		Point head = batch.getHead(i);
+		int x = head.x - 1;
+		int y = head.y - 1;
+		Direction d;
+
+		if (x == 0)
+			d = y == 0 ? Direction::RIGHT : Direction::UP;
+		else if (y % 2 == 0)
+			d = x == width - 3 ? Direction::DOWN : Direction::RIGHT;
+		else
+			d = (x == 1 && y != height - 3) ? Direction::DOWN : Direction::LEFT;
+		directions[i] = static_cast<uint8_t>(d);
+	}
+}
+
+/**
+ * @brief Applique un tick aux parties scalaires, comme BatchSim::step().
+ */
+static void stepScalar(std::vector<GameState>& states, const std::vector<uint8_t>& directions)
+{
+	for (size_t i = 0; i < states.size(); ++i)
+	{
+		if (states[i].isFinished())
+			continue;
+		if (directions[i] != BatchSim::KEEP_DIRECTION)
+			states[i].setDirection(static_cast<Input>(directions[i]));
+		states[i].update();
+	}
+}
+
+/**
+ * @brief Vérifie tick par tick que BatchSim reproduit GameState.
+ *
+ * @return false à la première divergence (après l'avoir signalée).
+ */
+static bool checkConformance(int width, int height, bool obstacles, size_t games, int ticks, bool cycle)
+{
+	std::vector<GameState> states;
+	BatchSim batch(width, height, games);
+	std::vector<uint8_t> directions(games);
+	Rng rng(width * 31 + height);
+
+	states.reserve(games);
+	for (size_t i = 0; i < games; ++i)
+	{
+		int y = cycle ? 1 : height / 2;
+		states.push_back(GameState(width, height, obstacles, Snake(4, y, static_cast<size_t>(width) * height), i + 1));
+		batch.load(i, states[i]);
+	}
+	for (int tick = 0; tick < ticks && batch.getAliveCount() > 0; ++tick)
+	{
+		if (cycle)
+			cycleDirections(batch, width, height, directions);
+		else
+			randomDirections(rng, directions);
+		stepScalar(states, directions);
+		batch.step(directions.data());
+		for (size_t i = 0; i < games; ++i)
+		{
+			if (!batch.matches(i, states[i]))
+			{
+				std::cerr << "batch: divergence on " << width << "x" << height
+				          << " game " << i << " at tick " << tick << "\n";
+				return false;
+			}
+		}
+	}
+
+	size_t won = 0;
+	size_t full = 0;
+	for (size_t i = 0; i < games; ++i)
+	{
+		won += batch.getScore(i) >= GameState::SCORE_LIMIT;
+		full += batch.isBoardFull(i);
+	}
+	std::cout << "batch_conformance," << width << "x" << height << ","
+	          << games << "," << won << "," << full << "\n";
+	return true;
+}
+
+/**
+ * @brief Conformité puis débit de BatchSim face à GameState.
+ */
+void benchBatch()
+{
+	std::cout << "bench,board,games,won,board_full\n";
+	if (!checkConformance(40, 30, true, 512, 3000, false)
+		|| !checkConformance(100, 60, true, 64, 3000, false)
+		|| !checkConformance(7, 4, false, 256, 3000, true)
+		|| !checkConformance(12, 8, false, 256, 3000, true))
+		std::exit(1);
+
+	const size_t sizes[] = { 64, 1024, 4096, 16384 };
+	const int width = 32;
+	const int height = 32;
+	const int ticks = 64;
+	const int rounds = 8;
+
+	std::cout << "bench,games,scalar_steps_per_s,batch_steps_per_s\n";
+	for (size_t games : sizes)
+	{
+		std::vector<GameState> initial;
+		initial.reserve(games);
+		for (size_t i = 0; i < games; ++i)
+			initial.push_back(GameState(width, height, true, Snake(4, height / 2, width * height), i + 1));
+
+		std::vector<std::vector<uint8_t>> script(ticks, std::vector<uint8_t>(games));
+		Rng rng(games);
+		for (std::vector<uint8_t>& directions : script)
+			randomDirections(rng, directions);
+
+		double scalarNs = 0;
+		double batchNs = 0;
+		long steps = 0;
+		BatchSim batch(width, height, games);
+		for (int round = 0; round < rounds; ++round)
+		{
+			std::vector<GameState> states(initial);
+			for (size_t i = 0; i < games; ++i)
+				batch.load(i, initial[i]);
+
+			BenchClock::time_point start = BenchClock::now();
+			for (int tick = 0; tick < ticks; ++tick)
+				stepScalar(states, script[tick]);
+			scalarNs += elapsedNs(start);
+
+			start = BenchClock::now();
+			for (int tick = 0; tick < ticks; ++tick)
+			{
+				steps += batch.getAliveCount();
+				batch.step(script[tick].data());
+			}
+			batchNs += elapsedNs(start);
+		}
+		std::cout << "batch," << games << ","
+		          << steps / (scalarNs * 1e-9) << ","
+		          << steps / (batchNs * 1e-9) << "\n";
+		g_benchSink += steps;
+	}
+}
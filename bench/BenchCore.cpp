@@ -0,0 +1,138 @@
+/**
+ * @file BenchCore.cpp
+ * @brief Micro-benchmarks des opérations du moteur, par taille de plateau et longueur de serpent.
+ *
+ * Mesure Snake::move(), Snake::grow(), Snake::checkCollision(),
+ * GameState::update(), GameState::generateFood() et
+ * GameState::generateObstacles() pour des plateaux de 30x30 à 10000x10000
+ * et des serpents de 4 à 1 000 000 segments (les combinaisons où le serpent
+ * ne tient pas sur le plateau sont ignorées).
+ *
+ * Une ligne CSV par mesure, identifiée par (op, board, length) : deux
+ * exécutions sur des commits différents se comparent ligne à ligne.
+ */
+
+#include "Bench.hpp"
+#include "../core/GameState.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	/**
+	 * @brief Écrit une ligne de résultat.
+	 *
+	 * @param op Opération mesurée.
+	 * @param size Côté du plateau.
+	 * @param length Longueur du serpent (0 si sans objet).
+	 * @param ops Nombre d'opérations mesurées.
+	 * @param ns Durée totale en nanosecondes.
+	 */
+	void report(const char* op, int size, size_t length, size_t ops, double ns)
+	{
+		std::cout << "core," << op << "," << size << "x" << size << "," << length << ","
+		          << ops << "," << (ops > 0 ? ns / ops : 0) << "," << ns / 1e6 << "\n";
+	}
+
+	/**
+	 * @brief Nombre de lignes occupées par un serpent de makeLongSnake().
+	 */
+	int snakeRows(int length, int size)
+	{
+		return length / (size - 6) + 2;
+	}
+
+	/**
+	 * @brief Opérations du serpent seul : déplacement, croissance, collision linéaire.
+	 */
+	void benchSnake(int size, int length)
+	{
+		Snake snake = makeLongSnake(length, size, size);
+		size_t capacity = static_cast<size_t>(size) * size;
+
+		size_t moves = 100000;
+		BenchClock::time_point start = BenchClock::now();
+		for (size_t i = 0; i < moves; ++i)
+			snake.move();
+		report("snake_move", size, snake.getLength(), moves, elapsedNs(start));
+
+		// Le parcours du corps est linéaire : moins d'itérations pour les longs serpents
+		size_t scans = std::max<size_t>(10, 10000000 / snake.getLength());
+		Point probe(-1, -1);
+		int hits = 0;
+		start = BenchClock::now();
+		for (size_t i = 0; i < scans; ++i)
+			hits += snake.checkCollision(probe, true);
+		report("snake_check_collision", size, snake.getLength(), scans, elapsedNs(start));
+		g_benchSink += hits;
+
+		size_t length0 = snake.getLength();
+		size_t grows = std::min<size_t>(100000, capacity - length0);
+		start = BenchClock::now();
+		for (size_t i = 0; i < grows; ++i)
+			snake.grow();
+		report("snake_grow", size, length0, grows, elapsedNs(start));
+	}
+
+	/**
+	 * @brief Ticks de jeu puis tirages de nourriture sur un plateau où le serpent est posé.
+	 */
+	void benchGameState(int size, int length)
+	{
+		int rows = snakeRows(length, size);
+		GameState state(size, size, false, makeLongSnake(length, size, size), 1);
+
+		// Le serpent descend tout droit dans la partie libre du plateau
+		size_t ticks = static_cast<size_t>(std::min(100000, size - rows - 3));
+		size_t done = 0;
+		BenchClock::time_point start = BenchClock::now();
+		for (; done < ticks && !state.isFinished(); ++done)
+			state.update();
+		report("gamestate_update", size, state.getSnake().getLength(), done, elapsedNs(start));
+
+		// Chaque tirage occupe une case : au plus la moitié des cases libres
+		size_t foods = std::min<size_t>(100000, state.getGrid().getFreeCount() / 2);
+		start = BenchClock::now();
+		for (size_t i = 0; i < foods; ++i)
+			state.generateFood();
+		report("generate_food", size, state.getSnake().getLength(), foods, elapsedNs(start));
+	}
+
+	/**
+	 * @brief Tirage des obstacles (1 % du plateau), mesuré par obstacle.
+	 */
+	void benchObstacles(int size)
+	{
+		GameState state(size, size, false, 1);
+		size_t before = state.getObstacles().size();
+
+		BenchClock::time_point start = BenchClock::now();
+		state.generateObstacles();
+		double ns = elapsedNs(start);
+		report("generate_obstacles", size, 0, state.getObstacles().size() - before, ns);
+	}
+}
+
+/**
+ * @brief Balaye les tailles de plateau et les longueurs de serpent.
+ */
+void benchCore()
+{
+	const int sizes[] = { 30, 100, 1000, 10000 };
+	const int lengths[] = { 4, 100, 10000, 1000000 };
+
+	std::cout << "bench,op,board,length,ops,ns_per_op,total_ms\n";
+	for (int size : sizes)
+	{
+		for (int length : lengths)
+		{
+			// Il faut laisser au serpent de la place pour avancer
+			if (snakeRows(length, size) + 10 > size)
+				continue;
+			benchSnake(size, length);
+			benchGameState(size, length);
+		}
+		benchObstacles(size);
+	}
+}
@@ -0,0 +1,209 @@
+/**
+ * @file BenchEnv.cpp
+ * @brief Conformité, allocations et débit de l'environnement d'apprentissage (libnibbler_env.so).
+ *
+ * La bibliothèque construite par `make -C env` est chargée avec dlopen(),
+ * comme le ferait un entraîneur : le benchmark mesure le code livré, et
+ * non une copie compilée avec lui.
+ *
+ * La conformité fait avancer un lot avec des actions aléatoires et compare,
+ * après chaque pas, les plans tenus à jour en place avec ceux que
+ * nibbler_env_write_observation() réécrit en entier à partir des parties ;
+ * toute différence arrête le benchmark avec un code de retour non nul.
+ *
+ * Le débit mesure ensuite les pas de partie par seconde de
+ * nibbler_env_step() pour des lots de 1 à 4096 parties, observations
+ * comprises. Les allocations (operator new, compté par Allocations.cpp,
+ * bibliothèque comprise) sont comptées pendant les pas : une seule arrête
+ * le benchmark.
+ *
+ * Nécessite libnibbler_env.so (`make -C env`) dans le dossier courant ou
+ * son parent.
+ */
+
+#include "Bench.hpp"
+#include "../core/Rng.hpp"
+#include "../core/SharedLibrary.hpp"
+#include "../env/nibbler_env.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Fonctions de l'API C résolues dans la bibliothèque chargée.
+	 */
+	struct EnvApi
+	{
+		SharedLibrary	library;
+		nibbler_env*	(*create)(int, int, int, uint64_t);
+		void			(*destroy)(nibbler_env*);
+		size_t			(*observationSize)(const nibbler_env*);
+		int				(*reset)(nibbler_env*, uint8_t*);
+		int				(*step)(nibbler_env*, const uint8_t*, float*, uint8_t*);
+		int				(*writeObservation)(const nibbler_env*, int, uint8_t*);
+
+		/**
+		 * @brief Charge la bibliothèque et résout ses fonctions.
+		 *
+		 * @throw std::runtime_error si la bibliothèque ou une fonction manque.
+		 */
+		explicit EnvApi(const std::string& path) : library(path)
+		{
+			create = reinterpret_cast<nibbler_env* (*)(int, int, int, uint64_t)>(library.symbol("nibbler_env_create"));
+			destroy = reinterpret_cast<void (*)(nibbler_env*)>(library.symbol("nibbler_env_destroy"));
+			observationSize = reinterpret_cast<size_t (*)(const nibbler_env*)>(
+				library.symbol("nibbler_env_observation_size"));
+			reset = reinterpret_cast<int (*)(nibbler_env*, uint8_t*)>(library.symbol("nibbler_env_reset"));
+			step = reinterpret_cast<int (*)(nibbler_env*, const uint8_t*, float*, uint8_t*)>(
+				library.symbol("nibbler_env_step"));
+			writeObservation = reinterpret_cast<int (*)(const nibbler_env*, int, uint8_t*)>(
+				library.symbol("nibbler_env_write_observation"));
+		}
+	};
+
+	/**
+	 * @brief Tire une action par partie, souvent « garder la direction » (8 actions par tirage).
+	 */
+	void randomActions(Rng& rng, std::vector<uint8_t>& actions)
+	{
+		for (size_t i = 0; i < actions.size(); i += 8)
+		{
+			uint64_t bits = rng.next();
+			for (size_t j = i; j < i + 8 && j < actions.size(); ++j, bits >>= 8)
+				actions[j] = static_cast<uint8_t>(bits & 7);
+		}
+	}
+
+	/**
+	 * @brief Compare les plans tenus à jour en place avec des plans réécrits en entier.
+	 *
+	 * @return false à la première différence.
+	 */
+	bool checkConformity(const EnvApi& api)
+	{
+		const int ENVS = 64;
+		const int STEPS = 20000;
+		nibbler_env* env = api.create(ENVS, 12, 12, 7);
+		if (!env)
+		{
+			std::cerr << "env: nibbler_env_create failed\n";
+			return false;
+		}
+		size_t size = api.observationSize(env);
+		std::vector<uint8_t> observations(ENVS * size);
+		std::vector<uint8_t> expected(size);
+		std::vector<uint8_t> actions(ENVS);
+		std::vector<float> rewards(ENVS);
+		std::vector<uint8_t> dones(ENVS);
+		Rng rng(3);
+		uint64_t episodes = 0;
+		bool same = true;
+
+		api.reset(env, observations.data());
+		for (int step = 0; step < STEPS && same; ++step)
+		{
+			randomActions(rng, actions);
+			api.step(env, actions.data(), rewards.data(), dones.data());
+			for (int i = 0; i < ENVS && same; ++i)
+			{
+				episodes += dones[i];
+				api.writeObservation(env, i, expected.data());
+				if (std::memcmp(expected.data(), observations.data() + i * size, size) != 0)
+				{
+					std::cerr << "env: observation of game " << i << " differs after step " << step << "\n";
+					same = false;
+				}
+			}
+		}
+		api.destroy(env);
+		if (same)
+			std::cout << "env_conformity," << ENVS << "," << STEPS << "," << episodes << ",ok\n";
+		return same;
+	}
+
+	/**
+	 * @brief Chemin de libnibbler_env.so : dossier courant, sinon son parent.
+	 */
+	std::string libraryPath()
+	{
+		if (access("./libnibbler_env.so", F_OK) == 0)
+			return "./libnibbler_env.so";
+		return "../libnibbler_env.so";
+	}
+}
+
+/**
+ * @brief Conformité des observations, puis pas par seconde et allocations selon la taille du lot.
+ */
+void benchEnv()
+{
+	std::unique_ptr<EnvApi> api;
+	try
+	{
+		api.reset(new EnvApi(libraryPath()));
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cerr << "env: " << e.what() << " (run make -C env)" << std::endl;
+		std::exit(1);
+	}
+
+	std::cout << "bench,envs,steps,episodes,result\n";
+	if (!checkConformity(*api))
+		std::exit(1);
+
+	const uint64_t TOTAL_STEPS = 4000000;
+	std::cout << "bench,envs,board,steps_per_s,ns_per_step,episodes,obs_bytes,create_allocs,step_allocs\n";
+	for (int envs = 1; envs <= 4096; envs *= 4)
+	{
+		uint64_t before = allocationCount();
+		nibbler_env* env = api->create(envs, 30, 30, 1);
+		uint64_t createAllocations = allocationCount() - before;
+		if (!env)
+		{
+			std::cerr << "env: nibbler_env_create failed\n";
+			std::exit(1);
+		}
+		std::vector<uint8_t> observations(envs * api->observationSize(env));
+		std::vector<uint8_t> actions(envs);
+		std::vector<float> rewards(envs);
+		std::vector<uint8_t> dones(envs);
+		Rng rng(envs);
+		uint64_t rounds = TOTAL_STEPS / envs;
+		uint64_t episodes = 0;
+
+		api->reset(env, observations.data());
+		before = allocationCount();
+		BenchClock::time_point start = BenchClock::now();
+		for (uint64_t round = 0; round < rounds; ++round)
+		{
+			randomActions(rng, actions);
+			api->step(env, actions.data(), rewards.data(), dones.data());
+			for (uint8_t done : dones)
+				episodes += done;
+		}
+		double ns = elapsedNs(start);
+		uint64_t stepAllocations = allocationCount() - before;
+		uint64_t steps = rounds * envs;
+		g_benchSink += observations[observations.size() / 2];
+		std::cout << "env," << envs << ",30x30," << steps * 1e9 / ns << "," << ns / steps << ","
+		          << episodes << "," << observations.size() << "," << createAllocations << ","
+		          << stepAllocations << "\n";
+		api->destroy(env);
+
+		// Sans allocation comptée à la création, le compteur ne verrait pas la bibliothèque
+		if (createAllocations == 0 || stepAllocations != 0)
+		{
+			std::cerr << "env: " << stepAllocations << " allocations during steps ("
+			          << createAllocations << " at creation)" << std::endl;
+			std::exit(1);
+		}
+	}
+}
@@ -0,0 +1,206 @@
+/**
+ * @file BenchHamilton.cpp
+ * @brief Benchmark du circuit hamiltonien : construction, cache, et ticks pour remplir le plateau.
+ *
+ * Première série : durée de construction du circuit, puis de sa relecture
+ * depuis le cache (projection du fichier), par taille de plateau, avec et
+ * sans obstacles ; un cache corrompu doit ensuite être refusé et
+ * recalculé.
+ *
+ * Seconde série : parties jouées par HamiltonPilot. Sans obstacle, elles
+ * se jouent sans score limite et chacune doit remplir le plateau. Avec
+ * obstacles, des cases restent hors du circuit et le plateau ne peut être
+ * rempli : les parties se jouent jusqu'au score limite par défaut
+ * (GameState::SCORE_LIMIT), que chacune doit atteindre. Une partie perdue
+ * (colonne deaths) fait échouer le benchmark.
+ */
+
+#include "Bench.hpp"
+#include "../ai/HamiltonCycle.hpp"
+#include "../ai/HamiltonPilot.hpp"
+#include "../core/GameState.hpp"
+#include "../core/Histogram.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+
+namespace
+{
+	/**
+	 * @brief Échange les deux dernières cases du circuit dans un fichier de cache.
+	 *
+	 * Le fichier reste de la bonne taille et son en-tête reste valide : seule
+	 * la vérification du circuit peut le refuser.
+	 *
+	 * @param path Fichier de cache.
+	 * @param length Nombre de cases du circuit.
+	 */
+	void corruptCache(const std::string& path, size_t length)
+	{
+		std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+		uint32_t cells[2];
+
+		file.seekg(-static_cast<std::streamoff>(sizeof(cells)), std::ios::end);
+		file.read(reinterpret_cast<char*>(cells), sizeof(cells));
+		std::swap(cells[0], cells[1]);
+		file.seekp(-static_cast<std::streamoff>(sizeof(cells)), std::ios::end);
+		file.write(reinterpret_cast<const char*>(cells), sizeof(cells));
+		if (!file || length < 2)
+			throw std::runtime_error(path + ": cannot corrupt cache");
+	}
+
+	/**
+	 * @brief Construction, écriture et relecture du cache pour un plateau.
+	 *
+	 * @param directory Dossier du cache.
+	 * @param size Côté du plateau.
+	 * @param obstacles Active les obstacles.
+	 */
+	void benchCycle(const std::string& directory, int size, bool obstacles)
+	{
+		const int RUNS = size >= 1000 ? 3 : 20;
+		GameState state(size, size, obstacles, 1);
+		std::string path = HamiltonCycle::cachePath(directory, state);
+		double buildNs = 0;
+		double loadNs = 0;
+		size_t length = 0;
+
+		for (int run = 0; run < RUNS; ++run)
+		{
+			BenchClock::time_point start = BenchClock::now();
+			HamiltonCycle built(state);
+			buildNs += elapsedNs(start);
+			length = built.getLength();
+			if (run == 0)
+				built.save(path);
+		}
+		for (int run = 0; run < RUNS; ++run)
+		{
+			BenchClock::time_point start = BenchClock::now();
+			bool cached = false;
+			std::unique_ptr<HamiltonCycle> loaded = HamiltonCycle::load(state, directory, &cached);
+			loadNs += elapsedNs(start);
+			if (!cached || loaded->getLength() != length)
+				throw std::runtime_error("HamiltonCycle: cache was not reused");
+			g_benchSink += loaded->getPath()[length / 2];
+		}
+		corruptCache(path, length);
+		bool cached = true;
+		std::unique_ptr<HamiltonCycle> rebuilt = HamiltonCycle::load(state, directory, &cached);
+		if (cached || rebuilt->getLength() != length)
+			throw std::runtime_error("HamiltonCycle: corrupted cache was reused");
+		std::remove(path.c_str());
+
+		size_t cells = static_cast<size_t>(size - 2) * (size - 2) - state.getObstacles().size();
+		std::cout << "hamilton_cycle," << size << "x" << size << "," << (obstacles ? "yes" : "no") << ","
+		          << cells << "," << length << "," << buildNs / RUNS / 1e6 << "," << loadNs / RUNS / 1e6 << ","
+		          << (size_t(64) + static_cast<size_t>(size) * size * 4 + length * 4) << "\n";
+	}
+
+	/**
+	 * @brief Parties jusqu'au plateau plein (sans obstacle) ou jusqu'au score limite (avec obstacles).
+	 *
+	 * Sans obstacle, le plateau ne change pas d'une graine à l'autre et le
+	 * circuit sert à toutes les parties ; avec obstacles, chacune a le sien.
+	 *
+	 * @param size Côté du plateau.
+	 * @param obstacles Active les obstacles.
+	 * @param games Nombre de parties.
+	 * @return Nombre de parties perdues (ni plateau plein, ni score limite).
+	 */
+	uint64_t benchFill(int size, bool obstacles, uint64_t games)
+	{
+		std::unique_ptr<HamiltonCycle> cycle;
+		std::unique_ptr<HamiltonPilot> pilot;
+		Histogram plan;
+		uint64_t full = 0;
+		uint64_t deaths = 0;
+		uint64_t ticks = 0;
+		uint64_t length = 0;
+		uint64_t shortcuts = 0;
+		double ns = 0;
+
+		for (uint64_t seed = 1; seed <= games; ++seed)
+		{
+			GameState state(size, size, obstacles, seed);
+			state.setScoreLimit(obstacles ? GameState::SCORE_LIMIT : 0);
+			if (!cycle || obstacles)
+			{
+				if (pilot)
+				{
+					plan.merge(pilot->getPlanTimes());
+					shortcuts += pilot->getShortcuts();
+				}
+				pilot.reset();
+				cycle.reset(new HamiltonCycle(state));
+				pilot.reset(new HamiltonPilot(*cycle));
+			}
+			BenchClock::time_point start = BenchClock::now();
+			while (!state.isFinished())
+			{
+				state.queueDirection(pilot->nextInput(state));
+				state.update();
+				++ticks;
+			}
+			ns += elapsedNs(start);
+			length += state.getSnake().getLength();
+			if (state.isBoardFull())
+				++full;
+			if (!state.isWon())
+				++deaths;
+		}
+		plan.merge(pilot->getPlanTimes());
+		shortcuts += pilot->getShortcuts();
+
+		double meanLength = static_cast<double>(length) / games;
+		std::cout << "hamilton_fill," << size << "x" << size << "," << (obstacles ? "yes" : "no") << ","
+		          << games << "," << full << "," << deaths << "," << meanLength << "," << ticks / games << ","
+		          << ticks / games / meanLength << "," << shortcuts << "," << plan.percentile(50) << ","
+		          << plan.percentile(99) << "," << ns / ticks << "\n";
+		return deaths;
+	}
+}
+
+/**
+ * @brief Durées de construction et de relecture du circuit, puis ticks pour remplir le plateau.
+ */
+void benchHamilton()
+{
+	char directory[] = "/tmp/nibbler_cycle_XXXXXX";
+	if (!mkdtemp(directory))
+		throw std::runtime_error("Failed to create temporary directory");
+
+	std::cout << "bench,board,obstacles,cells,cycle_cells,build_ms,cached_load_ms,cache_bytes\n";
+	for (int size : { 30, 100, 1000 })
+		for (bool obstacles : { false, true })
+			benchCycle(directory, size, obstacles);
+	rmdir(directory);
+
+	struct Board
+	{
+		int			size;
+		bool		obstacles;
+		uint64_t	games;
+	};
+	const Board boards[] = { { 30, false, 10 }, { 31, false, 10 }, { 30, true, 10 }, { 60, false, 2 },
+		{ 100, false, 1 }, { 100, true, 10 } };
+
+	uint64_t deaths = 0;
+	std::cout << "bench,board,obstacles,games,full,deaths,mean_length,ticks_per_game,ticks_per_cell,shortcuts,"
+	          << "plan_p50_ns,plan_p99_ns,ns_per_tick\n";
+	for (const Board& board : boards)
+		deaths += benchFill(board.size, board.obstacles, board.games);
+
+	if (deaths != 0)
+	{
+		std::cerr << "hamilton: " << deaths << " games died before filling the board or reaching the score limit"
+		          << std::endl;
+		std::exit(1);
+	}
+}
@@ -0,0 +1,57 @@
+/**
+ * @file BenchMatches.cpp
+ * @brief Passage à l'échelle du tournoi parallèle (MatchRunner).
+ *
+ * Joue le même tournoi avec 1, 2, 4... threads jusqu'au nombre de cœurs et
+ * affiche le débit, l'accélération par rapport à un thread, l'utilisation
+ * moyenne des threads et l'empreinte des résultats (identique d'une ligne à
+ * l'autre : les résultats ne dépendent pas du nombre de threads).
+ */
+
+#include "Bench.hpp"
+#include "../core/GameState.hpp"
+#include "../core/MatchRunner.hpp"
+#include "../core/ThreadPool.hpp"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief Mesure le nombre de parties par seconde selon le nombre de threads.
+ */
+void benchMatches()
+{
+	MatchConfig config = { 40, 40, true, 42, 2000, 100000, GameState::SCORE_LIMIT };
+	unsigned cores = ThreadPool::defaultThreadCount();
+	double baseline = 0;
+	uint64_t checksum = 0;
+
+	std::cout << "bench,threads,games_per_s,speedup,mean_utilization,checksum\n";
+	for (unsigned threads = 1; ; threads *= 2)
+	{
+		if (threads > cores)
+			threads = cores;
+
+		ThreadPool pool(threads);
+		MatchReport report = runMatches(pool, config);
+		double rate = report.matches / report.seconds;
+		double utilization = 0;
+		for (double u : report.utilization)
+			utilization += u / report.utilization.size();
+
+		if (threads == 1)
+		{
+			baseline = rate;
+			checksum = report.checksum;
+		}
+		else if (report.checksum != checksum)
+		{
+			std::cerr << "matches: results differ with " << threads << " threads\n";
+			std::exit(1);
+		}
+		std::cout << "matches," << threads << "," << rate << ","
+		          << rate / baseline << "," << utilization << ","
+		          << std::hex << report.checksum << std::dec << "\n";
+		if (threads == cores)
+			break;
+	}
+}
@@ -0,0 +1,59 @@
+/**
+ * @file BenchMcts.cpp
+ * @brief Passage à l'échelle de la recherche Monte-Carlo (MctsPilot).
+ *
+ * Joue la même partie avec 1, 2, 4 et 8 threads de recherche, à budget
+ * fixe par coup, et affiche les simulations par seconde, l'accélération
+ * par rapport à un thread, la taille de l'arbre au dernier coup et le
+ * score atteint. Au-delà du nombre de cœurs (colonne `cores`), les threads
+ * se partagent les mêmes cœurs : l'accélération plafonne.
+ */
+
+#include "Bench.hpp"
+#include "../ai/MctsPilot.hpp"
+#include "../core/GameState.hpp"
+#include "../core/ThreadPool.hpp"
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+	const uint64_t BUDGET_NS = 5000000;	///< Budget de recherche par coup.
+	const int MOVES = 100;				///< Coups joués par mesure.
+}
+
+/**
+ * @brief Mesure les simulations par seconde selon le nombre de threads.
+ */
+void benchMcts()
+{
+	unsigned cores = ThreadPool::defaultThreadCount();
+	double baseline = 0;
+
+	std::cout << "bench,threads,cores,budget_ms,moves,playouts_per_s,speedup,nodes,score\n";
+	for (unsigned threads : { 1u, 2u, 4u, 8u })
+	{
+		ThreadPool pool(threads);
+		MctsPilot pilot(pool, BUDGET_NS);
+		GameState state(30, 30, false, 1);
+		int moves = 0;
+
+		for (; moves < MOVES && !state.isFinished(); ++moves)
+		{
+			state.queueDirection(pilot.nextInput(state));
+			state.update();
+		}
+		if (pilot.getPlayouts() == 0)
+		{
+			std::cerr << "mcts: no playout with " << threads << " threads\n";
+			std::exit(1);
+		}
+
+		double rate = pilot.getPlayouts() * 1e9 / pilot.getSearchNs();
+		if (threads == 1)
+			baseline = rate;
+		std::cout << "mcts," << threads << "," << cores << "," << BUDGET_NS / 1e6 << "," << moves << ","
+		          << rate << "," << rate / baseline << "," << pilot.getNodeCount() << ","
+		          << state.getScore() << "\n";
+	}
+}
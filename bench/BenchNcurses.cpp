@@ -0,0 +1,174 @@
+/**
+ * @file BenchNcurses.cpp
+ * @brief Benchmark des octets envoyés au terminal par la GUI ncurses.
+ *
+ * Rejoue la même partie trois fois dans un terminal virtuel dont la sortie
+ * est un fichier temporaire : en forçant un affichage complet à chaque
+ * frame, comme le faisait l'ancienne GUI, avec l'affichage incrémental de
+ * render(), puis en n'appliquant que les événements de chaque tick
+ * (apply()). La taille du fichier après chaque frame donne les octets
+ * écrits ; l'écran obtenu par apply() doit être celui d'un affichage complet.
+ */
+
+#include "Bench.hpp"
+#include "../core/Frame.hpp"
+#include "../core/GameState.hpp"
+#include "../gui_ncurses/GuiNcurses.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Octets écrits pour une partie, par frame.
+	 */
+	struct ByteStats
+	{
+		uint64_t	frames;	///< Frames affichés.
+		uint64_t	total;	///< Octets écrits par l'ensemble des frames.
+		uint64_t	worst;	///< Octets écrits par le frame le plus coûteux.
+		double		ns;		///< Temps passé dans render() ou apply().
+	};
+
+	/**
+	 * @brief Manière d'afficher chaque frame.
+	 */
+	enum class Mode
+	{
+		FULL,			///< Affichage complet forcé.
+		INCREMENTAL,	///< render() incrémental.
+		EVENTS			///< apply() avec les événements du tick.
+	};
+
+	const char* const MODE_NAMES[] = { "full", "incremental", "events" };
+
+	/**
+	 * @brief Octets écrits dans le fichier depuis son ouverture.
+	 */
+	uint64_t bytesWritten(FILE* output)
+	{
+		std::fflush(output);
+		off_t offset = lseek(fileno(output), 0, SEEK_CUR);
+		return offset < 0 ? 0 : static_cast<uint64_t>(offset);
+	}
+
+	/**
+	 * @brief Contenu de l'écran ncurses, case par case.
+	 */
+	std::vector<chtype> screenCells(int width, int height)
+	{
+		std::vector<chtype> cells;
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				cells.push_back(mvinch(y, x));
+		return cells;
+	}
+
+	/**
+	 * @brief Affiche `ticks` frames d'une partie dans le mode demandé.
+	 */
+	ByteStats playFrames(GuiNcurses& gui, FILE* output, int width, int height, int ticks, Mode mode)
+	{
+		GameState state(width, height, true, 42);
+		Frame frame;
+		ByteStats stats = { 0, 0, 0, 0 };
+
+		state.recordEvents(mode == Mode::EVENTS);
+		gui.invalidate();
+		for (int tick = 0; tick <= ticks && !state.isFinished(); ++tick)
+		{
+			if (tick > 0)
+			{
+				state.setDirection(steerToFood(state));
+				state.update();
+			}
+			frame.capture(state, static_cast<uint64_t>(tick), 0);
+			frame.setEvents(state.getEvents(), static_cast<uint64_t>(tick) + 1);
+			state.clearEvents();
+			if (mode == Mode::FULL)
+				gui.invalidate();
+
+			uint64_t before = bytesWritten(output);
+			BenchClock::time_point start = BenchClock::now();
+			if (mode != Mode::EVENTS || tick == 0 || !gui.apply(frame.getEvents()))
+				gui.render(frame);
+			double ns = elapsedNs(start);
+			uint64_t bytes = bytesWritten(output) - before;
+			// Le premier frame est complet dans tous les modes
+			if (tick == 0)
+				continue;
+			++stats.frames;
+			stats.total += bytes;
+			stats.ns += ns;
+			if (bytes > stats.worst)
+				stats.worst = bytes;
+		}
+		return stats;
+	}
+}
+
+/**
+ * @brief Compare les octets et le temps par frame des affichages complet, incrémental et par événements.
+ */
+void benchNcurses()
+{
+	const int width = 100;
+	const int height = 50;
+	const int ticks = 1000;
+
+	setenv("TERM", "xterm-256color", 0);
+	setenv("COLUMNS", "120", 1);
+	setenv("LINES", "60", 1);
+	FILE* output = std::tmpfile();
+	if (output == nullptr)
+		throw std::runtime_error("Failed to open temporary file");
+
+	GuiNcurses gui;
+	gui.init(width, height, output);
+	ByteStats stats[3];
+	for (int i = 0; i < 3; ++i)
+		stats[i] = playFrames(gui, output, width, height, ticks, static_cast<Mode>(i));
+
+	// L'écran obtenu par apply() doit être celui d'un affichage complet
+	std::vector<chtype> applied = screenCells(width, height);
+	gui.invalidate();
+	GameState state(width, height, true, 42);
+	Frame frame;
+	for (uint64_t tick = 1; tick <= stats[2].frames; ++tick)
+	{
+		state.setDirection(steerToFood(state));
+		state.update();
+	}
+	frame.capture(state, stats[2].frames, 0);
+	gui.render(frame);
+	bool same = screenCells(width, height) == applied;
+
+	try
+	{
+		gui.cleanup();
+	}
+	catch (const std::runtime_error&)
+	{
+		// endwin() échoue lorsque la sortie n'est pas un terminal
+	}
+	std::fclose(output);
+
+	std::cout << "bench,board,mode,frames,bytes_per_frame,worst_frame_bytes,ns_per_frame\n";
+	for (int i = 0; i < 3; ++i)
+	{
+		double frames = static_cast<double>(stats[i].frames);
+		std::cout << "ncurses," << width << "x" << height << "," << MODE_NAMES[i]
+		          << "," << stats[i].frames << ","
+		          << (frames > 0 ? stats[i].total / frames : 0) << ","
+		          << stats[i].worst << "," << (frames > 0 ? stats[i].ns / frames : 0) << "\n";
+	}
+	if (!same)
+	{
+		std::cerr << "ncurses: screen built from render events differs from a full redraw" << std::endl;
+		std::exit(1);
+	}
+}
@@ -0,0 +1,158 @@
+/**
+ * @file BenchOpenGL.cpp
+ * @brief Benchmark du rendu instancié de la GUI OpenGL, sans carte graphique.
+ *
+ * Crée un contexte OpenGL 3.3 core hors écran avec EGL (plateforme
+ * « surfaceless » de Mesa, rendu par llvmpipe) et affiche un plateau de
+ * 100x100 presque rempli par le serpent. Mesure le temps par frame, compte
+ * les appels de dessin (l'ancien rendu en mode immédiat en faisait un par
+ * case) et vérifie la couleur de quelques pixels.
+ *
+ * Compilé uniquement par `make gl`, qui définit NIBBLER_BENCH_GL.
+ */
+
+#include "Bench.hpp"
+#include "../core/Frame.hpp"
+#include "../core/GameState.hpp"
+#include "../gui_opengl/CellRenderer.hpp"
+#include <EGL/egl.h>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Contexte OpenGL 3.3 core hors écran, rendu dans un pbuffer.
+	 */
+	class HeadlessContext
+	{
+		public:
+			HeadlessContext(int width, int height)
+				: _display(EGL_NO_DISPLAY), _surface(EGL_NO_SURFACE), _context(EGL_NO_CONTEXT)
+			{
+				static const EGLint configAttributes[] = {
+					EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+					EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+					EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+					EGL_NONE
+				};
+				static const EGLint contextAttributes[] = {
+					EGL_CONTEXT_MAJOR_VERSION, 3,
+					EGL_CONTEXT_MINOR_VERSION, 3,
+					EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+					EGL_NONE
+				};
+				const EGLint surfaceAttributes[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+				EGLConfig config;
+				EGLint count = 0;
+
+				_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+				if (_display == EGL_NO_DISPLAY || !eglInitialize(_display, nullptr, nullptr))
+					throw std::runtime_error("Failed to initialize EGL");
+				if (!eglChooseConfig(_display, configAttributes, &config, 1, &count) || count == 0)
+					throw std::runtime_error("No EGL config for OpenGL pbuffers");
+				_surface = eglCreatePbufferSurface(_display, config, surfaceAttributes);
+				eglBindAPI(EGL_OPENGL_API);
+				_context = eglCreateContext(_display, config, EGL_NO_CONTEXT, contextAttributes);
+				if (_surface == EGL_NO_SURFACE || _context == EGL_NO_CONTEXT
+					|| !eglMakeCurrent(_display, _surface, _surface, _context))
+					throw std::runtime_error("Failed to create an OpenGL 3.3 core context");
+			}
+
+			HeadlessContext(const HeadlessContext&) = delete;
+			HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+			~HeadlessContext()
+			{
+				eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+				if (_context != EGL_NO_CONTEXT)
+					eglDestroyContext(_display, _context);
+				if (_surface != EGL_NO_SURFACE)
+					eglDestroySurface(_display, _surface);
+				eglTerminate(_display);
+			}
+
+		private:
+			EGLDisplay	_display;	///< Connexion EGL.
+			EGLSurface	_surface;	///< Pbuffer de rendu.
+			EGLContext	_context;	///< Contexte OpenGL.
+	};
+
+	/**
+	 * @brief Vérifie la couleur du pixel au centre d'une case.
+	 *
+	 * @return true si la couleur lue correspond à celle attendue.
+	 */
+	bool checkCell(const Point& cell, int cellSize, int viewHeight, const unsigned char expected[3])
+	{
+		unsigned char pixel[4] = {};
+		int x = cell.x * cellSize + cellSize / 2;
+		int y = viewHeight - 1 - (cell.y * cellSize + cellSize / 2);
+
+		glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+		for (int c = 0; c < 3; ++c)
+			if (std::abs(pixel[c] - expected[c]) > 2)
+				return false;
+		return true;
+	}
+}
+
+/**
+ * @brief Mesure le rendu instancié d'un plateau de 100x100 avec un serpent très long.
+ */
+void benchOpenGL()
+{
+	const int size = 100;
+	const int cellSize = 10;
+	const int frames = 200;
+	const int view = size * cellSize;
+	static const unsigned char headColor[3] = { 0, 255, 0 };
+	static const unsigned char foodColor[3] = { 255, 153, 0 };
+
+	setenv("EGL_PLATFORM", "surfaceless", 0);
+	HeadlessContext context(view, view);
+	CellRenderer renderer;
+	renderer.init(size, size);
+	glViewport(0, 0, view, view);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+	GameState state(size, size, true, makeLongSnake(8000, size, size), 1);
+	Frame frame;
+	std::vector<CellInstance> cells;
+
+	frame.capture(state, 0, 0);
+	CellRenderer::obstacleCells(frame, cells);
+	renderer.setStaticCells(cells);
+
+	BenchClock::time_point start = BenchClock::now();
+	for (int i = 0; i < frames; ++i)
+	{
+		CellRenderer::frameCells(frame, static_cast<float>(i % 10) / 10.0f, cells);
+		renderer.draw(cells, true);
+		glFinish();
+	}
+	double frameMs = elapsedNs(start) / frames / 1e6;
+
+	// Dernier frame sans interpolation pour lire les cases exactes
+	CellRenderer::frameCells(frame, 1.0f, cells);
+	renderer.draw(cells, true);
+	glFinish();
+	bool pixelsOk = checkCell(frame.getSnake().getHead(), cellSize, view, headColor)
+		&& checkCell(frame.getFood(), cellSize, view, foodColor);
+
+	size_t immediateCalls = cells.size() + frame.getObstacles().size();
+	std::cout << "bench,board,snake,obstacles,draw_calls,immediate_draw_calls,ms_per_frame,renderer,pixels_ok\n"
+	          << "opengl," << size << "x" << size << "," << frame.getSnake().getLength() << ","
+	          << frame.getObstacles().size() << "," << renderer.getDrawCalls() << ","
+	          << immediateCalls << "," << frameMs << ",\""
+	          << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << "\","
+	          << (pixelsOk ? "yes" : "no") << "\n";
+	renderer.release();
+	if (!pixelsOk)
+	{
+		std::cerr << "opengl: unexpected pixel colors" << std::endl;
+		std::exit(1);
+	}
+}
@@ -0,0 +1,131 @@
+/**
+ * @file BenchReplay.cpp
+ * @brief Benchmark de l'enregistrement et de la relecture des parties.
+ *
+ * Joue des parties pilotées (direction de la nourriture) en enregistrant
+ * leurs entrées comme le fait la simulation, les écrit dans un fichier
+ * temporaire puis les rejoue sans affichage : la relecture doit retrouver
+ * le score et l'empreinte de l'état final de chaque partie. Mesure la
+ * taille du fichier par entrée et le débit de la relecture.
+ */
+
+#include "Bench.hpp"
+#include "../core/GameState.hpp"
+#include "../core/Replay.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+	/**
+	 * @brief Totaux d'une série de parties.
+	 */
+	struct ReplayTotals
+	{
+		uint64_t	games;		///< Parties jouées.
+		uint64_t	ticks;		///< Ticks joués.
+		uint64_t	records;	///< Entrées enregistrées.
+		uint64_t	bytes;		///< Taille cumulée des fichiers.
+		double		recordNs;	///< Temps des parties enregistrées (écriture comprise).
+		double		replayNs;	///< Temps des relectures.
+		uint64_t	mismatches;	///< Relectures dont le résultat diffère.
+	};
+
+	/**
+	 * @brief Joue une partie pilotée en l'enregistrant dans `path`.
+	 *
+	 * @return Ticks joués.
+	 */
+	uint64_t recordGame(const std::string& path, int size, bool obstacles, uint64_t seed, uint64_t maxTicks)
+	{
+		GameState state(size, size, obstacles, seed);
+		ReplayHeader header = { size, size, obstacles, seed, 10, GameState::SCORE_LIMIT };
+		ReplayWriter writer(header);
+		uint64_t tick = 0;
+
+		for (; tick < maxTicks && !state.isFinished(); ++tick)
+		{
+			Input input = steerToFood(state);
+			if (state.queueDirection(input))
+				writer.record(tick, input);
+			state.update();
+		}
+		writer.save(path, tick, state);
+		return tick;
+	}
+
+	/**
+	 * @brief Enregistre puis rejoue `games` parties sur un plateau carré.
+	 */
+	ReplayTotals benchBoard(const std::string& path, int size, bool obstacles, uint64_t games)
+	{
+		ReplayTotals totals = { 0, 0, 0, 0, 0, 0, 0 };
+
+		for (uint64_t seed = 1; seed <= games; ++seed)
+		{
+			BenchClock::time_point start = BenchClock::now();
+			totals.ticks += recordGame(path, size, obstacles, seed, 1000000);
+			totals.recordNs += elapsedNs(start);
+
+			start = BenchClock::now();
+			ReplayReader reader(path);
+			ReplayReport report = playReplay(reader);
+			totals.replayNs += elapsedNs(start);
+
+			++totals.games;
+			totals.records += report.records;
+			totals.bytes += reader.getFileSize();
+			if (!report.matches)
+				++totals.mismatches;
+		}
+		return totals;
+	}
+}
+
+/**
+ * @brief Taille des enregistrements et débit de la relecture, par plateau.
+ */
+void benchReplay()
+{
+	struct Board
+	{
+		int			size;
+		bool		obstacles;
+		uint64_t	games;
+	};
+	const Board boards[] = { { 30, false, 200 }, { 100, true, 100 }, { 1000, true, 5 } };
+
+	char path[] = "/tmp/nibbler_replay_XXXXXX";
+	int fd = mkstemp(path);
+	if (fd < 0)
+		throw std::runtime_error("Failed to create temporary file");
+	close(fd);
+
+	uint64_t mismatches = 0;
+	std::cout << "bench,board,obstacles,games,ticks,records,record_bytes,file_bytes_per_game,"
+	          << "record_ns_per_tick,replay_ns_per_tick,mismatches\n";
+	for (const Board& board : boards)
+	{
+		ReplayTotals totals = benchBoard(path, board.size, board.obstacles, board.games);
+		double records = static_cast<double>(totals.records);
+		double ticks = static_cast<double>(totals.ticks);
+		std::cout << "replay," << board.size << "x" << board.size << "," << (board.obstacles ? "yes" : "no")
+		          << "," << totals.games << "," << totals.ticks << "," << totals.records << ","
+		          << (records > 0 ? (totals.bytes - totals.games * REPLAY_HEADER_SIZE) / records : 0) << ","
+		          << static_cast<double>(totals.bytes) / totals.games << ","
+		          << (ticks > 0 ? totals.recordNs / ticks : 0) << ","
+		          << (ticks > 0 ? totals.replayNs / ticks : 0) << "," << totals.mismatches << "\n";
+		mismatches += totals.mismatches;
+	}
+	std::remove(path);
+
+	if (mismatches > 0)
+	{
+		std::cerr << "replay: " << mismatches << " replays did not reproduce the recorded game" << std::endl;
+		std::exit(1);
+	}
+}
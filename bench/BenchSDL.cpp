@@ -0,0 +1,132 @@
+/**
+ * @file BenchSDL.cpp
+ * @brief Comparaison du temps par frame du rendu SDL, case par case ou groupé.
+ *
+ * Dessine un plateau de 100x100 presque rempli par le serpent avec le
+ * renderer logiciel de SDL (dans une surface en mémoire, sans fenêtre) :
+ * - « per_rect » : l'ancien rendu, un SDL_RenderFillRect() par case et les
+ *   obstacles redessinés à chaque frame ;
+ * - « batched » : le BoardRenderer de la GUI SDL (fond pré-rendu dans une
+ *   texture, un SDL_RenderFillRects() par couleur).
+ * Les deux images doivent être identiques.
+ *
+ * Compilé uniquement par `make sdl`, qui définit NIBBLER_BENCH_SDL.
+ */
+
+#include "Bench.hpp"
+#include "../core/Frame.hpp"
+#include "../core/GameState.hpp"
+#include "../gui_sdl/BoardRenderer.hpp"
+#include "../includes/Interpolation.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	/**
+	 * @brief Ancien rendu de GuiSDL : un appel par case.
+	 */
+	void drawPerRect(SDL_Renderer* renderer, const Frame& state, float alpha)
+	{
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+		SDL_RenderClear(renderer);
+
+		const Snake& snake = state.getSnake();
+		for (size_t i = 0; i < snake.getLength(); ++i)
+		{
+			if (i == 0)
+				SDL_SetRenderDrawColor(renderer, 0, 0, 200, 255);
+			else if (i == 1)
+				SDL_SetRenderDrawColor(renderer, 0, 200, 0, 255);
+			PointF p = interpolateSegment(snake, i, alpha);
+			SDL_Rect rect = { static_cast<int>(p.x * 20.0f + 0.5f), static_cast<int>(p.y * 20.0f + 0.5f), 20, 20 };
+			SDL_RenderFillRect(renderer, &rect);
+		}
+
+		SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+		Point food = state.getFood();
+		SDL_Rect foodRect = { food.x * 20, food.y * 20, 20, 20 };
+		SDL_RenderFillRect(renderer, &foodRect);
+
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+		for (int i = 0; i < state.getScore() / 10; ++i)
+		{
+			SDL_Rect block = { 10 + i * 25, 10, 20, 20 };
+			SDL_RenderFillRect(renderer, &block);
+		}
+
+		SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
+		for (const Point& p : state.getObstacles())
+		{
+			SDL_Rect rect = { p.x * 20, p.y * 20, 20, 20 };
+			SDL_RenderFillRect(renderer, &rect);
+		}
+	}
+
+	/**
+	 * @brief Temps moyen d'un frame, en millisecondes.
+	 */
+	template <typename Draw>
+	double timeFrames(int frames, Draw draw)
+	{
+		BenchClock::time_point start = BenchClock::now();
+		for (int i = 0; i < frames; ++i)
+			draw(static_cast<float>(i % 10) / 10.0f);
+		return elapsedNs(start) / frames / 1e6;
+	}
+}
+
+/**
+ * @brief Compare les deux rendus sur un plateau de 100x100 avec un serpent très long.
+ */
+void benchSDL()
+{
+	const int size = 100;
+	const int frames = 100;
+	const int pixels = size * BoardRenderer::CELL_SIZE;
+
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, pixels, pixels, 32, SDL_PIXELFORMAT_RGBA8888);
+	if (!surface)
+		throw std::runtime_error(std::string("SDL_CreateRGBSurfaceWithFormat failed: ") + SDL_GetError());
+	SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+	if (!renderer)
+		throw std::runtime_error(std::string("SDL_CreateSoftwareRenderer failed: ") + SDL_GetError());
+
+	GameState state(size, size, true, makeLongSnake(9000, size, size), 1);
+	for (int i = 0; i < 3; ++i)
+		state.increaseScore(10);
+	Frame frame;
+	frame.capture(state, 0, 0);
+
+	BoardRenderer board;
+	board.init(renderer, size, size);
+
+	size_t bytes = static_cast<size_t>(surface->pitch) * surface->h;
+	std::vector<unsigned char> reference(bytes);
+
+	double perRectMs = timeFrames(frames, [&](float alpha) { drawPerRect(renderer, frame, alpha); });
+	drawPerRect(renderer, frame, 1.0f);
+	std::memcpy(reference.data(), surface->pixels, bytes);
+
+	double batchedMs = timeFrames(frames, [&](float alpha) { board.draw(frame, alpha); });
+	board.draw(frame, 1.0f);
+	bool same = std::memcmp(reference.data(), surface->pixels, bytes) == 0;
+
+	std::cout << "bench,board,snake,obstacles,mode,ms_per_frame,same_image\n";
+	std::cout << "sdl," << size << "x" << size << "," << frame.getSnake().getLength() << ","
+	          << frame.getObstacles().size() << ",per_rect," << perRectMs << ",-\n";
+	std::cout << "sdl," << size << "x" << size << "," << frame.getSnake().getLength() << ","
+	          << frame.getObstacles().size() << ",batched," << batchedMs << "," << (same ? "yes" : "no") << "\n";
+
+	board.release();
+	SDL_DestroyRenderer(renderer);
+	SDL_FreeSurface(surface);
+	if (!same)
+	{
+		std::cerr << "sdl: batched rendering differs from per-rect rendering" << std::endl;
+		std::exit(1);
+	}
+}
@@ -0,0 +1,118 @@
+/**
+ * @file BenchSnapshot.cpp
+ * @brief Benchmark et vérification des sauvegardes binaires de GameState.
+ *
+ * Pour des plateaux de 30x30 à 10000x10000, joue une partie pilotée puis
+ * la sauvegarde, la restaure (fichier projeté en mémoire) et sauvegarde la
+ * partie restaurée : les deux fichiers doivent être identiques octet pour
+ * octet. Les deux parties doivent ensuite avoir la même empreinte après
+ * les mêmes ticks, tout comme une copie (constructeur de copie).
+ */
+
+#include "Bench.hpp"
+#include "../core/GameState.hpp"
+#include "../core/MappedFile.hpp"
+#include "../core/Snapshot.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+	/**
+	 * @brief Crée un fichier temporaire vide et renvoie son chemin.
+	 */
+	std::string temporaryPath()
+	{
+		char path[] = "/tmp/nibbler_snapshot_XXXXXX";
+		int fd = mkstemp(path);
+		if (fd < 0)
+			throw std::runtime_error("Failed to create temporary file");
+		close(fd);
+		return path;
+	}
+
+	/**
+	 * @brief Indique si deux fichiers ont exactement le même contenu.
+	 */
+	bool sameFiles(const std::string& a, const std::string& b)
+	{
+		MappedFile first(a);
+		MappedFile second(b);
+		return first.size() == second.size()
+			&& std::memcmp(first.data(), second.data(), first.size()) == 0;
+	}
+
+	/**
+	 * @brief Joue `ticks` ticks pilotés.
+	 */
+	void play(GameState& state, int ticks)
+	{
+		for (int i = 0; i < ticks && !state.isFinished(); ++i)
+		{
+			state.queueDirection(steerToFood(state));
+			state.update();
+		}
+	}
+}
+
+/**
+ * @brief Temps de sauvegarde et de restauration, et vérification de l'aller-retour.
+ */
+void benchSnapshot()
+{
+	const int sizes[] = { 30, 100, 1000, 10000 };
+	std::string first = temporaryPath();
+	std::string second = temporaryPath();
+	bool allMatch = true;
+
+	std::cout << "bench,board,snake_length,file_bytes,save_ms,load_ms,save_gb_per_s,load_gb_per_s,"
+	          << "identical,same_future,copy_matches\n";
+	for (int size : sizes)
+	{
+		GameState state(size, size, true, 42);
+		play(state, size < 100 ? 20 : 2000);
+		// Un virage en attente et le menu d'aide ouvert font partie de l'état
+		state.queueDirection(state.getSnake().getDirection() == Direction::UP ? Input::LEFT : Input::UP);
+		state.toggleHelpMenu();
+
+		BenchClock::time_point start = BenchClock::now();
+		saveSnapshot(state, first);
+		double saveNs = elapsedNs(start);
+
+		start = BenchClock::now();
+		GameState loaded = loadSnapshot(first);
+		double loadNs = elapsedNs(start);
+
+		saveSnapshot(loaded, second);
+		bool identical = sameFiles(first, second) && loaded.hash() == state.hash();
+		size_t bytes = MappedFile(first).size();
+
+		state.toggleHelpMenu();
+		loaded.toggleHelpMenu();
+		play(state, 500);
+		play(loaded, 500);
+		bool sameFuture = loaded.hash() == state.hash();
+
+		bool copyMatches = GameState(state).hash() == state.hash();
+
+		std::cout << "snapshot," << size << "x" << size << "," << state.getSnake().getLength() << ","
+		          << bytes << "," << saveNs / 1e6 << "," << loadNs / 1e6 << ","
+		          << bytes / saveNs << "," << bytes / loadNs << ","
+		          << (identical ? "yes" : "no") << "," << (sameFuture ? "yes" : "no") << ","
+		          << (copyMatches ? "yes" : "no") << "\n";
+		allMatch = allMatch && identical && sameFuture && copyMatches;
+	}
+	std::remove(first.c_str());
+	std::remove(second.c_str());
+
+	if (!allMatch)
+	{
+		std::cerr << "snapshot: a restored or copied game differs from the original" << std::endl;
+		std::exit(1);
+	}
+}
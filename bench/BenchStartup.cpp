@@ -0,0 +1,52 @@
+/**
+ * @file BenchStartup.cpp
+ * @brief Benchmark du démarrage d'une partie avec obstacles selon la taille du plateau.
+ *
+ * Mesure la construction complète d'un GameState (grille, serpent, nourriture,
+ * obstacles) puis le tirage des obstacles seul, en séquentiel et sur tous les
+ * cœurs disponibles. Vérifie au passage que le tirage ne dépend pas du nombre
+ * de threads.
+ */
+
+#include "Bench.hpp"
+#include "../core/GameState.hpp"
+#include "../core/ObstacleGenerator.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+/**
+ * @brief Mesure le temps de démarrage pour des plateaux de 100x100 à 4000x4000.
+ */
+void benchStartup()
+{
+	const int sizes[] = { 100, 500, 1000, 2000, 4000 };
+	unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+	std::cout << "bench,size,obstacles,ms_gamestate,ms_sample_1t,ms_sample_" << cores << "t,deterministic\n";
+	for (int size : sizes)
+	{
+		BenchClock::time_point start = BenchClock::now();
+		GameState state(size, size, true, 42);
+		double stateMs = elapsedNs(start) / 1e6;
+
+		Grid grid(size, size);
+		size_t count = static_cast<size_t>(size) * size / 100;
+
+		start = BenchClock::now();
+		std::vector<Point> sequential = sampleObstacles(grid, count, 42, 1);
+		double sequentialMs = elapsedNs(start) / 1e6;
+
+		start = BenchClock::now();
+		std::vector<Point> parallel = sampleObstacles(grid, count, 42, cores);
+		double parallelMs = elapsedNs(start) / 1e6;
+
+		bool same = sequential.size() == parallel.size();
+		for (size_t i = 0; same && i < sequential.size(); ++i)
+			same = sequential[i].x == parallel[i].x && sequential[i].y == parallel[i].y;
+
+		std::cout << "startup," << size << "," << state.getObstacles().size() << ","
+		          << stateMs << "," << sequentialMs << "," << parallelMs << ","
+		          << (same ? "yes" : "no") << "\n";
+	}
+}
@@ -0,0 +1,223 @@
+/**
+ * @file BenchSwitch.cpp
+ * @brief Benchmark du changement de GUI à chaud par le GuiManager.
+ *
+ * Alterne 5 000 fois la GUI ncurses et la GUI nulle, soit 10 000
+ * changements : chacun ferme réellement la GUI courante (cleanup(),
+ * destroyGui(), restauration du terminal) puis crée et initialise l'autre.
+ * ncurses s'ouvre dans un pseudo terminal dont l'entrée et la sortie
+ * remplacent celles du processus le temps du benchmark : le terminal de
+ * l'utilisateur n'est pas touché et l'affichage est lu puis jeté. Le benchmark donne la latence de chaque sens de
+ * changement et vérifie que la mémoire résidente ne grandit pas : les
+ * bibliothèques restent chargées et chaque GUI est détruite par la
+ * bibliothèque qui l'a créée.
+ *
+ * Nécessite libgui_ncurses.so et libgui_null.so (`make -C gui_ncurses` et
+ * `make -C gui_null`) dans le dossier courant ou son parent.
+ */
+
+#include "Bench.hpp"
+#include "../core/GuiManager.hpp"
+#include "../core/Histogram.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+	/**
+	 * @brief Pic de mémoire résidente du processus, en kilo-octets.
+	 */
+	long maxRssKb()
+	{
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+		return usage.ru_maxrss / 1024;
+#else
+		return usage.ru_maxrss;
+#endif
+	}
+
+	/**
+	 * @class PseudoTerminal
+	 * @brief Pseudo terminal branché sur l'entrée et la sortie standard le temps de sa vie.
+	 *
+	 * Un thread lit en continu le côté maître : sans lecteur, le tampon du
+	 * terminal se remplirait et bloquerait les écritures de ncurses.
+	 */
+	class PseudoTerminal
+	{
+		public:
+			/**
+			 * @brief Ouvre le pseudo terminal et y redirige l'entrée et la sortie standard.
+			 *
+			 * @param columns Largeur du terminal.
+			 * @param rows Hauteur du terminal.
+			 * @throw std::runtime_error si le pseudo terminal ne peut être ouvert.
+			 */
+			PseudoTerminal(int columns, int rows)
+				: _master(-1), _slave(-1), _stdin(-1), _stdout(-1), _stop(false)
+			{
+				_master = posix_openpt(O_RDWR | O_NOCTTY);
+				if (_master < 0 || grantpt(_master) != 0 || unlockpt(_master) != 0)
+				{
+					closeAll();
+					throw std::runtime_error("Failed to open a pseudo terminal");
+				}
+				_slave = open(ptsname(_master), O_RDWR | O_NOCTTY);
+				struct winsize size = {};
+				size.ws_col = static_cast<unsigned short>(columns);
+				size.ws_row = static_cast<unsigned short>(rows);
+				if (_slave < 0 || ioctl(_slave, TIOCSWINSZ, &size) != 0)
+				{
+					closeAll();
+					throw std::runtime_error("Failed to open a pseudo terminal");
+				}
+
+				std::cout.flush();
+				std::fflush(stdout);
+				_stdin = dup(STDIN_FILENO);
+				_stdout = dup(STDOUT_FILENO);
+				dup2(_slave, STDIN_FILENO);
+				dup2(_slave, STDOUT_FILENO);
+				_drain = std::thread([this]()
+				{
+					char buffer[4096];
+					struct pollfd master = { _master, POLLIN, 0 };
+					while (!_stop)
+						if (poll(&master, 1, 20) > 0 && read(_master, buffer, sizeof(buffer)) <= 0)
+							break;
+				});
+			}
+
+			PseudoTerminal(const PseudoTerminal&) = delete;
+			PseudoTerminal& operator=(const PseudoTerminal&) = delete;
+
+			/**
+			 * @brief Rend l'entrée et la sortie standard d'origine puis ferme le pseudo terminal.
+			 */
+			~PseudoTerminal()
+			{
+				std::fflush(stdout);
+				dup2(_stdin, STDIN_FILENO);
+				dup2(_stdout, STDOUT_FILENO);
+				_stop = true;
+				_drain.join();
+				closeAll();
+			}
+
+		private:
+			/**
+			 * @brief Ferme les descripteurs ouverts.
+			 */
+			void closeAll()
+			{
+				for (int fd : { _stdin, _stdout, _slave, _master })
+					if (fd >= 0)
+						close(fd);
+			}
+
+			int					_master;	///< Côté maître, lu par le thread.
+			int					_slave;		///< Côté esclave, vu comme un terminal par ncurses.
+			int					_stdin;		///< Entrée standard d'origine.
+			int					_stdout;	///< Sortie standard d'origine.
+			std::atomic<bool>	_stop;		///< Arrête le thread de lecture.
+			std::thread			_drain;		///< Lit et jette l'affichage.
+	};
+
+	/**
+	 * @brief Ouvre une GUI à la place de la courante.
+	 *
+	 * @return Durée du changement en nanosecondes.
+	 */
+	double timedOpen(GuiManager& guis, const char* name)
+	{
+		BenchClock::time_point start = BenchClock::now();
+		guis.open(name, 30, 30);
+		return elapsedNs(start);
+	}
+}
+
+/**
+ * @brief Mesure le premier chargement de chaque GUI puis 5 000 allers-retours ncurses / null.
+ */
+void benchSwitch()
+{
+	const int cycles = 5000;
+	const int warmup = 200;
+	const long maxGrowthKb = 256;
+
+	const char* directory = ".";
+	{
+		GuiManager probe(".");
+		if (!probe.isAvailable("null") || !probe.isAvailable("ncurses"))
+			directory = "..";
+	}
+	{
+		GuiManager probe(directory);
+		if (!probe.isAvailable("null") || !probe.isAvailable("ncurses"))
+		{
+			std::cerr << "switch: libgui_ncurses.so or libgui_null.so not found"
+			          << " (run make -C gui_ncurses and make -C gui_null)" << std::endl;
+			std::exit(1);
+		}
+	}
+
+	setenv("TERM", "xterm-256color", 1);
+	double firstNcursesNs = 0;
+	double firstNullNs = 0;
+	Histogram toNcurses;
+	Histogram toNull;
+	long rssBefore = 0;
+	long rssAfter = 0;
+	try
+	{
+		PseudoTerminal terminal(120, 60);
+		// Construit dans le pseudo terminal : c'est lui qu'il restaure après chaque fermeture
+		GuiManager guis(directory);
+
+		firstNcursesNs = timedOpen(guis, "ncurses");
+		firstNullNs = timedOpen(guis, "null");
+		for (int i = 0; i < warmup; ++i)
+		{
+			guis.open("ncurses", 30, 30);
+			guis.open("null", 30, 30);
+		}
+		rssBefore = maxRssKb();
+
+		for (int i = 0; i < cycles; ++i)
+		{
+			toNcurses.record(static_cast<uint64_t>(timedOpen(guis, "ncurses")));
+			toNull.record(static_cast<uint64_t>(timedOpen(guis, "null")));
+		}
+		rssAfter = maxRssKb();
+		guis.close();
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cerr << "switch: " << e.what() << std::endl;
+		std::exit(1);
+	}
+
+	std::cout << "bench,cycles,us_first_ncurses,us_first_null,to_ncurses_p50_us,to_ncurses_p99_us,"
+	          << "to_null_p50_us,to_null_p99_us,rss_kb_before,rss_kb_after\n";
+	std::cout << "switch," << cycles << "," << firstNcursesNs / 1e3 << "," << firstNullNs / 1e3 << ","
+	          << toNcurses.percentile(50) / 1e3 << "," << toNcurses.percentile(99) / 1e3 << ","
+	          << toNull.percentile(50) / 1e3 << "," << toNull.percentile(99) / 1e3 << ","
+	          << rssBefore << "," << rssAfter << "\n";
+	if (rssAfter - rssBefore > maxGrowthKb)
+	{
+		std::cerr << "switch: resident memory grew by " << (rssAfter - rssBefore)
+		          << " kB over " << cycles << " ncurses/null cycles" << std::endl;
+		std::exit(1);
+	}
+}
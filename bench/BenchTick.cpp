@@ -0,0 +1,123 @@
+/**
+ * @file BenchTick.cpp
+ * @brief Benchmark du coût d'un tick selon la longueur du serpent.
+ *
+ * Compare le coût de GameState::update(), qui résout les collisions avec la
+ * grille d'occupation, au parcours linéaire du corps par Snake::checkCollision().
+ * Le temps par tick doit rester constant de 4 à 100 000 segments.
+ */
+
+#include "Bench.hpp"
+#include "../core/GameState.hpp"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief Construit un serpent en serpentin de la longueur demandée.
+ *
+ * Le serpent part du coin haut gauche, parcourt des lignes entières de
+ * gauche à droite puis de droite à gauche en descendant, et finit orienté
+ * vers le bas pour avoir devant lui tout le reste du plateau libre.
+ *
+ * @param length Longueur voulue (au moins 4).
+ * @param width Largeur du plateau sur lequel le serpent sera posé.
+ * @param height Hauteur du plateau (dimensionne le tampon du serpent).
+ * @return Le serpent construit.
+ */
+Snake makeLongSnake(int length, int width, int height)
+{
+	Snake snake(4, 1, static_cast<size_t>(width) * height);
+	bool right = true;
+	int x = 4;
+
+	for (int size = 4; size < length; ++size)
+	{
+		if ((right && x == width - 3) || (!right && x == 4))
+		{
+			snake.setDirection(Direction::DOWN);
+			snake.grow();
+			right = !right;
+			snake.setDirection(right ? Direction::RIGHT : Direction::LEFT);
+			continue;
+		}
+		snake.grow();
+		x += right ? 1 : -1;
+	}
+	snake.setDirection(Direction::DOWN);
+	return snake;
+}
+
+/**
+ * @brief Se dirige vers la nourriture par une case libre, sinon continue tout droit.
+ *
+ * Pilote simple qui donne aux benchmarks des parties longues et reproductibles.
+ *
+ * @param state Partie en cours.
+ * @return La direction choisie, ou NONE si aucune case voisine n'est libre.
+ */
+Input steerToFood(const GameState& state)
+{
+	static const Input inputs[] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };
+	static const int dx[] = { 0, 0, -1, 1 };
+	static const int dy[] = { -1, 1, 0, 0 };
+
+	const Grid& grid = state.getGrid();
+	const Point& head = state.getSnake().getHead();
+	const Point& food = state.getFood();
+	int current = static_cast<int>(state.getSnake().getDirection());
+	int best = -1;
+	int bestDistance = 0;
+
+	for (int d = 0; d < 4; ++d)
+	{
+		Point next(head.x + dx[d], head.y + dy[d]);
+		if (d == (current ^ 1) || !grid.contains(next))
+			continue;
+		Cell cell = grid.at(next);
+		if (cell != Cell::EMPTY && cell != Cell::FOOD)
+			continue;
+		int distance = std::abs(food.x - next.x) + std::abs(food.y - next.y);
+		if (best < 0 || distance < bestDistance)
+		{
+			best = d;
+			bestDistance = distance;
+		}
+	}
+	return best < 0 ? Input::NONE : inputs[best];
+}
+
+/**
+ * @brief Mesure le temps par tick pour des longueurs de 4 à 100 000.
+ */
+void benchTick()
+{
+	const int lengths[] = { 4, 100, 1000, 10000, 100000 };
+	const int ticks = 2000;
+	const int width = 1010;
+
+	std::cout << "bench,length,ns_per_tick,ns_per_body_scan\n";
+	for (int length : lengths)
+	{
+		int rows = length / (width - 6) + 2;
+		int height = rows + ticks + 4;
+		GameState state(width, height, false, makeLongSnake(length, width, height), 1);
+
+		BenchClock::time_point start = BenchClock::now();
+		int done = 0;
+		for (; done < ticks && !state.isFinished(); ++done)
+			state.update();
+		double tickNs = elapsedNs(start) / done;
+
+		const Snake& snake = state.getSnake();
+		Point probe(width / 2, rows + ticks + 2);
+		int hits = 0;
+		start = BenchClock::now();
+		for (int i = 0; i < ticks; ++i)
+			hits += snake.checkCollision(probe, true);
+		double scanNs = elapsedNs(start) / ticks;
+
+		std::cout << "tick," << snake.getLength() << ","
+		          << tickNs << "," << scanNs << "\n";
+		g_benchSink += hits;
+	}
+}
@@ -0,0 +1,60 @@
+/**
+ * @file main.cpp
+ * @brief Point d'entrée du binaire de benchmarks.
+ *
+ * Usage : ./nibbler_bench [nom...]
+ * Sans argument, tous les benchmarks sont exécutés. Les benchmarks « opengl »
+ * et « sdl » ne sont disponibles que dans les binaires construits par
+ * `make gl` et `make sdl`.
+ */
+
+#include "Bench.hpp"
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Association entre un nom de benchmark et sa fonction.
+ */
+struct BenchEntry
+{
+	const char*	name;
+	void		(*run)();
+};
+
+volatile long g_benchSink = 0;
+
+static const BenchEntry g_benches[] = {
+	{ "tick", benchTick },
+	{ "core", benchCore },
+	{ "startup", benchStartup },
+	{ "batch", benchBatch },
+	{ "env", benchEnv },
+	{ "matches", benchMatches },
+	{ "ncurses", benchNcurses },
+	{ "replay", benchReplay },
+	{ "snapshot", benchSnapshot },
+	{ "autopilot", benchAutopilot },
+	{ "hamilton", benchHamilton },
+	{ "mcts", benchMcts },
+	{ "switch", benchSwitch },
+#ifdef NIBBLER_BENCH_GL
+	{ "opengl", benchOpenGL },
+#endif
+#ifdef NIBBLER_BENCH_SDL
+	{ "sdl", benchSDL },
+#endif
+};
+
+int main(int argc, char** argv)
+{
+	for (const BenchEntry& entry : g_benches)
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc; ++i)
+			if (std::strcmp(argv[i], entry.name) == 0)
+				selected = true;
+		if (selected)
+			entry.run();
+	}
+	return 0;
+}
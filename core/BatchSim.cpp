@@ -0,0 +1,384 @@
+/**
+ * @file BatchSim.cpp
+ * @brief Implémentation de la simulation par lots en structure de tableaux.
+ *
+ * Le noyau step() se fait en deux passes : la première, sans branche ni
+ * dépendance entre parties, applique les directions et calcule pour chaque
+ * partie la case visée par la tête et la case de la queue ; la seconde
+ * applique les règles (collisions par plan de bits, croissance, nourriture).
+ * Les cas rares (nourriture mangée) suivent exactement GameState pour que
+ * les tirages aléatoires restent identiques.
+ */
+
+#include "BatchSim.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+const uint8_t BatchSim::KEEP_DIRECTION;
+const uint32_t BatchSim::NO_CELL;
+
+namespace
+{
+	const int32_t DX[] = { 0, 0, -1, 1 };	///< Déplacement horizontal par Direction.
+	const int32_t DY[] = { -1, 1, 0, 0 };	///< Déplacement vertical par Direction.
+}
+
+/**
+ * @brief Construit un lot de parties vides (à initialiser avec load()).
+ *
+ * @param width Largeur commune des plateaux.
+ * @param height Hauteur commune des plateaux.
+ * @param count Nombre de parties.
+ */
+BatchSim::BatchSim(int width, int height, size_t count)
+	: width(width), height(height), games(count),
+	  area(static_cast<size_t>(width) * height), ringMask(0), words(0)
+{
+	size_t capacity = 4;
+	while (capacity < area)
+		capacity <<= 1;
+	ringMask = capacity - 1;
+	words = (area + 63) / 64;
+
+	headX.assign(games, 0);
+	headY.assign(games, 0);
+	direction.assign(games, static_cast<uint8_t>(Direction::RIGHT));
+	finished.assign(games, 1);
+	boardFull.assign(games, 0);
+	headSlot.assign(games, 0);
+	length.assign(games, 0);
+	score.assign(games, 0);
+	scoreLimit.assign(games, GameState::SCORE_LIMIT);
+	food.assign(games, NO_CELL);
+	rings.assign(games * capacity, 0);
+	blocked.assign(games * words, 0);
+	freeCells.assign(games * area, 0);
+	freeSlots.assign(games * area, NO_CELL);
+	freeCount.assign(games, 0);
+	rngState.assign(games * Rng::STATE_WORDS, 0);
+	tailCell.assign(games, 0);
+	nextCell.assign(games, 0);
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+BatchSim::~BatchSim() {}
+
+/**
+ * @brief Copie l'état complet d'une partie scalaire dans le lot.
+ *
+ * @param game Indice de la partie dans le lot.
+ * @param state Partie à importer, de même taille de plateau.
+ * @throw std::invalid_argument si la taille du plateau diffère.
+ */
+void BatchSim::load(size_t game, const GameState& state)
+{
+	const Grid& grid = state.getGrid();
+	if (grid.getWidth() != width || grid.getHeight() != height)
+		throw std::invalid_argument("BatchSim: board size mismatch");
+
+	const Snake& snake = state.getSnake();
+	uint32_t* ring = &rings[game * (ringMask + 1)];
+	for (size_t i = 0; i < snake.getLength(); ++i)
+	{
+		const Point& p = snake.getSegment(i);
+		ring[i] = static_cast<uint32_t>(p.y) * width + p.x;
+	}
+	headSlot[game] = 0;
+	length[game] = static_cast<uint32_t>(snake.getLength());
+	headX[game] = snake.getHead().x;
+	headY[game] = snake.getHead().y;
+	direction[game] = static_cast<uint8_t>(snake.getDirection());
+
+	std::fill(&blocked[game * words], &blocked[game * words] + words, 0);
+	for (int y = 0; y < height; ++y)
+	{
+		const Cell* row = grid.getRow(y);
+		for (int x = 0; x < width; ++x)
+			if (row[x] == Cell::WALL || row[x] == Cell::SNAKE || row[x] == Cell::OBSTACLE)
+				setBlocked(game, static_cast<uint32_t>(y) * width + x, true);
+	}
+
+	std::fill(&freeSlots[game * area], &freeSlots[game * area] + area, NO_CELL);
+	freeCount[game] = static_cast<uint32_t>(grid.getFreeCount());
+	for (uint32_t rank = 0; rank < freeCount[game]; ++rank)
+	{
+		Point p = grid.getFreeCell(rank);
+		uint32_t cell = static_cast<uint32_t>(p.y) * width + p.x;
+		freeCells[game * area + rank] = cell;
+		freeSlots[game * area + cell] = rank;
+	}
+
+	const Point& meal = state.getFood();
+	food[game] = state.isBoardFull() ? NO_CELL : static_cast<uint32_t>(meal.y) * width + meal.x;
+	score[game] = state.getScore();
+	scoreLimit[game] = state.getScoreLimit();
+	finished[game] = state.isFinished();
+	boardFull[game] = state.isBoardFull();
+	state.getRng().getState(&rngState[game * Rng::STATE_WORDS]);
+}
+
+/**
+ * @brief Fait avancer toutes les parties non terminées d'un tick.
+ *
+ * Équivaut, pour chaque partie, à GameState::setDirection() suivi de
+ * GameState::update().
+ *
+ * @param directions Une entrée par partie : une valeur de Direction, ou
+ *                   KEEP_DIRECTION pour garder la direction courante.
+ */
+void BatchSim::step(const uint8_t* directions)
+{
+	const size_t capacity = ringMask + 1;
+
+	// Passe 1 : directions, case visée et queue, sans branche.
+	for (size_t i = 0; i < games; ++i)
+	{
+		uint8_t current = direction[i];
+		uint8_t wanted = directions[i];
+		bool accept = !finished[i] && wanted < 4 && wanted != (current ^ 1);
+		uint8_t d = accept ? wanted : current;
+
+		direction[i] = d;
+		nextCell[i] = static_cast<uint32_t>(headY[i] + DY[d]) * width
+			+ static_cast<uint32_t>(headX[i] + DX[d]);
+		tailCell[i] = rings[i * capacity + ((headSlot[i] + length[i] - 1) & ringMask)];
+	}
+
+	// Passe 2 : application des règles, partie par partie.
+	for (size_t i = 0; i < games; ++i)
+	{
+		if (finished[i])
+			continue;
+
+		uint32_t* ring = &rings[i * capacity];
+		uint32_t cell = nextCell[i];
+
+		headSlot[i] = (headSlot[i] - 1) & ringMask;
+		ring[headSlot[i]] = cell;
+		headX[i] += DX[direction[i]];
+		headY[i] += DY[direction[i]];
+
+		if (cell == food[i])
+		{
+			// La nourriture n'est jamais bloquante et la queue reste en place
+			++length[i];
+			occupyHead(i, cell);
+			score[i] += 10;
+			generateFood(i);
+		}
+		else
+		{
+			setBlocked(i, tailCell[i], false);
+			addFree(i, tailCell[i]);
+			if (!occupyHead(i, cell))
+				continue;
+		}
+		if (scoreLimit[i] > 0 && score[i] >= scoreLimit[i])
+			finished[i] = 1;
+	}
+}
+
+/**
+ * @brief Fait entrer la tête dans une case, comme GameState::occupyHead().
+ *
+ * @return false si la case est bloquante (la partie est alors terminée).
+ */
+bool BatchSim::occupyHead(size_t game, uint32_t cell)
+{
+	if (isBlocked(game, cell))
+	{
+		finished[game] = 1;
+		return false;
+	}
+	if (cell != food[game])
+		removeFree(game, cell);
+	setBlocked(game, cell, true);
+	return true;
+}
+
+/**
+ * @brief Place la nourriture sur une case libre tirée par le générateur de la partie.
+ */
+void BatchSim::generateFood(size_t game)
+{
+	if (freeCount[game] == 0)
+	{
+		food[game] = NO_CELL;
+		boardFull[game] = 1;
+		finished[game] = 1;
+		return;
+	}
+
+	Rng rng;
+	rng.setState(&rngState[game * Rng::STATE_WORDS]);
+	food[game] = freeCells[game * area + rng.bounded(freeCount[game])];
+	rng.getState(&rngState[game * Rng::STATE_WORDS]);
+	removeFree(game, food[game]);
+}
+
+/**
+ * @brief Indique si une case est occupée par un mur, un obstacle ou le serpent.
+ */
+bool BatchSim::isBlocked(size_t game, uint32_t cell) const
+{
+	return (blocked[game * words + cell / 64] >> (cell % 64)) & 1;
+}
+
+/**
+ * @brief Marque ou libère une case dans le plan de bits d'une partie.
+ */
+void BatchSim::setBlocked(size_t game, uint32_t cell, bool value)
+{
+	uint64_t bit = 1ull << (cell % 64);
+	uint64_t& word = blocked[game * words + cell / 64];
+	word = value ? (word | bit) : (word & ~bit);
+}
+
+/**
+ * @brief Ajoute une case à l'ensemble des cases libres (comme Grid).
+ */
+void BatchSim::addFree(size_t game, uint32_t cell)
+{
+	size_t base = game * area;
+	freeSlots[base + cell] = freeCount[game];
+	freeCells[base + freeCount[game]++] = cell;
+}
+
+/**
+ * @brief Retire une case de l'ensemble des cases libres par échange avec la dernière (comme Grid).
+ */
+void BatchSim::removeFree(size_t game, uint32_t cell)
+{
+	size_t base = game * area;
+	uint32_t slot = freeSlots[base + cell];
+	uint32_t last = freeCells[base + --freeCount[game]];
+
+	freeCells[base + slot] = last;
+	freeSlots[base + last] = slot;
+	freeSlots[base + cell] = NO_CELL;
+}
+
+/**
+ * @brief Convertit un indice de cellule en coordonnées.
+ */
+Point BatchSim::toPoint(uint32_t cell) const
+{
+	if (cell == NO_CELL)
+		return Point(-1, -1);
+	return Point(static_cast<int>(cell % width), static_cast<int>(cell / width));
+}
+
+/**
+ * @brief Nombre de parties du lot.
+ */
+size_t BatchSim::size() const
+{
+	return games;
+}
+
+/**
+ * @brief Nombre de parties encore en cours.
+ */
+size_t BatchSim::getAliveCount() const
+{
+	return static_cast<size_t>(std::count(finished.begin(), finished.end(), 0));
+}
+
+/**
+ * @brief Indique si une partie est terminée.
+ */
+bool BatchSim::isFinished(size_t game) const
+{
+	return finished[game];
+}
+
+/**
+ * @brief Indique si une partie s'est terminée faute de case libre.
+ */
+bool BatchSim::isBoardFull(size_t game) const
+{
+	return boardFull[game];
+}
+
+/**
+ * @brief Score d'une partie.
+ */
+int BatchSim::getScore(size_t game) const
+{
+	return score[game];
+}
+
+/**
+ * @brief Longueur du serpent d'une partie.
+ */
+size_t BatchSim::getLength(size_t game) const
+{
+	return length[game];
+}
+
+/**
+ * @brief Position de la tête d'une partie.
+ */
+Point BatchSim::getHead(size_t game) const
+{
+	return Point(headX[game], headY[game]);
+}
+
+/**
+ * @brief Position de la nourriture d'une partie ((-1, -1) si le plateau est plein).
+ */
+Point BatchSim::getFood(size_t game) const
+{
+	return toPoint(food[game]);
+}
+
+/**
+ * @brief Segment d'indice donné (0 pour la tête) du serpent d'une partie.
+ */
+Point BatchSim::getSegment(size_t game, size_t index) const
+{
+	return toPoint(rings[game * (ringMask + 1) + ((headSlot[game] + index) & ringMask)]);
+}
+
+/**
+ * @brief Direction courante du serpent d'une partie.
+ */
+Direction BatchSim::getDirection(size_t game) const
+{
+	return static_cast<Direction>(direction[game]);
+}
+
+/**
+ * @brief Compare une partie du lot à une partie scalaire.
+ *
+ * Vérifie l'état de fin, le score et le score limite, la direction, la
+ * nourriture, le nombre de cases libres et chaque segment du serpent.
+ *
+ * @return true si les deux parties sont identiques.
+ */
+bool BatchSim::matches(size_t game, const GameState& state) const
+{
+	const Snake& snake = state.getSnake();
+
+	if (static_cast<bool>(finished[game]) != state.isFinished()
+		|| static_cast<bool>(boardFull[game]) != state.isBoardFull()
+		|| score[game] != state.getScore()
+		|| scoreLimit[game] != state.getScoreLimit()
+		|| getDirection(game) != snake.getDirection()
+		|| length[game] != snake.getLength()
+		|| freeCount[game] != state.getGrid().getFreeCount())
+		return false;
+
+	Point meal = getFood(game);
+	if (!state.isBoardFull() && (meal.x != state.getFood().x || meal.y != state.getFood().y))
+		return false;
+	for (size_t i = 0; i < length[game]; ++i)
+	{
+		Point p = getSegment(game, i);
+		if (p.x != snake.getSegment(i).x || p.y != snake.getSegment(i).y)
+			return false;
+	}
+	return true;
+}
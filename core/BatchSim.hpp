@@ -0,0 +1,91 @@
+/**
+ * @file BatchSim.hpp
+ * @brief Déclaration de la classe BatchSim, simulation de nombreuses parties en parallèle.
+ *
+ * BatchSim fait avancer N parties indépendantes d'un tick à la fois avec
+ * exactement les mêmes règles que GameState::update(), mais en stockant
+ * chaque grandeur dans un tableau par champ (structure de tableaux) plutôt
+ * qu'un objet par partie. Le noyau de calcul parcourt ces tableaux de façon
+ * linéaire, ce qui le rend favorable au cache et à la vectorisation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameState.hpp"
+
+/**
+ * @class BatchSim
+ * @brief N parties de même taille de plateau, stockées en structure de tableaux.
+ *
+ * Pour chaque partie : coordonnées de la tête, direction, longueur, score,
+ * nourriture, corps en tampon circulaire de cellules, plan de bits des cases
+ * bloquantes (serpent, obstacle, mur), ensemble des cases libres et état du
+ * générateur. Les parties sont initialisées à partir de GameState (load())
+ * et suivent ensuite les mêmes tirages aléatoires : une partie du lot et son
+ * équivalent scalaire restent identiques tick après tick.
+ */
+class BatchSim
+{
+	public:
+		static const uint8_t KEEP_DIRECTION = 0xFF;	///< Entrée « ne pas changer de direction ».
+
+		BatchSim(int width, int height, size_t games);
+		BatchSim(const BatchSim&) = delete;
+		BatchSim& operator=(const BatchSim&) = delete;
+		~BatchSim();
+
+		void		load(size_t game, const GameState& state);
+		void		step(const uint8_t* directions);
+
+		size_t		size() const;
+		size_t		getAliveCount() const;
+		bool		isFinished(size_t game) const;
+		bool		isBoardFull(size_t game) const;
+		int			getScore(size_t game) const;
+		size_t		getLength(size_t game) const;
+		Point		getHead(size_t game) const;
+		Point		getFood(size_t game) const;
+		Point		getSegment(size_t game, size_t index) const;
+		Direction	getDirection(size_t game) const;
+		bool		matches(size_t game, const GameState& state) const;
+
+	private:
+		static const uint32_t NO_CELL = 0xFFFFFFFFu;	///< Cellule absente (nourriture sur plateau plein).
+
+		bool		isBlocked(size_t game, uint32_t cell) const;
+		void		setBlocked(size_t game, uint32_t cell, bool blocked);
+		void		addFree(size_t game, uint32_t cell);
+		void		removeFree(size_t game, uint32_t cell);
+		bool		occupyHead(size_t game, uint32_t cell);
+		void		generateFood(size_t game);
+		Point		toPoint(uint32_t cell) const;
+
+		int						width;		///< Largeur commune des plateaux.
+		int						height;		///< Hauteur commune des plateaux.
+		size_t					games;		///< Nombre de parties.
+		size_t					area;		///< Nombre de cases d'un plateau.
+		size_t					ringMask;	///< Capacité du tampon circulaire moins un.
+		size_t					words;		///< Mots de 64 bits par plan de bits.
+
+		std::vector<int32_t>	headX;		///< Abscisse de la tête.
+		std::vector<int32_t>	headY;		///< Ordonnée de la tête.
+		std::vector<uint8_t>	direction;	///< Direction courante (valeur de Direction).
+		std::vector<uint8_t>	finished;	///< Partie terminée.
+		std::vector<uint8_t>	boardFull;	///< Partie terminée faute de case libre.
+		std::vector<uint32_t>	headSlot;	///< Position de la tête dans le tampon circulaire.
+		std::vector<uint32_t>	length;		///< Nombre de segments.
+		std::vector<int32_t>	score;		///< Score.
+		std::vector<int32_t>	scoreLimit;	///< Score qui termine la partie (0 : aucun).
+		std::vector<uint32_t>	food;		///< Cellule de la nourriture.
+		std::vector<uint32_t>	rings;		///< Corps des serpents (cellules), un tampon par partie.
+		std::vector<uint64_t>	blocked;	///< Plans de bits des cases bloquantes.
+		std::vector<uint32_t>	freeCells;	///< Cases libres (tableau dense), par partie.
+		std::vector<uint32_t>	freeSlots;	///< Position de chaque case dans freeCells, par partie.
+		std::vector<uint32_t>	freeCount;	///< Nombre de cases libres.
+		std::vector<uint64_t>	rngState;	///< États des générateurs (Rng::STATE_WORDS mots par partie).
+		std::vector<uint32_t>	tailCell;	///< Tampon du noyau : queue avant le tick.
+		std::vector<uint32_t>	nextCell;	///< Tampon du noyau : case visée par la tête.
+};
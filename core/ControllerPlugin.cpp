@@ -0,0 +1,102 @@
+/**
+ * @file ControllerPlugin.cpp
+ * @brief Implémentation de la classe ControllerPlugin.
+ */
+
+#include "ControllerPlugin.hpp"
+#include "GameState.hpp"
+#include "../includes/InputQueue.hpp"
+#include <stdexcept>
+
+/**
+ * @brief Charge la bibliothèque et crée son contrôleur.
+ *
+ * Un chemin sans `/` désigne un fichier du dossier courant (dlopen()
+ * chercherait sinon dans les dossiers du système).
+ *
+ * @param path Chemin de la bibliothèque `libai_*.so`.
+ * @throw std::runtime_error si la bibliothèque, l'une de ses deux fonctions
+ * ou le contrôleur est introuvable.
+ */
+ControllerPlugin::ControllerPlugin(const std::string& path)
+	: _library(path.find('/') == std::string::npos ? "./" + path : path), _destroy(nullptr), _controller(nullptr)
+{
+	CreateControllerFunc create = reinterpret_cast<CreateControllerFunc>(_library.symbol("createController"));
+	_destroy = reinterpret_cast<DestroyControllerFunc>(_library.symbol("destroyController"));
+	_controller = create();
+	if (!_controller)
+		throw std::runtime_error("createController() failed in " + _library.getPath());
+}
+
+/**
+ * @brief Destructeur : détruit le contrôleur, puis décharge la bibliothèque.
+ */
+ControllerPlugin::~ControllerPlugin()
+{
+	if (_controller)
+		_destroy(_controller);
+}
+
+/**
+ * @brief Passe la vue de la partie au contrôleur externe et filtre sa réponse.
+ *
+ * @param game Partie en cours.
+ * @return La direction choisie, ou NONE (partie terminée, ou réponse autre qu'une direction).
+ */
+Input ControllerPlugin::nextInput(const GameState& game)
+{
+	if (game.isFinished())
+		return Input::NONE;
+
+	uint64_t start = InputQueue::now();
+	Input input = _controller->decide(viewOf(game));
+	_planNs.record(InputQueue::now() - start);
+	switch (input)
+	{
+		case Input::UP:
+		case Input::DOWN:
+		case Input::LEFT:
+		case Input::RIGHT:
+			return input;
+		default:
+			return Input::NONE;
+	}
+}
+
+/**
+ * @brief Chemin de la bibliothèque chargée.
+ */
+const std::string& ControllerPlugin::getPath() const
+{
+	return _library.getPath();
+}
+
+/**
+ * @brief Durée de chaque appel à decide(), en nanosecondes.
+ */
+const Histogram& ControllerPlugin::getPlanTimes() const
+{
+	return _planNs;
+}
+
+/**
+ * @brief Vue à plat d'une partie, sans copie (valide jusqu'à sa prochaine modification).
+ *
+ * @param game Partie en cours.
+ */
+BoardView ControllerPlugin::viewOf(const GameState& game)
+{
+	const Grid& grid = game.getGrid();
+	const Snake& snake = game.getSnake();
+	BoardView view;
+
+	view.width = grid.getWidth();
+	view.height = grid.getHeight();
+	view.cells = grid.getRow(0);
+	view.body = snake.getBody();
+	view.food = game.getFood();
+	view.direction = snake.getDirection();
+	view.score = game.getScore();
+	view.scoreLimit = game.getScoreLimit();
+	return view;
+}
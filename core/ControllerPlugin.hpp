@@ -0,0 +1,48 @@
+/**
+ * @file ControllerPlugin.hpp
+ * @brief Déclaration de la classe ControllerPlugin, contrôleur chargé depuis une bibliothèque `libai_*.so`.
+ */
+
+#pragma once
+
+#include "Histogram.hpp"
+#include "SharedLibrary.hpp"
+#include "../includes/BoardView.hpp"
+#include "../includes/IBoardController.hpp"
+#include "../includes/IController.hpp"
+#include <string>
+
+class GameState;
+
+/**
+ * @class ControllerPlugin
+ * @brief Charge une bibliothèque de contrôleur et la présente comme un IController.
+ *
+ * À chaque tick, la partie est passée au contrôleur externe sous forme de
+ * BoardView (des pointeurs vers la grille et le corps, construits en O(1)),
+ * et sa réponse est filtrée : seules les quatre directions et NONE passent.
+ * Le contrôleur est détruit par sa bibliothèque avant que celle-ci ne soit
+ * déchargée.
+ *
+ * Non copiable : possède la bibliothèque et le contrôleur.
+ */
+class ControllerPlugin : public IController
+{
+	public:
+		explicit ControllerPlugin(const std::string& path);
+		ControllerPlugin(const ControllerPlugin&) = delete;
+		ControllerPlugin& operator=(const ControllerPlugin&) = delete;
+		~ControllerPlugin();
+
+		Input				nextInput(const GameState& game) override;
+		const std::string&	getPath() const;
+		const Histogram&	getPlanTimes() const;
+
+		static BoardView	viewOf(const GameState& game);
+
+	private:
+		SharedLibrary			_library;		///< Bibliothèque chargée.
+		DestroyControllerFunc	_destroy;		///< destroyController() de la bibliothèque.
+		IBoardController*		_controller;	///< Contrôleur créé par la bibliothèque.
+		Histogram				_planNs;		///< Durée de chaque appel à decide().
+};
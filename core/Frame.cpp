@@ -0,0 +1,216 @@
+/**
+ * @file Frame.cpp
+ * @brief Implémentation de la classe Frame.
+ */
+
+#include "Frame.hpp"
+#include "GameState.hpp"
+
+/**
+ * @brief Constructeur par défaut : instantané vide, à remplir avec capture().
+ */
+Frame::Frame()
+	: food(), seed(0), score(0), finished(false), boardFull(false), won(false), helpMenuActive(false),
+	  tick(0), timeNs(0), sequence(0)
+{}
+
+/**
+ * @brief Constructeur de copie.
+ */
+Frame::Frame(const Frame& other)
+	: snake(other.snake), food(other.food), obstacles(other.obstacles), seed(other.seed),
+	  score(other.score),
+	  finished(other.finished), boardFull(other.boardFull), won(other.won), helpMenuActive(other.helpMenuActive),
+	  tick(other.tick), timeNs(other.timeNs), events(other.events), sequence(other.sequence)
+{}
+
+/**
+ * @brief Opérateur d'affectation.
+ */
+Frame& Frame::operator=(const Frame& other)
+{
+	if (this != &other)
+	{
+		snake = other.snake;
+		food = other.food;
+		obstacles = other.obstacles;
+		seed = other.seed;
+		score = other.score;
+		finished = other.finished;
+		boardFull = other.boardFull;
+		won = other.won;
+		helpMenuActive = other.helpMenuActive;
+		tick = other.tick;
+		timeNs = other.timeNs;
+		events = other.events;
+		sequence = other.sequence;
+	}
+	return *this;
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+Frame::~Frame() {}
+
+/**
+ * @brief Recopie dans ce Frame l'état visible d'une partie.
+ *
+ * Les obstacles ne font que s'ajouter au cours d'une partie, et sont
+ * déterminés par sa graine : ils ne sont recopiés que si la graine ou leur
+ * nombre a changé. Les événements de l'instantané sont effacés (voir
+ * setEvents()).
+ *
+ * @param state Partie à capturer.
+ * @param tickIndex Numéro du tick.
+ * @param captureNs Instant de la capture.
+ */
+void Frame::capture(const GameState& state, uint64_t tickIndex, uint64_t captureNs)
+{
+	snake = state.getSnake();
+	food = state.getFood();
+	if (seed != state.getSeed() || obstacles.size() != state.getObstacles().size())
+	{
+		obstacles = state.getObstacles();
+		seed = state.getSeed();
+	}
+	score = state.getScore();
+	finished = state.isFinished();
+	boardFull = state.isBoardFull();
+	won = state.isWon();
+	helpMenuActive = state.isHelpMenuActive();
+	tick = tickIndex;
+	timeNs = captureNs;
+	events.clear();
+	sequence = 0;
+}
+
+/**
+ * @brief Joint à l'instantané les changements depuis la publication précédente.
+ *
+ * @param changes Événements produits par la partie depuis l'instantané précédent.
+ * @param publication Numéro de publication de cet instantané (à partir de 1).
+ */
+void Frame::setEvents(const RenderEventList& changes, uint64_t publication)
+{
+	events = changes;
+	sequence = publication;
+}
+
+/**
+ * @brief Serpent au moment de la capture.
+ */
+const Snake& Frame::getSnake() const
+{
+	return snake;
+}
+
+/**
+ * @brief Position de la nourriture.
+ */
+const Point& Frame::getFood() const
+{
+	return food;
+}
+
+/**
+ * @brief Score.
+ */
+int Frame::getScore() const
+{
+	return score;
+}
+
+/**
+ * @brief Indique si la partie est terminée.
+ */
+bool Frame::isFinished() const
+{
+	return finished;
+}
+
+/**
+ * @brief Indique si la partie s'est terminée faute de case libre.
+ */
+bool Frame::isBoardFull() const
+{
+	return boardFull;
+}
+
+/**
+ * @brief Indique si la partie est gagnée (score limite atteint ou plateau rempli).
+ */
+bool Frame::isWon() const
+{
+	return won;
+}
+
+/**
+ * @brief Obstacles de la partie.
+ */
+const std::vector<Point>& Frame::getObstacles() const
+{
+	return obstacles;
+}
+
+/**
+ * @brief Graine de la partie capturée.
+ */
+uint64_t Frame::getSeed() const
+{
+	return seed;
+}
+
+/**
+ * @brief Indique si le menu d'aide est affiché.
+ */
+bool Frame::isHelpMenuActive() const
+{
+	return helpMenuActive;
+}
+
+/**
+ * @brief Numéro du tick capturé (0 pour l'état initial).
+ */
+uint64_t Frame::getTick() const
+{
+	return tick;
+}
+
+/**
+ * @brief Instant de la capture, en nanosecondes d'horloge monotone.
+ */
+uint64_t Frame::getTimeNs() const
+{
+	return timeNs;
+}
+
+/**
+ * @brief Changements visibles depuis l'instantané publié juste avant celui-ci.
+ */
+const RenderEventList& Frame::getEvents() const
+{
+	return events;
+}
+
+/**
+ * @brief Numéro de publication (0 si l'instantané ne porte pas d'événements).
+ */
+uint64_t Frame::getSequence() const
+{
+	return sequence;
+}
+
+/**
+ * @brief Indique si l'instantané a été publié juste après un autre.
+ *
+ * Si c'est le cas, appliquer getEvents() à l'affichage de l'instantané
+ * précédent donne l'affichage de celui-ci ; sinon (instantanés sautés,
+ * pas d'événements), il faut tout redessiner.
+ *
+ * @param previousSequence Numéro de publication de l'instantané affiché.
+ */
+bool Frame::follows(uint64_t previousSequence) const
+{
+	return sequence != 0 && previousSequence != 0 && sequence == previousSequence + 1;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file Frame.hpp
+ * @brief Déclaration de la classe Frame, instantané d'une partie pour l'affichage.
+ *
+ * La simulation publie un Frame après chaque tick ; les GUI n'affichent que
+ * des Frame, jamais la partie elle-même, si bien que l'affichage peut se
+ * faire sur un autre thread que la simulation.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Snake.hpp"
+#include "../includes/Point.hpp"
+#include "../includes/RenderEvent.hpp"
+
+class GameState;
+
+/**
+ * @class Frame
+ * @brief Ce qu'une GUI a besoin de savoir d'une partie, à un tick donné.
+ *
+ * Les accesseurs reprennent ceux de GameState utilisés pour le rendu. Un
+ * Frame ne contient pas la grille d'occupation : sa copie ne dépend que de
+ * la longueur du serpent, et réutilise la mémoire du Frame précédent (les
+ * obstacles ne sont recopiés que lorsque la partie ou leur nombre change).
+ */
+class Frame
+{
+	public:
+		Frame();
+		Frame(const Frame& other);
+		Frame& operator=(const Frame& other);
+		~Frame();
+
+		void		capture(const GameState& state, uint64_t tick, uint64_t timeNs);
+		void		setEvents(const RenderEventList& events, uint64_t sequence);
+
+		const	Snake& getSnake() const;
+		const	Point& getFood() const;
+		int		getScore() const;
+		bool	isFinished() const;
+		bool	isBoardFull() const;
+		bool	isWon() const;
+		const	std::vector<Point>& getObstacles() const;
+		uint64_t	getSeed() const;
+		bool	isHelpMenuActive() const;
+		uint64_t	getTick() const;
+		uint64_t	getTimeNs() const;
+		const	RenderEventList& getEvents() const;
+		uint64_t	getSequence() const;
+		bool	follows(uint64_t previousSequence) const;
+
+	private:
+		Snake				snake;			///< Corps du serpent.
+		Point				food;			///< Position de la nourriture.
+		std::vector<Point>	obstacles;		///< Obstacles de la partie.
+		uint64_t			seed;			///< Graine de la partie capturée.
+		int					score;			///< Score.
+		bool				finished;		///< Partie terminée.
+		bool				boardFull;		///< Partie terminée faute de case libre.
+		bool				won;			///< Partie gagnée (voir GameState::isWon()).
+		bool				helpMenuActive;	///< Menu d'aide affiché.
+		uint64_t			tick;			///< Numéro du tick capturé.
+		uint64_t			timeNs;			///< Instant de la capture (horloge monotone).
+		RenderEventList		events;			///< Changements depuis l'instantané publié précédent.
+		uint64_t			sequence;		///< Numéro de publication (0 : pas d'événements).
+};
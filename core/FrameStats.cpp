@@ -0,0 +1,205 @@
+/**
+ * @file FrameStats.cpp
+ * @brief Implémentation de la classe FrameStats.
+ */
+
+#include "FrameStats.hpp"
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * @brief Chaîne JSON (entre guillemets, caractères spéciaux échappés).
+	 */
+	std::string jsonString(const std::string& text)
+	{
+		std::string quoted = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+				quoted += '\\';
+			if (static_cast<unsigned char>(c) >= 0x20)
+				quoted += c;
+		}
+		return quoted + "\"";
+	}
+}
+
+/**
+ * @brief Constructeur : histogrammes vides, compteurs à zéro.
+ */
+FrameStats::FrameStats()
+{
+	for (std::atomic<uint64_t>& counter : _counters)
+		counter.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+FrameStats::~FrameStats() {}
+
+/**
+ * @brief Enregistre une durée pour une phase.
+ *
+ * @param phase Phase mesurée.
+ * @param ns Durée en nanosecondes.
+ */
+void FrameStats::record(StatsPhase phase, uint64_t ns)
+{
+	_phases[static_cast<int>(phase)].record(ns);
+}
+
+/**
+ * @brief Incrémente un compteur.
+ *
+ * @param counter Compteur.
+ * @param amount Valeur ajoutée.
+ */
+void FrameStats::count(StatsCounter counter, uint64_t amount)
+{
+	_counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Histogramme des durées d'une phase.
+ */
+const Histogram& FrameStats::getPhase(StatsPhase phase) const
+{
+	return _phases[static_cast<int>(phase)];
+}
+
+/**
+ * @brief Valeur d'un compteur.
+ */
+uint64_t FrameStats::getCounter(StatsCounter counter) const
+{
+	return _counters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ajoute ou remplace une information décrivant la partie (GUI, graine...).
+ *
+ * @param key Nom de l'information.
+ * @param value Valeur.
+ */
+void FrameStats::setInfo(const std::string& key, const std::string& value)
+{
+	for (std::pair<std::string, std::string>& entry : _info)
+	{
+		if (entry.first == key)
+		{
+			entry.second = value;
+			return;
+		}
+	}
+	_info.emplace_back(key, value);
+}
+
+/**
+ * @brief Écrit le résumé au format CSV.
+ *
+ * Une ligne par information (`info`), par compteur (`counter`) et par
+ * phase (`phase`) ; les colonnes inutiles pour un type de ligne sont vides.
+ *
+ * @param out Flux de sortie.
+ */
+void FrameStats::writeCsv(std::ostream& out) const
+{
+	out << "kind,name,value,count,mean_ns,p50_ns,p99_ns,max_ns\n";
+	for (const std::pair<std::string, std::string>& entry : _info)
+		out << "info," << entry.first << "," << entry.second << ",,,,,\n";
+	for (int i = 0; i < COUNTERS; ++i)
+		out << "counter," << counterName(static_cast<StatsCounter>(i)) << ","
+		    << getCounter(static_cast<StatsCounter>(i)) << ",,,,,\n";
+	for (int i = 0; i < PHASES; ++i)
+	{
+		const Histogram& phase = _phases[i];
+		out << "phase," << phaseName(static_cast<StatsPhase>(i)) << ",," << phase.getCount() << ","
+		    << phase.getMean() << "," << phase.percentile(50) << "," << phase.percentile(99) << ","
+		    << phase.getMax() << "\n";
+	}
+}
+
+/**
+ * @brief Écrit le résumé au format JSON : `info`, `counters` et `phases`.
+ *
+ * @param out Flux de sortie.
+ */
+void FrameStats::writeJson(std::ostream& out) const
+{
+	out << "{\n  \"info\": {";
+	for (size_t i = 0; i < _info.size(); ++i)
+		out << (i ? ", " : "") << jsonString(_info[i].first) << ": " << jsonString(_info[i].second);
+	out << "},\n  \"counters\": {";
+	for (int i = 0; i < COUNTERS; ++i)
+		out << (i ? ", " : "") << "\"" << counterName(static_cast<StatsCounter>(i)) << "\": "
+		    << getCounter(static_cast<StatsCounter>(i));
+	out << "},\n  \"phases\": {\n";
+	for (int i = 0; i < PHASES; ++i)
+	{
+		const Histogram& phase = _phases[i];
+		out << "    \"" << phaseName(static_cast<StatsPhase>(i)) << "\": {\"count\": " << phase.getCount()
+		    << ", \"mean_ns\": " << phase.getMean() << ", \"p50_ns\": " << phase.percentile(50)
+		    << ", \"p99_ns\": " << phase.percentile(99) << ", \"max_ns\": " << phase.getMax() << "}"
+		    << (i + 1 < PHASES ? ",\n" : "\n");
+	}
+	out << "  }\n}\n";
+}
+
+/**
+ * @brief Écrit le résumé dans un fichier : JSON si son nom finit par `.json`, CSV sinon.
+ *
+ * @param path Chemin du fichier.
+ * @throw std::runtime_error si le fichier ne peut pas être écrit.
+ */
+void FrameStats::save(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file)
+		throw std::runtime_error("Failed to open " + path);
+
+	const std::string suffix = ".json";
+	bool json = path.size() >= suffix.size()
+		&& path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+	if (json)
+		writeJson(file);
+	else
+		writeCsv(file);
+	if (!file)
+		throw std::runtime_error("Failed to write " + path);
+}
+
+/**
+ * @brief Nom d'une phase dans le résumé.
+ */
+const char* FrameStats::phaseName(StatsPhase phase)
+{
+	switch (phase)
+	{
+		case StatsPhase::INPUT:   return "input";
+		case StatsPhase::PLAN:    return "plan";
+		case StatsPhase::UPDATE:  return "update";
+		case StatsPhase::RENDER:  return "render";
+		case StatsPhase::DRAW:    return "draw";
+		case StatsPhase::PRESENT: return "present";
+		case StatsPhase::SLEEP:   return "sleep";
+		default:                  return "unknown";
+	}
+}
+
+/**
+ * @brief Nom d'un compteur dans le résumé.
+ */
+const char* FrameStats::counterName(StatsCounter counter)
+{
+	switch (counter)
+	{
+		case StatsCounter::TICKS:          return "ticks";
+		case StatsCounter::RENDERS:        return "renders";
+		case StatsCounter::APPLIES:        return "applies";
+		case StatsCounter::DROPPED_INPUTS: return "dropped_inputs";
+		default:                           return "unknown";
+	}
+}
@@ -0,0 +1,84 @@
+/**
+ * @file FrameStats.hpp
+ * @brief Déclaration de la classe FrameStats, mesures par phase de la boucle de jeu.
+ *
+ * Chaque phase d'une image (entrées, tick, rendu, attente) a son propre
+ * histogramme de durées, de taille fixe ; quelques compteurs complètent le
+ * tableau. Le résumé s'exporte en CSV ou en JSON (`--stats`), pour comparer
+ * les GUI sur des parties identiques.
+ */
+
+#pragma once
+
+#include "Histogram.hpp"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Phases mesurées.
+ */
+enum class StatsPhase
+{
+	INPUT,		///< Lecture des entrées de la GUI (boucle principale).
+	PLAN,		///< Choix de la direction par un contrôleur (thread de simulation).
+	UPDATE,		///< Un tick de GameState::update() (thread de simulation).
+	RENDER,		///< Appel de render() ou apply() par la boucle principale.
+	DRAW,		///< Construction de l'image, dans la GUI.
+	PRESENT,	///< Envoi de l'image à l'écran (refresh, swap), dans la GUI.
+	SLEEP,		///< Attente de l'image suivante (boucle principale).
+	COUNT
+};
+
+/**
+ * @brief Compteurs.
+ */
+enum class StatsCounter
+{
+	TICKS,			///< Ticks joués.
+	RENDERS,		///< Images affichées avec render().
+	APPLIES,		///< Images affichées avec apply() (événements seuls).
+	DROPPED_INPUTS,	///< Entrées perdues faute de place dans une file.
+	COUNT
+};
+
+/**
+ * @class FrameStats
+ * @brief Histogrammes par phase et compteurs d'une partie.
+ *
+ * Chaque phase n'est mesurée que par un seul thread (la simulation pour
+ * PLAN et UPDATE, la boucle principale pour les autres) ; les compteurs sont
+ * atomiques. Le résumé se lit une fois la simulation arrêtée.
+ */
+class FrameStats
+{
+	public:
+		FrameStats();
+		FrameStats(const FrameStats&) = delete;
+		FrameStats& operator=(const FrameStats&) = delete;
+		~FrameStats();
+
+		void				record(StatsPhase phase, uint64_t ns);
+		void				count(StatsCounter counter, uint64_t amount = 1);
+		const Histogram&	getPhase(StatsPhase phase) const;
+		uint64_t			getCounter(StatsCounter counter) const;
+		void				setInfo(const std::string& key, const std::string& value);
+
+		void				writeCsv(std::ostream& out) const;
+		void				writeJson(std::ostream& out) const;
+		void				save(const std::string& path) const;
+
+		static const char*	phaseName(StatsPhase phase);
+		static const char*	counterName(StatsCounter counter);
+
+	private:
+		static const int PHASES = static_cast<int>(StatsPhase::COUNT);		///< Nombre de phases.
+		static const int COUNTERS = static_cast<int>(StatsCounter::COUNT);	///< Nombre de compteurs.
+
+		Histogram							_phases[PHASES];		///< Durées par phase, en nanosecondes.
+		std::atomic<uint64_t>				_counters[COUNTERS];	///< Compteurs.
+		std::vector<std::pair<std::string, std::string>>	_info;	///< Description de la partie (GUI, graine...).
+};
@@ -13,10 +13,8 @@
  * Initialise un jeu vide avec une taille de plateau nulle.
  */
 Game::Game()
-	: snake(0, 0), food{0, 0}, width(0), height(0)
-{
-	std::srand(std::time(nullptr));
-}
+	: snake(0, 0), food{0, 0}, rng(Rng::randomSeed()), width(0), height(0)
+{}
 
 /**
  * @brief Constructeur avec paramètres de la classe Game.
@@ -27,9 +25,9 @@ Game::Game()
  * @param h Hauteur du plateau de jeu.
  */
 Game::Game(int w, int h)
-	: snake(w / 2, h / 2), food{0, 0}, width(w), height(h)
+	: snake(w / 2, h / 2, static_cast<size_t>(w) * h), food{0, 0}, rng(Rng::randomSeed()),
+	  width(w), height(h)
 {
-	std::srand(std::time(nullptr));
 	generateRandomFoodPosition();
 }
 
@@ -41,7 +39,7 @@ Game::Game(int w, int h)
  * @param other Autre instance de Game à copier.
  */
 Game::Game(const Game& other)
-	: snake(other.snake), food(other.food), width(other.width), height(other.height)
+	: snake(other.snake), food(other.food), rng(other.rng), width(other.width), height(other.height)
 {}
 
 /**
@@ -58,6 +56,7 @@ Game& Game::operator=(const Game& other)
 	{
 		snake = other.snake;
 		food = other.food;
+		rng = other.rng;
 		width = other.width;
 		height = other.height;
 	}
@@ -75,8 +74,8 @@ Game::~Game()
  */
 void Game::generateRandomFoodPosition()
 {
-	int x = std::rand() % width;
-	int y = std::rand() % height;
+	int x = static_cast<int>(rng.bounded(width));
+	int y = static_cast<int>(rng.bounded(height));
 	food = Point{x, y};
 }
 
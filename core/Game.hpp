@@ -8,9 +8,8 @@
 
 #pragma once
 
+#include "Rng.hpp"
 #include "Snake.hpp"
-#include <cstdlib>
-#include <ctime>
 
 /**
  * @brief Classe principale qui gère la boucle du jeu Snake.
@@ -31,6 +30,7 @@ class Game
 	private:
 		Snake	snake;	///< Le serpent du jeu.
 		Point	food;	///< La position de la nourriture.
+		Rng		rng;	///< Générateur de la partie.
 		int		width;	///< Largeur du plateau de jeu.
 		int		height; ///< Hauteur du plateau de jeu.
 };
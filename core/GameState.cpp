@@ -6,43 +6,213 @@
  */
 
 #include "GameState.hpp"
+#include "ObstacleGenerator.hpp"
+#include "Snapshot.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+const int GameState::SCORE_LIMIT;
 
 /**
  * @brief Constructeur par défaut du GameState.
  *
- * Initialise le snake, la nourriture, le score et l'état du jeu.
+ * Initialise le snake, la nourriture, le score et l'état du jeu, avec une
+ * graine non reproductible.
  *
  * @param width Largeur du plateau de jeu.
  * @param height Hauteur du plateau de jeu.
  * @param obstacles Indique si les obstacles sont activés.
  */
 GameState::GameState(int width, int height, bool obstacles)
-	: snake(width / 2, height / 2),
+	: GameState(width, height, obstacles, Rng::randomSeed())
+{}
+
+/**
+ * @brief Constructeur avec graine : deux parties de même graine sont identiques.
+ *
+ * @param width Largeur du plateau de jeu.
+ * @param height Hauteur du plateau de jeu.
+ * @param obstacles Indique si les obstacles sont activés.
+ * @param seed Graine du générateur de la partie.
+ */
+GameState::GameState(int width, int height, bool obstacles, uint64_t seed)
+	: GameState(width, height, obstacles,
+		Snake(width / 2, height / 2, static_cast<size_t>(width) * height), seed)
+{}
+
+/**
+ * @brief Constructeur à partir d'un serpent déjà positionné.
+ *
+ * Permet de démarrer une partie avec un serpent arbitraire (par exemple
+ * un serpent très long pour les benchmarks). Le serpent doit tenir
+ * à l'intérieur des murs.
+ *
+ * @param width Largeur du plateau de jeu.
+ * @param height Hauteur du plateau de jeu.
+ * @param obstacles Indique si les obstacles sont activés.
+ * @param start Serpent de départ.
+ * @param seed Graine du générateur de la partie.
+ */
+GameState::GameState(int width, int height, bool obstacles, const Snake& start, uint64_t seed)
+	: snake(start),
+	  _grid(width, height),
+	  _rng(seed),
+	  _seed(seed),
 	  food(),
 	  _score(0),
+	  _scoreLimit(SCORE_LIMIT),
 	  finished(false),
+	  _boardFull(false),
 	  _width(width),
 	  _height(height),
 	  _obstaclesEnabled(obstacles),
-	  _helpMenuActive(false)
+	  _helpMenuActive(false),
+	  _turnCount(0),
+	  _recordEvents(false)
 {
-	std::srand(std::time(nullptr));
+	placeSnake();
 	generateFood();
 
 	if (_obstaclesEnabled)
 		generateObstacles();
 }
 
+/**
+ * @brief Restaure une partie écrite par save().
+ *
+ * Les événements de rendu ne font pas partie de la sauvegarde :
+ * l'enregistrement est désactivé et la liste est vide.
+ *
+ * Le serpent, les obstacles et la nourriture doivent correspondre case
+ * pour case à la grille (voir checkGrid()) : les ticks suivants la
+ * modifient d'après eux.
+ *
+ * @param in Sauvegarde en cours de lecture.
+ * @throw std::runtime_error si la sauvegarde est incohérente.
+ */
+GameState::GameState(SnapshotReader& in)
+	: _seed(0), _score(0), _scoreLimit(SCORE_LIMIT), finished(false), _boardFull(false), _width(0), _height(0),
+	  _obstaclesEnabled(false), _helpMenuActive(false), _turnCount(0), _recordEvents(false)
+{
+	_seed = in.read<uint64_t>();
+	uint64_t state[Rng::STATE_WORDS];
+	for (uint64_t& word : state)
+		word = in.read<uint64_t>();
+	if ((state[0] | state[1] | state[2] | state[3]) == 0)
+		in.fail("generator state");
+	_rng.setState(state);
+
+	_score = in.read<int32_t>();
+	_scoreLimit = in.read<int32_t>();
+	if (_scoreLimit < 0)
+		in.fail("score limit");
+	uint8_t flags = in.read<uint8_t>();
+	finished = (flags & 1) != 0;
+	_boardFull = (flags & 2) != 0;
+	_obstaclesEnabled = (flags & 4) != 0;
+	_helpMenuActive = (flags & 8) != 0;
+	food = in.read<Point>();
+
+	_turnCount = in.read<int32_t>();
+	if (_turnCount < 0 || _turnCount > MAX_QUEUED_TURNS)
+		in.fail("queued turns");
+	for (int i = 0; i < _turnCount; ++i)
+	{
+		uint8_t turn = in.read<uint8_t>();
+		if (turn > static_cast<uint8_t>(Direction::RIGHT))
+			in.fail("queued turns");
+		_turns[i] = static_cast<Direction>(turn);
+	}
+
+	_grid.load(in);
+	_width = _grid.getWidth();
+	_height = _grid.getHeight();
+	snake.load(in, static_cast<size_t>(_width) * _height);
+	in.readVector(_obstacles, static_cast<uint64_t>(_width) * _height);
+	checkGrid(in);
+}
+
+/**
+ * @brief Vérifie qu'une partie restaurée correspond à sa grille.
+ *
+ * Chaque segment du serpent occupe sa propre case SNAKE, chaque obstacle
+ * sa propre case OBSTACLE, et la nourriture l'unique case FOOD (aucune si
+ * le plateau est plein) ; la grille ne contient aucune autre case de ces
+ * types. Seule exception : la tête d'une partie terminée peut être entrée
+ * dans un mur, un obstacle ou le corps.
+ *
+ * @param in Sauvegarde en cours de lecture (pour signaler l'erreur).
+ * @throw std::runtime_error si la partie et la grille diffèrent.
+ */
+void GameState::checkGrid(SnapshotReader& in) const
+{
+	std::vector<bool> seen(static_cast<size_t>(_width) * _height, false);
+	auto claim = [&](const Point& p, Cell expected, const char* reason) {
+		if (!_grid.contains(p) || _grid.at(p) != expected)
+			in.fail(reason);
+		size_t index = static_cast<size_t>(p.y) * _width + p.x;
+		if (seen[index])
+			in.fail(reason);
+		seen[index] = true;
+	};
+
+	// La tête en dernier : celle d'une partie perdue peut recouvrir le corps
+	size_t length = snake.getLength();
+	for (size_t i = 1; i < length; ++i)
+		claim(snake.getSegment(i), Cell::SNAKE, "snake");
+	size_t snakeCells = length - 1;
+	const Point& head = snake.getHead();
+	if (!_grid.contains(head))
+		in.fail("snake");
+	Cell headCell = _grid.at(head);
+	if (!finished || (headCell == Cell::SNAKE && !seen[static_cast<size_t>(head.y) * _width + head.x]))
+	{
+		claim(head, Cell::SNAKE, "snake");
+		++snakeCells;
+	}
+	else if (headCell != Cell::SNAKE && headCell != Cell::WALL && headCell != Cell::OBSTACLE)
+		in.fail("snake");
+
+	for (const Point& p : _obstacles)
+		claim(p, Cell::OBSTACLE, "obstacles");
+	if (_boardFull)
+	{
+		if (food.x != -1 || food.y != -1)
+			in.fail("food");
+	}
+	else
+		claim(food, Cell::FOOD, "food");
+
+	size_t counts[static_cast<size_t>(Cell::WALL) + 1] = {};
+	for (int y = 0; y < _height; ++y)
+	{
+		const Cell* row = _grid.getRow(y);
+		for (int x = 0; x < _width; ++x)
+			++counts[static_cast<size_t>(row[x])];
+	}
+	if (counts[static_cast<size_t>(Cell::SNAKE)] != snakeCells)
+		in.fail("snake");
+	if (counts[static_cast<size_t>(Cell::OBSTACLE)] != _obstacles.size())
+		in.fail("obstacles");
+	if (counts[static_cast<size_t>(Cell::FOOD)] != (_boardFull ? 0u : 1u))
+		in.fail("food");
+}
+
 /**
  * @brief Constructeur de copie.
  *
  * @param copy L'autre GameState à copier.
  */
 GameState::GameState(const GameState& copy)
-	: snake(copy.snake), food(copy.food),
-	  _score(copy._score), finished(copy.finished),
-	  _width(copy._width), _height(copy._height)
-{}
+	: snake(copy.snake), _grid(copy._grid), _rng(copy._rng), _seed(copy._seed), food(copy.food),
+	  _obstacles(copy._obstacles), _score(copy._score), _scoreLimit(copy._scoreLimit), finished(copy.finished), _boardFull(copy._boardFull),
+	  _width(copy._width), _height(copy._height), _obstaclesEnabled(copy._obstaclesEnabled),
+	  _helpMenuActive(copy._helpMenuActive), _turnCount(copy._turnCount),
+	  _recordEvents(copy._recordEvents), _events(copy._events)
+{
+	std::copy(copy._turns, copy._turns + copy._turnCount, _turns);
+}
 
 /**
  * @brief Opérateur d'affectation.
@@ -54,16 +224,48 @@ GameState& GameState::operator=(const GameState& copy)
 {
 	if (this != &copy)
 	{
-		snake = copy.snake;
-		food = copy.food;
-		_score = copy._score;
-		finished = copy.finished;
-		_width = copy._width;
-		_height = copy._height;
+		copyFrom(copy);
+		_recordEvents = copy._recordEvents;
+		_events = copy._events;
 	}
 	return *this;
 }
 
+/**
+ * @brief Copie l'état de jeu d'une autre partie, sans son journal d'événements.
+ *
+ * Chemin de copie des simulations (recherche arborescente, déroulements) :
+ * le serpent, la grille et les obstacles réutilisent les tampons déjà
+ * alloués dès que le plateau a la même taille, et le journal d'événements
+ * est vidé puis désactivé au lieu d'être copié. Une copie répétée dans un
+ * même état de travail n'alloue donc rien.
+ *
+ * @param source Partie à copier.
+ */
+void GameState::copyFrom(const GameState& source)
+{
+	if (this == &source)
+		return;
+	snake = source.snake;
+	_grid = source._grid;
+	_rng = source._rng;
+	_seed = source._seed;
+	food = source.food;
+	_obstacles = source._obstacles;
+	_score = source._score;
+	_scoreLimit = source._scoreLimit;
+	finished = source.finished;
+	_boardFull = source._boardFull;
+	_width = source._width;
+	_height = source._height;
+	_obstaclesEnabled = source._obstaclesEnabled;
+	_helpMenuActive = source._helpMenuActive;
+	_turnCount = source._turnCount;
+	std::copy(source._turns, source._turns + source._turnCount, _turns);
+	_recordEvents = false;
+	_events.clear();
+}
+
 /**
  * @brief Destructeur de GameState.
  */
@@ -74,42 +276,72 @@ GameState::~GameState() {}
  * @brief Génère des obstacles aléatoires sur la carte de jeu.
  *
  * Cette fonction crée un certain nombre d'obstacles (1% de la surface totale)
- * en s'assurant qu'ils ne chevauchent ni le serpent, ni la nourriture, ni un autre obstacle déjà placé.
- * Elle évite l'utilisation de do-while et ne dépend pas d'une surcharge d'opérateur.
+ * sur des cases libres : ils ne chevauchent ni le serpent, ni la nourriture,
+ * ni un autre obstacle. Le tirage sans remise (voir sampleObstacles()) est
+ * linéaire en la surface du plateau et réparti sur plusieurs threads pour
+ * les très grands plateaux.
  */
 void GameState::generateObstacles()
 {
-	int count = (_width * _height) / 100;
+	size_t area = static_cast<size_t>(_width) * _height;
+	size_t count = area / 100;
+
+	if (_obstacles.size() >= count)
+		return;
+
+	uint64_t seed = _rng.next();
+	unsigned threads = 1;
+	if (area >= PARALLEL_OBSTACLE_CELLS)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<Point> picked = sampleObstacles(_grid, count - _obstacles.size(), seed, threads);
+	_obstacles.reserve(count);
+	for (const Point& p : picked)
+	{
+		_obstacles.push_back(p);
+		_grid.set(p, Cell::OBSTACLE);
+		emit(RenderEventType::OBSTACLE_ADDED, p);
+	}
+}
+
+/**
+ * @brief Inscrit tous les segments du serpent dans la grille d'occupation.
+ */
+void GameState::placeSnake()
+{
+	BodyView body = snake.getBody();
+
+	for (const PointSpan& span : { body.first, body.second })
+		for (const Point& p : span)
+			_grid.set(p, Cell::SNAKE);
+}
 
-	while (_obstacles.size() < static_cast<size_t>(count))
+/**
+ * @brief Fait entrer la tête du serpent dans sa nouvelle case.
+ *
+ * Une seule lecture de la grille suffit à détecter un mur, un obstacle ou
+ * le corps du serpent : dans ce cas la partie est terminée. Sinon la case
+ * est marquée comme occupée par le serpent.
+ *
+ * @return Le contenu de la case avant l'arrivée de la tête.
+ */
+Cell GameState::occupyHead()
+{
+	const Point& head = snake.getHead();
+
+	if (!_grid.contains(head))
+	{
+		finished = true;
+		return Cell::WALL;
+	}
+	Cell target = _grid.at(head);
+	if (target == Cell::WALL || target == Cell::SNAKE || target == Cell::OBSTACLE)
 	{
-		Point p;
-		p.x = std::rand() % (_width - 2) + 1;
-		p.y = std::rand() % (_height - 2) + 1;
-
-		bool invalid = false;
-
-		// Vérifie si c’est la position de la nourriture
-		if (p.x == food.x && p.y == food.y)
-			invalid = true;
-
-		// Vérifie si c’est dans le corps du serpent
-		if (snake.checkCollision(p, false))
-			invalid = true;
-
-		// Vérifie si déjà dans les obstacles
-		for (const Point& obs : _obstacles)
-		{
-			if (p.x == obs.x && p.y == obs.y)
-			{
-				invalid = true;
-				break;
-			}
-		}
-
-		if (!invalid)
-			_obstacles.push_back(p);
+		finished = true;
+		return target;
 	}
+	_grid.set(head, Cell::SNAKE);
+	return target;
 }
 
 
@@ -123,6 +355,16 @@ const Snake& GameState::getSnake() const
 	return snake;
 }
 
+/**
+ * @brief Accès à la grille d'occupation du plateau.
+ *
+ * @return Référence constante vers la grille.
+ */
+const Grid& GameState::getGrid() const
+{
+	return _grid;
+}
+
 /**
  * @brief Accès à la position de la nourriture.
  *
@@ -143,6 +385,35 @@ int GameState::getScore() const
 	return _score;
 }
 
+/**
+ * @brief Score qui termine la partie (0 : la partie ne s'arrête qu'une fois le plateau plein).
+ */
+int GameState::getScoreLimit() const
+{
+	return _scoreLimit;
+}
+
+/**
+ * @brief Change le score qui termine la partie.
+ *
+ * @param limit Score à atteindre, ou 0 pour jouer jusqu'à remplir le plateau.
+ * @throw std::invalid_argument si `limit` est négatif.
+ */
+void GameState::setScoreLimit(int limit)
+{
+	if (limit < 0)
+		throw std::invalid_argument("GameState: negative score limit");
+	_scoreLimit = limit;
+}
+
+/**
+ * @brief Indique si la partie est gagnée : score limite atteint ou plateau rempli.
+ */
+bool GameState::isWon() const
+{
+	return _boardFull || (_scoreLimit > 0 && _score >= _scoreLimit);
+}
+
 /**
  * @brief Indique si la partie est terminée.
  *
@@ -154,47 +425,165 @@ bool GameState::isFinished() const
 }
 
 /**
- * @brief Met à jour l'état du jeu : déplace le snake, vérifie collisions et score.
+ * @brief Indique si la partie s'est arrêtée faute de case libre pour la nourriture.
+ *
+ * @return true si le plateau est entièrement occupé.
  */
-void GameState::update()
+bool GameState::isBoardFull() const
 {
-	snake.move();
+	return _boardFull;
+}
 
-	Point head = snake.getBody().front();
+/**
+ * @brief Graine avec laquelle la partie a été créée.
+ */
+uint64_t GameState::getSeed() const
+{
+	return _seed;
+}
 
-	// Collision mur
-	if (head.x <= 0 || head.x >= _width - 1 || head.y <= 0 || head.y >= _height - 1)
-	{
-		finished = true;
-		return;
-	}
+/**
+ * @brief Accès au générateur de la partie (pour une sauvegarde ou un clonage).
+ */
+const Rng& GameState::getRng() const
+{
+	return _rng;
+}
+
+/**
+ * @brief Empreinte de l'état de la partie.
+ *
+ * Couvre tout ce qui détermine la suite de la partie ou ce qui en est
+ * affiché : plateau, serpent (corps et direction), virages en attente,
+ * nourriture, obstacles, score et score limite, fin de partie, menu d'aide et état du
+ * générateur. Deux parties qui ont la même empreinte se poursuivent de la
+ * même façon ; une relecture (voir Replay.hpp) s'en sert pour vérifier
+ * qu'elle a reproduit la partie enregistrée.
+ *
+ * @return Empreinte sur 64 bits (stable d'une exécution à l'autre).
+ */
+uint64_t GameState::hash() const
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	auto mix = [&hash](uint64_t value) {
+		hash = (hash ^ value) * 0x100000001b3ULL;
+		hash ^= hash >> 29;
+	};
+	auto mixPoint = [&mix](const Point& p) {
+		mix((static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32) | static_cast<uint32_t>(p.y));
+	};
+
+	mix(static_cast<uint64_t>(_width));
+	mix(static_cast<uint64_t>(_height));
+	mix(static_cast<uint64_t>(_score));
+	mix(static_cast<uint64_t>(_scoreLimit));
+	mix((finished ? 1 : 0) | (_boardFull ? 2 : 0) | (_helpMenuActive ? 4 : 0) | (_obstaclesEnabled ? 8 : 0));
+	mixPoint(food);
+	mix(static_cast<uint64_t>(snake.getDirection()));
+	mix(snake.getLength());
+	for (size_t i = 0; i < snake.getLength(); ++i)
+		mixPoint(snake.getSegment(i));
+	mix(static_cast<uint64_t>(_turnCount));
+	for (int i = 0; i < _turnCount; ++i)
+		mix(static_cast<uint64_t>(_turns[i]));
+	mix(_obstacles.size());
+	for (const Point& obstacle : _obstacles)
+		mixPoint(obstacle);
+
+	uint64_t state[Rng::STATE_WORDS];
+	_rng.getState(state);
+	for (uint64_t word : state)
+		mix(word);
+	return hash;
+}
+
+/**
+ * @brief Écrit l'état complet de la partie dans une sauvegarde (voir Snapshot.hpp).
+ *
+ * Contenu, dans l'ordre : graine, état du générateur, score, score limite, indicateurs,
+ * nourriture, virages en attente, grille, serpent puis obstacles.
+ *
+ * @param out Sauvegarde en cours.
+ */
+void GameState::save(SnapshotWriter& out) const
+{
+	uint64_t state[Rng::STATE_WORDS];
+	_rng.getState(state);
+
+	out.write<uint64_t>(_seed);
+	for (uint64_t word : state)
+		out.write(word);
+	out.write<int32_t>(_score);
+	out.write<int32_t>(_scoreLimit);
+	out.write<uint8_t>((finished ? 1 : 0) | (_boardFull ? 2 : 0) | (_obstaclesEnabled ? 4 : 0)
+		| (_helpMenuActive ? 8 : 0));
+	out.write(food);
+	out.write<int32_t>(_turnCount);
+	for (int i = 0; i < _turnCount; ++i)
+		out.write<uint8_t>(static_cast<uint8_t>(_turns[i]));
+	_grid.save(out);
+	snake.save(out);
+	out.writeArray(_obstacles.data(), _obstacles.size());
+}
 
-	// Collision avec soi-même
-	if (snake.checkCollision(head, true))
+/**
+ * @brief Met à jour l'état du jeu : déplace le snake, vérifie collisions et score.
+ *
+ * La grille d'occupation est mise à jour de façon incrémentale (queue libérée,
+ * tête occupée), si bien que le coût d'un tick ne dépend pas de la longueur
+ * du serpent ni du nombre d'obstacles. Le tick où il mange, le serpent entre
+ * dans la case de la nourriture sans déplacer sa queue : il grandit d'un
+ * segment et peut remplir tout le plateau.
+ *
+ * Le plus ancien virage en attente (voir queueDirection()) est appliqué
+ * avant le déplacement. Si l'enregistrement est actif (voir recordEvents()),
+ * les changements visibles du tick sont ajoutés à getEvents().
+ */
+void GameState::update()
+{
+	step();
+	if (finished)
+		emit(RenderEventType::GAME_OVER, Point());
+}
+
+/**
+ * @brief Un tick de jeu, sans l'événement de fin de partie.
+ */
+void GameState::step()
+{
+	if (_turnCount > 0)
 	{
-		finished = true;
-		return;
+		snake.setDirection(_turns[0]);
+		std::copy(_turns + 1, _turns + _turnCount, _turns);
+		--_turnCount;
 	}
 
-	if (snake.getBody().front().x == food.x && snake.getBody().front().y == food.y)
+	// Un serpent qui mange avance sa tête sans déplacer sa queue
+	Point next = snake.nextHead();
+	if (_grid.contains(next) && _grid.at(next) == Cell::FOOD)
 	{
 		snake.grow();
+		emit(RenderEventType::HEAD_ADDED, next);
+		occupyHead();
 		increaseScore(10);
 		generateFood();
 	}
-
-	if (_obstaclesEnabled)
+	else
 	{
-		for (const Point& obs : _obstacles)
-		{
-			if (head.x == obs.x && head.y == obs.y)
-			{
-				finished = true;
-				return;
-			}
-		}
+		Point tail = snake.getTail();
+
+		snake.move();
+		_grid.set(tail, Cell::EMPTY);
+		emit(RenderEventType::TAIL_REMOVED, tail);
+		emit(RenderEventType::HEAD_ADDED, next);
+
+		// Collision mur, soi-même ou obstacle : une seule lecture de la grille
+		occupyHead();
+		if (finished)
+			return;
 	}
-	if (_score >= 200)
+
+	if (_scoreLimit > 0 && _score >= _scoreLimit)
 		finished = true;
 }
 
@@ -223,28 +612,126 @@ void GameState::setDirection(Input input)
 	}
 }
 
+/**
+ * @brief Met un virage en attente pour un prochain tick.
+ *
+ * Contrairement à setDirection(), plusieurs virages rapides (par exemple
+ * haut puis gauche pendant le même tick) sont conservés et joués un par
+ * tick. Un virage identique au précédent ou qui lui est opposé est ignoré,
+ * tout comme les virages au-delà de MAX_QUEUED_TURNS.
+ *
+ * @param input Direction souhaitée (les autres entrées sont ignorées).
+ * @return true si le virage a été mis en attente.
+ */
+bool GameState::queueDirection(Input input)
+{
+	Direction wanted;
+
+	switch (input)
+	{
+		case Input::UP:    wanted = Direction::UP;    break;
+		case Input::DOWN:  wanted = Direction::DOWN;  break;
+		case Input::LEFT:  wanted = Direction::LEFT;  break;
+		case Input::RIGHT: wanted = Direction::RIGHT; break;
+		default: return false;
+	}
+	if (_turnCount == MAX_QUEUED_TURNS)
+		return false;
+
+	// Les directions opposées ne diffèrent que par leur bit de poids faible
+	Direction last = _turnCount > 0 ? _turns[_turnCount - 1] : snake.getDirection();
+	if (wanted == last || static_cast<int>(wanted) == (static_cast<int>(last) ^ 1))
+		return false;
+	_turns[_turnCount++] = wanted;
+	return true;
+}
+
+/**
+ * @brief Nombre de virages en attente.
+ */
+int GameState::getQueuedTurns() const
+{
+	return _turnCount;
+}
+
 /**
  * @brief Génère une nouvelle position aléatoire pour la nourriture.
+ *
+ * La position est tirée uniformément parmi les cases libres de la grille,
+ * en temps constant. S'il n'en reste aucune, le plateau est plein : la
+ * partie se termine et la nourriture est placée hors du plateau.
  */
 void GameState::generateFood()
 {
-	int x = 1 + std::rand() % (_width - 2);
-	int y = 1 + std::rand() % (_height - 2);
-	food = Point(x, y);
+	size_t freeCount = _grid.getFreeCount();
+
+	if (freeCount == 0)
+	{
+		food = Point(-1, -1);
+		_boardFull = true;
+		finished = true;
+		emit(RenderEventType::FOOD_MOVED, food);
+		return;
+	}
+	food = _grid.getFreeCell(_rng.bounded(freeCount));
+	_grid.set(food, Cell::FOOD);
+	emit(RenderEventType::FOOD_MOVED, food);
 }
 
 
 /**
  * @brief Réinitialise le jeu : snake, score, état, et nourriture.
+ *
+ * Aucun événement n'est produit : l'affichage doit être refait en entier.
  */
 void GameState::reset()
 {
-	snake = Snake(5, 10);
+	snake = Snake(5, 10, static_cast<size_t>(_width) * _height);
 	_score = 0;
 	finished = false;
+	_boardFull = false;
+	_turnCount = 0;
+	_grid.clear();
+	for (const Point& obs : _obstacles)
+		_grid.set(obs, Cell::OBSTACLE);
+	placeSnake();
 	generateFood();
 }
 
+/**
+ * @brief Commence une nouvelle partie sur le même plateau, sans allocation.
+ *
+ * La partie obtenue est identique à `GameState(largeur, hauteur, obstacles,
+ * seed)` (même serpent, même nourriture, mêmes tirages), au score limite
+ * près, qui est conservé. Grille, serpent et obstacles réutilisent leurs
+ * tampons ; seul le tirage des obstacles, s'ils sont actifs, alloue.
+ * La liste des événements est vidée, y compris ceux des tirages : aucun
+ * n'est produit, l'affichage doit être refait en entier.
+ *
+ * @param seed Graine de la nouvelle partie.
+ */
+void GameState::restart(uint64_t seed)
+{
+	_rng.seed(seed);
+	_seed = seed;
+	food = Point();
+	_score = 0;
+	finished = false;
+	_boardFull = false;
+	_helpMenuActive = false;
+	_turnCount = 0;
+	snake.restart(_width / 2, _height / 2);
+	_grid.clear();
+	_obstacles.clear();
+	placeSnake();
+	generateFood();
+
+	if (_obstaclesEnabled)
+		generateObstacles();
+	// generateFood() et generateObstacles() émettent si l'enregistrement est actif
+	_events.clear();
+}
+
 /**
  * @brief Augmente le score d'un certain montant.
  *
@@ -253,6 +740,7 @@ void GameState::reset()
 void GameState::increaseScore(int amount)
 {
 	_score += amount;
+	emit(RenderEventType::SCORE_CHANGED, Point(), _score);
 }
 
 /**
@@ -282,3 +770,43 @@ bool GameState::isHelpMenuActive() const
 {
 	return _helpMenuActive;
 }
+
+/**
+ * @brief Active ou désactive l'enregistrement des changements visibles.
+ *
+ * Désactivé par défaut : les simulations sans affichage n'en paient pas le
+ * coût. Les événements s'accumulent jusqu'au prochain clearEvents().
+ *
+ * @param enabled true pour enregistrer les événements.
+ */
+void GameState::recordEvents(bool enabled)
+{
+	_recordEvents = enabled;
+	if (!enabled)
+		_events.clear();
+}
+
+/**
+ * @brief Changements visibles depuis le dernier clearEvents(), dans l'ordre.
+ */
+const RenderEventList& GameState::getEvents() const
+{
+	return _events;
+}
+
+/**
+ * @brief Vide la liste des événements (la mémoire est conservée).
+ */
+void GameState::clearEvents()
+{
+	_events.clear();
+}
+
+/**
+ * @brief Ajoute un événement si l'enregistrement est actif.
+ */
+void GameState::emit(RenderEventType type, const Point& cell, int value)
+{
+	if (_recordEvents)
+		_events.emplace_back(type, cell, value);
+}
@@ -9,13 +9,19 @@
 
 #pragma once
 
+#include "Grid.hpp"
+#include "Rng.hpp"
 #include "Snake.hpp"
 #include "../includes/Input.hpp"
 #include "../includes/Point.hpp"
+#include "../includes/RenderEvent.hpp"
+#include <cstdint>
 #include <cstdlib>
-#include <ctime>
 #include <vector>
 
+class SnapshotReader;
+class SnapshotWriter;
+
 /**
  * @class GameState
  * @brief Représente l'état actuel du jeu Snake.
@@ -28,35 +34,75 @@
 class GameState
 {
 	public:
+		static const int SCORE_LIMIT = 200;	///< Score à atteindre pour gagner, par défaut (voir setScoreLimit()).
+		static const int MAX_QUEUED_TURNS = 3;	///< Virages mis en attente au plus (un joué par tick).
+
 		GameState(int width, int height, bool obstacles);
+		GameState(int width, int height, bool obstacles, uint64_t seed);
+		GameState(int width, int height, bool obstacles, const Snake& start, uint64_t seed);
+		explicit GameState(SnapshotReader& in);
 		GameState(const GameState& copy);
 		GameState& operator=(const GameState& copy);
 		~GameState();
 
+		void	copyFrom(const GameState& source);
+
 		const	Snake& getSnake() const;
+		const	Grid& getGrid() const;
 		const	Point& getFood() const;
 		int		getScore() const;
+		int		getScoreLimit() const;
+		void	setScoreLimit(int limit);
+		bool	isWon() const;
 		bool	isFinished() const;
+		bool	isBoardFull() const;
+		uint64_t	getSeed() const;
+		const	Rng& getRng() const;
+		uint64_t	hash() const;
+		void	save(SnapshotWriter& out) const;
 
 		void	update();
 		void	setDirection(Input input);
+		bool	queueDirection(Input input);
+		int		getQueuedTurns() const;
 		void	generateFood();
 		void	reset();
+		void	restart(uint64_t seed);
 		void	increaseScore(int amount);
 		void	generateObstacles();
 		const	std::vector<Point>& getObstacles() const;
 		void	toggleHelpMenu();
 		bool	isHelpMenuActive() const;
+		void	recordEvents(bool enabled);
+		const	RenderEventList& getEvents() const;
+		void	clearEvents();
 
 	private:
+		static const size_t PARALLEL_OBSTACLE_CELLS = 1 << 20;	///< Surface à partir de laquelle les obstacles sont tirés en parallèle.
+
+		void	placeSnake();
+		Cell	occupyHead();
+		void	step();
+		void	checkGrid(SnapshotReader& in) const;
+		void	emit(RenderEventType type, const Point& cell, int value = 0);
+
 		Snake	snake;					///< Le serpent du jeu.
+		Grid	_grid;					///< Grille d'occupation du plateau.
+		Rng		_rng;					///< Générateur propre à la partie (nourriture, obstacles).
+		uint64_t	_seed;				///< Graine de la partie.
 		Point	food;					///< La position de la nourriture.
 		std::vector<Point> _obstacles;	///< Liste des obstacles du jeu.
 		int		_score;					///< Le score actuel du joueur.
+		int		_scoreLimit;			///< Score qui termine la partie (0 : aucun, jusqu'au plateau plein).
 		bool	finished;				///< Indique si le jeu est terminé.
+		bool	_boardFull;				///< Indique qu'il ne reste aucune case libre.
 		int		_width;					///< Largeur du plateau de jeu.
 		int		_height;				///< Hauteur du plateau de jeu.
 		bool 	_obstaclesEnabled;		///< Indique si les obstacles sont activés.
 		bool	_helpMenuActive;		///< Indique si le menu d'aide est actif.
+		Direction	_turns[MAX_QUEUED_TURNS];	///< Virages en attente, du plus ancien au plus récent.
+		int		_turnCount;				///< Nombre de virages en attente.
+		bool	_recordEvents;			///< Les changements visibles sont enregistrés dans _events.
+		RenderEventList	_events;		///< Changements visibles depuis le dernier clearEvents().
 
 };
\ No newline at end of file
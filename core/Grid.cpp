@@ -0,0 +1,294 @@
+/**
+ * @file Grid.cpp
+ * @brief Implémentation de la classe Grid.
+ *
+ * Ce fichier contient la gestion de la grille d'occupation : création des
+ * murs, lecture et écriture du contenu d'une case, et suivi des cases libres.
+ */
+
+#include "Grid.hpp"
+#include "Snapshot.hpp"
+#include <algorithm>
+
+const uint32_t Grid::NOT_FREE;
+
+/**
+ * @brief Constructeur par défaut : grille vide de taille nulle.
+ */
+Grid::Grid() : width(0), height(0)
+{}
+
+/**
+ * @brief Construit une grille de la taille du plateau, murs compris.
+ *
+ * @param width Largeur du plateau.
+ * @param height Hauteur du plateau.
+ */
+Grid::Grid(int width, int height)
+	: cells(static_cast<size_t>(width) * height),
+	  freeCells(static_cast<size_t>(width) * height),
+	  freeSlots(static_cast<size_t>(width) * height),
+	  width(width), height(height)
+{
+	cells.resize(cells.capacity());
+	freeSlots.resize(freeSlots.capacity());
+	clear();
+}
+
+/**
+ * @brief Constructeur de copie.
+ */
+Grid::Grid(const Grid& other)
+	: cells(other.cells), freeCells(other.freeCells), freeSlots(other.freeSlots),
+	  width(other.width), height(other.height)
+{}
+
+/**
+ * @brief Opérateur d'affectation.
+ */
+Grid& Grid::operator=(const Grid& other)
+{
+	if (this != &other)
+	{
+		cells = other.cells;
+		freeCells = other.freeCells;
+		freeSlots = other.freeSlots;
+		width = other.width;
+		height = other.height;
+	}
+	return *this;
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+Grid::~Grid() {}
+
+/**
+ * @brief Largeur du plateau couvert par la grille.
+ */
+int Grid::getWidth() const
+{
+	return width;
+}
+
+/**
+ * @brief Hauteur du plateau couvert par la grille.
+ */
+int Grid::getHeight() const
+{
+	return height;
+}
+
+/**
+ * @brief Indique si un point se trouve sur le plateau.
+ *
+ * @param p Le point à tester.
+ * @return true si le point est dans les limites de la grille.
+ */
+bool Grid::contains(const Point& p) const
+{
+	return p.x >= 0 && p.x < width && p.y >= 0 && p.y < height;
+}
+
+/**
+ * @brief Retourne le contenu d'une case.
+ *
+ * @param p Position de la case, supposée dans les limites de la grille.
+ * @return L'étiquette de la case.
+ */
+Cell Grid::at(const Point& p) const
+{
+	return cells[static_cast<size_t>(p.y) * width + p.x];
+}
+
+/**
+ * @brief Accès direct à une ligne de la grille, pour les parcours massifs.
+ *
+ * Les lignes sont contiguës : la ligne y + 1 suit immédiatement la ligne y.
+ *
+ * @param y Indice de la ligne.
+ * @return Pointeur vers la première case de la ligne.
+ */
+const Cell* Grid::getRow(int y) const
+{
+	return cells.data() + static_cast<size_t>(y) * width;
+}
+
+/**
+ * @brief Modifie le contenu d'une case.
+ *
+ * L'ensemble des cases libres est mis à jour lorsque la case devient vide
+ * ou cesse de l'être.
+ *
+ * @param p Position de la case, supposée dans les limites de la grille.
+ * @param cell Nouvelle étiquette.
+ */
+void Grid::set(const Point& p, Cell cell)
+{
+	uint32_t index = static_cast<uint32_t>(p.y) * width + p.x;
+	Cell previous = cells[index];
+
+	if (previous == cell)
+		return;
+	if (previous == Cell::EMPTY)
+		removeFree(index);
+	else if (cell == Cell::EMPTY)
+		addFree(index);
+	cells[index] = cell;
+}
+
+/**
+ * @brief Vide la grille et replace les murs sur les bords du plateau.
+ *
+ * Toutes les cases intérieures redeviennent libres, dans l'ordre des lignes.
+ */
+void Grid::clear()
+{
+	size_t interior = 0;
+	if (width > 2 && height > 2)
+		interior = static_cast<size_t>(width - 2) * (height - 2);
+
+	freeCells.resize(interior);
+	for (int y = 0; y < height; ++y)
+	{
+		Cell* row = cells.data() + static_cast<size_t>(y) * width;
+		uint32_t* slots = freeSlots.data() + static_cast<size_t>(y) * width;
+
+		if (y == 0 || y == height - 1)
+		{
+			std::fill(row, row + width, Cell::WALL);
+			std::fill(slots, slots + width, NOT_FREE);
+			continue;
+		}
+		row[0] = row[width - 1] = Cell::WALL;
+		slots[0] = slots[width - 1] = NOT_FREE;
+
+		uint32_t index = static_cast<uint32_t>(y) * width + 1;
+		uint32_t slot = static_cast<uint32_t>(y - 1) * (width - 2);
+		for (int x = 1; x < width - 1; ++x, ++index, ++slot)
+		{
+			row[x] = Cell::EMPTY;
+			slots[x] = slot;
+			freeCells[slot] = index;
+		}
+	}
+}
+
+/**
+ * @brief Nombre de cases actuellement libres.
+ */
+size_t Grid::getFreeCount() const
+{
+	return freeCells.size();
+}
+
+/**
+ * @brief Retourne la case libre de rang donné dans l'ensemble des cases libres.
+ *
+ * Tirer `rank` uniformément dans [0, getFreeCount()) donne une case libre
+ * uniforme.
+ *
+ * @param rank Rang dans l'ensemble, inférieur à getFreeCount().
+ * @return La position de la case libre.
+ */
+Point Grid::getFreeCell(size_t rank) const
+{
+	uint32_t index = freeCells[rank];
+	return Point(static_cast<int>(index % width), static_cast<int>(index / width));
+}
+
+/**
+ * @brief Écrit la grille dans une sauvegarde : taille, cases, cases libres et leurs positions.
+ *
+ * L'ordre des cases libres détermine les tirages suivants (getFreeCell()) :
+ * il est conservé tel quel. Chaque tableau commence sur une page du
+ * fichier, pour que load() puisse le projeter.
+ *
+ * @param out Sauvegarde en cours.
+ */
+void Grid::save(SnapshotWriter& out) const
+{
+	out.write<int32_t>(width);
+	out.write<int32_t>(height);
+	out.writeArray(cells.data(), cells.size(), SnapshotWriter::PAGE);
+	out.writeArray(freeCells.data(), freeCells.size(), SnapshotWriter::PAGE);
+	out.writeArray(freeSlots.data(), freeSlots.size(), SnapshotWriter::PAGE);
+}
+
+/**
+ * @brief Remplace la grille par celle d'une sauvegarde, projetée en copie privée.
+ *
+ * Rien n'est copié : les pages du fichier sont projetées, puis lues une
+ * fois pour vérifier la grille. Chaque étiquette doit être connue, les
+ * cases libres doivent être exactement les cases vides, et chaque case
+ * libre doit retrouver sa position dans `freeSlots` : sans cela, un retrait
+ * ou un ajout ultérieur écrirait hors des tableaux.
+ *
+ * @param in Sauvegarde en cours de lecture.
+ * @throw std::runtime_error si la grille est incohérente ou la projection impossible.
+ */
+void Grid::load(SnapshotReader& in)
+{
+	int32_t w = in.read<int32_t>();
+	int32_t h = in.read<int32_t>();
+	if (w <= 0 || h <= 0 || static_cast<uint64_t>(w) * h >= NOT_FREE)
+		in.fail("grid size");
+	size_t area = static_cast<size_t>(w) * h;
+
+	in.mapArray(cells, area, area);
+	in.mapArray(freeCells, area, area);
+	in.mapArray(freeSlots, area, area);
+	if (cells.size() != area || freeSlots.size() != area)
+		in.fail("grid cells");
+
+	size_t empty = 0;
+	for (size_t i = 0; i < area; ++i)
+	{
+		if (cells[i] > Cell::WALL)
+			in.fail("grid cells");
+		if (cells[i] == Cell::EMPTY)
+			++empty;
+		else if (freeSlots[i] != NOT_FREE)
+			in.fail("free cells");
+	}
+	if (freeCells.size() != empty)
+		in.fail("free cells");
+	for (size_t i = 0; i < empty; ++i)
+	{
+		uint32_t index = freeCells[i];
+		if (index >= area || cells[index] != Cell::EMPTY || freeSlots[index] != i)
+			in.fail("free cells");
+	}
+	width = w;
+	height = h;
+}
+
+/**
+ * @brief Ajoute une case à l'ensemble des cases libres.
+ *
+ * @param index Indice linéaire de la case.
+ */
+void Grid::addFree(uint32_t index)
+{
+	freeSlots[index] = static_cast<uint32_t>(freeCells.size());
+	freeCells.push_back(index);
+}
+
+/**
+ * @brief Retire une case de l'ensemble des cases libres.
+ *
+ * La case est remplacée par la dernière du tableau dense (retrait en O(1)).
+ *
+ * @param index Indice linéaire de la case.
+ */
+void Grid::removeFree(uint32_t index)
+{
+	uint32_t slot = freeSlots[index];
+	uint32_t last = freeCells.back();
+
+	freeCells[slot] = last;
+	freeSlots[last] = slot;
+	freeCells.pop_back();
+	freeSlots[index] = NOT_FREE;
+}
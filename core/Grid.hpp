@@ -0,0 +1,80 @@
+/**
+ * @file Grid.hpp
+ * @brief Déclaration de la classe Grid, grille d'occupation du plateau.
+ *
+ * La grille associe à chaque case du plateau son contenu (vide, serpent,
+ * obstacle, nourriture ou mur) afin que toutes les collisions se résolvent
+ * en une seule lecture, quelle que soit la longueur du serpent.
+ * Elle tient aussi à jour l'ensemble des cases libres pour placer la
+ * nourriture en temps constant.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../includes/PagedArray.hpp"
+#include "../includes/Point.hpp"
+
+class SnapshotReader;
+class SnapshotWriter;
+
+/**
+ * @brief Contenu possible d'une case du plateau.
+ */
+enum class Cell : uint8_t
+{
+	EMPTY,
+	SNAKE,
+	OBSTACLE,
+	FOOD,
+	WALL,
+};
+
+/**
+ * @brief Grille d'occupation du plateau de jeu.
+ *
+ * Stocke une étiquette par case, ligne par ligne. Les bords du plateau sont
+ * marqués comme murs dès la construction. La grille est tenue à jour de façon
+ * incrémentale par GameState à chaque déplacement du serpent.
+ *
+ * Les cases vides sont indexées dans un tableau dense (`freeCells`) associé à
+ * un index de position par case (`freeSlots`) : ajout et retrait se font en
+ * O(1) par échange avec le dernier élément, et une case libre uniforme se
+ * tire en O(1). Les trois tableaux sont dimensionnés une fois pour toutes
+ * sur la surface du plateau, et projetés depuis le fichier lorsqu'une
+ * sauvegarde est restaurée (voir load()).
+ */
+class Grid
+{
+	public:
+		Grid();
+		Grid(int width, int height);
+		Grid(const Grid& other);
+		Grid& operator=(const Grid& other);
+		~Grid();
+
+		int		getWidth() const;
+		int		getHeight() const;
+		bool	contains(const Point& p) const;
+		Cell	at(const Point& p) const;
+		const	Cell* getRow(int y) const;
+		void	set(const Point& p, Cell cell);
+		void	clear();
+		size_t	getFreeCount() const;
+		Point	getFreeCell(size_t rank) const;
+		void	save(SnapshotWriter& out) const;
+		void	load(SnapshotReader& in);
+
+	private:
+		static const uint32_t NOT_FREE = 0xFFFFFFFFu;	///< Index d'une case non libre.
+
+		void	addFree(uint32_t index);
+		void	removeFree(uint32_t index);
+
+		PagedArray<Cell>		cells;		///< Contenu des cases, ligne par ligne.
+		PagedArray<uint32_t>	freeCells;	///< Indices des cases vides, sans ordre particulier.
+		PagedArray<uint32_t>	freeSlots;	///< Position de chaque case dans freeCells (ou NOT_FREE).
+		int						width;		///< Largeur du plateau.
+		int						height;		///< Hauteur du plateau.
+};
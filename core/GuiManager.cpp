@@ -0,0 +1,234 @@
+/**
+ * @file GuiManager.cpp
+ * @brief Implémentation de la classe GuiManager.
+ */
+
+#include "GuiManager.hpp"
+#include <stdexcept>
+#include <unistd.h>
+
+const char* const GuiManager::NAMES[] = { "ncurses", "sdl", "opengl", "null" };
+const size_t GuiManager::GUI_COUNT = sizeof(NAMES) / sizeof(NAMES[0]);
+
+/**
+ * @brief Constructeur : sauvegarde les réglages du terminal, ne charge rien.
+ *
+ * @param directory Dossier contenant les bibliothèques `libgui_<nom>.so`.
+ */
+GuiManager::GuiManager(const std::string& directory)
+	: _directory(directory), _plugins(GUI_COUNT), _current(nullptr), _currentPlugin(nullptr),
+	  _terminal(), _hasTerminal(false)
+{
+	for (size_t i = 0; i < GUI_COUNT; ++i)
+	{
+		_plugins[i].name = NAMES[i];
+		_plugins[i].create = nullptr;
+		_plugins[i].destroy = nullptr;
+		_plugins[i].attempted = false;
+	}
+	_hasTerminal = isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &_terminal) == 0;
+}
+
+/**
+ * @brief Destructeur : ferme la GUI courante puis décharge les bibliothèques.
+ */
+GuiManager::~GuiManager()
+{
+	waitForLoader();
+	try
+	{
+		close();
+	}
+	catch (const std::exception&)
+	{
+		// Un destructeur ne doit pas lever : le terminal est tout de même restauré
+		restoreTerminal();
+	}
+}
+
+/**
+ * @brief Charge toutes les bibliothèques connues.
+ *
+ * Une bibliothèque absente ou invalide n'est pas une erreur ici : elle
+ * n'est signalée que si l'on essaie d'ouvrir sa GUI.
+ *
+ * @param background Charge sur un thread séparé ; le premier open() ou
+ * isAvailable() attend la fin du chargement.
+ */
+void GuiManager::preload(bool background)
+{
+	waitForLoader();
+	if (!background)
+	{
+		for (Plugin& plugin : _plugins)
+			load(plugin);
+		return;
+	}
+	_loader = std::thread([this]()
+	{
+		for (Plugin& plugin : _plugins)
+			load(plugin);
+	});
+}
+
+/**
+ * @brief Charge une bibliothèque et lit ses deux fonctions exportées.
+ *
+ * Sans effet si le chargement a déjà été tenté ; une erreur est conservée
+ * dans `plugin.error`.
+ */
+void GuiManager::load(Plugin& plugin) const
+{
+	if (plugin.attempted)
+		return;
+	plugin.attempted = true;
+	try
+	{
+		SharedLibrary library(_directory + "/libgui_" + plugin.name + ".so");
+		plugin.create = reinterpret_cast<CreateGuiFunc>(library.symbol("createGui"));
+		plugin.destroy = reinterpret_cast<DestroyGuiFunc>(library.symbol("destroyGui"));
+		plugin.library = std::move(library);
+	}
+	catch (const std::exception& e)
+	{
+		plugin.create = nullptr;
+		plugin.destroy = nullptr;
+		plugin.error = e.what();
+	}
+}
+
+/**
+ * @brief Attend la fin du chargement en arrière-plan, s'il y en a un.
+ */
+void GuiManager::waitForLoader()
+{
+	if (_loader.joinable())
+		_loader.join();
+}
+
+/**
+ * @brief Bibliothèque d'une GUI, chargée si besoin.
+ *
+ * @param name Nom de la GUI (voir NAMES).
+ * @throw std::runtime_error si la GUI est inconnue ou sa bibliothèque inutilisable.
+ */
+GuiManager::Plugin& GuiManager::find(const std::string& name)
+{
+	waitForLoader();
+	for (Plugin& plugin : _plugins)
+	{
+		if (plugin.name != name)
+			continue;
+		load(plugin);
+		if (!plugin.error.empty())
+			throw std::runtime_error(plugin.error);
+		return plugin;
+	}
+	throw std::runtime_error("Unknown GUI: " + name);
+}
+
+/**
+ * @brief Indique si la bibliothèque d'une GUI est utilisable.
+ *
+ * @param name Nom de la GUI.
+ */
+bool GuiManager::isAvailable(const std::string& name)
+{
+	try
+	{
+		find(name);
+	}
+	catch (const std::runtime_error&)
+	{
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Remplace la GUI courante par une nouvelle GUI, initialisée.
+ *
+ * La bibliothèque demandée est vérifiée avant de fermer la GUI courante :
+ * si elle est inutilisable, la GUI courante reste ouverte.
+ *
+ * @param name Nom de la GUI.
+ * @param width Largeur du plateau.
+ * @param height Hauteur du plateau.
+ * @return La nouvelle GUI, qui reste la propriété du gestionnaire.
+ * @throw std::runtime_error si la bibliothèque est inutilisable ou si init() échoue
+ * (il n'y a alors plus de GUI courante).
+ */
+IGui* GuiManager::open(const std::string& name, int width, int height)
+{
+	Plugin& plugin = find(name);
+	close();
+
+	IGui* gui = plugin.create();
+	if (!gui)
+		throw std::runtime_error("createGui() failed in " + plugin.library.getPath());
+	try
+	{
+		gui->init(width, height);
+	}
+	catch (...)
+	{
+		plugin.destroy(gui);
+		restoreTerminal();
+		throw;
+	}
+	_current = gui;
+	_currentPlugin = &plugin;
+	return gui;
+}
+
+/**
+ * @brief Ferme la GUI courante (cleanup() puis destroyGui()) et restaure le terminal.
+ */
+void GuiManager::close()
+{
+	if (!_current)
+		return;
+
+	IGui* gui = _current;
+	Plugin* plugin = _currentPlugin;
+	_current = nullptr;
+	_currentPlugin = nullptr;
+	try
+	{
+		gui->cleanup();
+	}
+	catch (...)
+	{
+		plugin->destroy(gui);
+		restoreTerminal();
+		throw;
+	}
+	plugin->destroy(gui);
+	restoreTerminal();
+}
+
+/**
+ * @brief Rétablit les réglages du terminal sauvegardés au démarrage.
+ */
+void GuiManager::restoreTerminal() const
+{
+	if (_hasTerminal)
+		tcsetattr(STDIN_FILENO, TCSANOW, &_terminal);
+}
+
+/**
+ * @brief GUI ouverte, nulle si aucune.
+ */
+IGui* GuiManager::current() const
+{
+	return _current;
+}
+
+/**
+ * @brief Nom de la GUI ouverte (chaîne vide si aucune).
+ */
+const std::string& GuiManager::currentName() const
+{
+	static const std::string none;
+	return _currentPlugin ? _currentPlugin->name : none;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file GuiManager.hpp
+ * @brief Déclaration de la classe GuiManager, cache des bibliothèques de GUI.
+ */
+
+#pragma once
+
+#include "SharedLibrary.hpp"
+#include "../includes/IGui.hpp"
+#include <string>
+#include <termios.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @class GuiManager
+ * @brief Garde chargées toutes les bibliothèques `libgui_*.so` et la GUI courante.
+ *
+ * Chaque bibliothèque n'est chargée qu'une fois (éventuellement sur un
+ * thread en arrière-plan dès le démarrage, voir preload()) ; ses fonctions
+ * createGui() et destroyGui() restent disponibles jusqu'à la destruction du
+ * gestionnaire, qui décharge alors les bibliothèques. Changer de GUI ne
+ * coûte donc que le cleanup() de l'ancienne et l'init() de la nouvelle.
+ *
+ * Les réglages du terminal (termios) sont sauvegardés à la construction et
+ * restaurés après chaque fermeture de GUI, sans lancer de commande externe.
+ */
+class GuiManager
+{
+	public:
+		static const char* const NAMES[];	///< Noms des GUI connues : libgui_<nom>.so.
+		static const size_t GUI_COUNT;		///< Nombre de GUI connues.
+
+		explicit GuiManager(const std::string& directory);
+		GuiManager(const GuiManager&) = delete;
+		GuiManager& operator=(const GuiManager&) = delete;
+		~GuiManager();
+
+		void				preload(bool background);
+		bool				isAvailable(const std::string& name);
+		IGui*				open(const std::string& name, int width, int height);
+		void				close();
+		IGui*				current() const;
+		const std::string&	currentName() const;
+
+	private:
+		/**
+		 * @brief Une bibliothèque de GUI et ses fonctions exportées.
+		 */
+		struct Plugin
+		{
+			std::string		name;		///< Nom de la GUI.
+			SharedLibrary	library;	///< Bibliothèque chargée.
+			CreateGuiFunc	create;		///< createGui() de la bibliothèque.
+			DestroyGuiFunc	destroy;	///< destroyGui() de la bibliothèque.
+			bool			attempted;	///< Le chargement a été tenté.
+			std::string		error;		///< Erreur de chargement, vide en cas de succès.
+		};
+
+		Plugin&	find(const std::string& name);
+		void	load(Plugin& plugin) const;
+		void	waitForLoader();
+		void	restoreTerminal() const;
+
+		std::string			_directory;		///< Dossier des bibliothèques.
+		std::vector<Plugin>	_plugins;		///< Une entrée par GUI connue.
+		std::thread			_loader;		///< Chargement en arrière-plan (preload()).
+		IGui*				_current;		///< GUI ouverte, nulle sinon.
+		Plugin*				_currentPlugin;	///< Bibliothèque de la GUI ouverte.
+		struct termios		_terminal;		///< Réglages du terminal au démarrage.
+		bool				_hasTerminal;	///< L'entrée standard est un terminal.
+};
@@ -0,0 +1,115 @@
+/**
+ * @file Headless.cpp
+ * @brief Implémentation de la boucle de simulation sans affichage.
+ */
+
+#include "Headless.hpp"
+#include "GameState.hpp"
+#include <chrono>
+#include <sys/resource.h>
+
+/**
+ * @brief Pic de mémoire résidente du processus, en kilo-octets.
+ */
+long peakRssKb()
+{
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024; // octets sur macOS
+#else
+	return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * @brief Simule `config.ticks` ticks aussi vite que possible.
+ *
+ * Chaque tick lit une entrée, met à jour la partie, en capture un instantané
+ * et appelle le rendu de la GUI (en pratique la GUI nulle). Avec un
+ * contrôleur, c'est lui qui choisit la direction (la GUI ne sert plus qu'à
+ * quitter) et son temps de décision est mesuré à part. Quand une partie se termine, une nouvelle
+ * commence avec la graine suivante ; sa création n'est pas comptée dans la
+ * latence des ticks. Une entrée EXIT arrête la boucle.
+ *
+ * @param gui GUI fournissant les entrées (déjà initialisée).
+ * @param config Paramètres du plateau et nombre de ticks.
+ * @return Les mesures de débit, de latence et de mémoire.
+ */
+HeadlessReport runHeadless(IGui& gui, const HeadlessConfig& config)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	HeadlessReport report;
+	report.ticks = 0;
+	report.games = 1;
+	report.bestScore = 0;
+
+	uint64_t seed = config.seed;
+	GameState game(config.width, config.height, config.obstacles, seed);
+	game.setScoreLimit(config.scoreLimit);
+	Frame frame;
+	Clock::time_point begin = Clock::now();
+
+	while (report.ticks < config.ticks)
+	{
+		Clock::time_point start = Clock::now();
+		Input input = gui.getInput();
+		if (input == Input::EXIT)
+			break;
+		if (config.controller)
+		{
+			Clock::time_point planStart = Clock::now();
+			game.queueDirection(config.controller->nextInput(game));
+			report.planNs.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				Clock::now() - planStart).count());
+		}
+		else
+			game.setDirection(input);
+		game.update();
+		frame.capture(game, report.ticks, 0);
+		gui.render(frame);
+		report.tickNs.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			Clock::now() - start).count());
+		++report.ticks;
+		if (game.getScore() > report.bestScore)
+			report.bestScore = game.getScore();
+
+		if (game.isFinished() && report.ticks < config.ticks)
+		{
+			game = GameState(config.width, config.height, config.obstacles, Rng::splitmix64(seed));
+			game.setScoreLimit(config.scoreLimit);
+			++report.games;
+		}
+	}
+	report.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+	report.peakRssKb = peakRssKb();
+	return report;
+}
+
+/**
+ * @brief Affiche un rapport d'exécution, une mesure par ligne (`clé: valeur`).
+ *
+ * @param report Résultats à afficher.
+ * @param out Flux de sortie.
+ */
+void printHeadlessReport(const HeadlessReport& report, std::ostream& out)
+{
+	double rate = report.seconds > 0 ? report.ticks / report.seconds : 0;
+
+	out << "ticks: " << report.ticks << "\n"
+	    << "games: " << report.games << "\n"
+	    << "seconds: " << report.seconds << "\n"
+	    << "ticks_per_sec: " << static_cast<uint64_t>(rate) << "\n"
+	    << "tick_p50_ns: " << report.tickNs.percentile(50) << "\n"
+	    << "tick_p99_ns: " << report.tickNs.percentile(99) << "\n"
+	    << "tick_max_ns: " << report.tickNs.getMax() << "\n"
+	    << "best_score: " << report.bestScore << "\n";
+	if (report.planNs.getCount() > 0)
+		out << "plan_p50_ns: " << report.planNs.percentile(50) << "\n"
+		    << "plan_p99_ns: " << report.planNs.percentile(99) << "\n"
+		    << "plan_max_ns: " << report.planNs.getMax() << "\n";
+	out << "peak_rss_kb: " << report.peakRssKb << "\n";
+}
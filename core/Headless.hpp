@@ -0,0 +1,47 @@
+/**
+ * @file Headless.hpp
+ * @brief Boucle de simulation sans affichage, à vitesse maximale.
+ *
+ * Utilisée par l'option `--headless` : la partie avance aussi vite que
+ * possible (sans pause entre les ticks) pour mesurer le débit du moteur.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include "Histogram.hpp"
+#include "../includes/IController.hpp"
+#include "../includes/IGui.hpp"
+
+/**
+ * @brief Paramètres d'une exécution sans affichage.
+ */
+struct HeadlessConfig
+{
+	int			width;		///< Largeur du plateau.
+	int			height;		///< Hauteur du plateau.
+	bool		obstacles;	///< Active les obstacles.
+	uint64_t	seed;		///< Graine de la première partie.
+	uint64_t	ticks;		///< Nombre de ticks à simuler.
+	IController*	controller;	///< Joueur automatique (nul : directions de la GUI).
+	int			scoreLimit;	///< Score qui termine une partie (0 : jusqu'au plateau plein).
+};
+
+/**
+ * @brief Résultats d'une exécution sans affichage.
+ */
+struct HeadlessReport
+{
+	uint64_t	ticks;		///< Ticks effectivement simulés.
+	uint64_t	games;		///< Parties jouées (une nouvelle commence à chaque fin).
+	double		seconds;	///< Durée totale de la boucle.
+	Histogram	tickNs;		///< Latence de chaque tick (entrée + mise à jour + instantané + rendu).
+	Histogram	planNs;		///< Durée du choix de direction par le contrôleur (vide sans contrôleur).
+	int			bestScore;	///< Meilleur score atteint sur l'ensemble des parties.
+	long		peakRssKb;	///< Pic de mémoire résidente du processus.
+};
+
+HeadlessReport	runHeadless(IGui& gui, const HeadlessConfig& config);
+void			printHeadlessReport(const HeadlessReport& report, std::ostream& out);
+long			peakRssKb();
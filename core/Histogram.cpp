@@ -0,0 +1,183 @@
+/**
+ * @file Histogram.cpp
+ * @brief Implémentation de l'histogramme log-linéaire.
+ */
+
+#include "Histogram.hpp"
+#include <cstring>
+
+/**
+ * @brief Constructeur : histogramme vide.
+ */
+Histogram::Histogram()
+{
+	clear();
+}
+
+/**
+ * @brief Constructeur de copie.
+ */
+Histogram::Histogram(const Histogram& other)
+{
+	*this = other;
+}
+
+/**
+ * @brief Opérateur d'affectation.
+ */
+Histogram& Histogram::operator=(const Histogram& other)
+{
+	if (this != &other)
+	{
+		std::memcpy(counts, other.counts, sizeof(counts));
+		count = other.count;
+		sum = other.sum;
+		min = other.min;
+		max = other.max;
+	}
+	return *this;
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+Histogram::~Histogram() {}
+
+/**
+ * @brief Indice de l'intervalle contenant une valeur.
+ *
+ * Les valeurs inférieures à SUB_BUCKETS ont chacune leur intervalle ; au-delà,
+ * l'exposant donne l'octave et les SUB_BITS bits suivants l'intervalle.
+ */
+int Histogram::bucketOf(uint64_t value)
+{
+	if (value < static_cast<uint64_t>(SUB_BUCKETS))
+		return static_cast<int>(value);
+	int exponent = 63 - __builtin_clzll(value);
+	int sub = static_cast<int>((value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+	return (exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Plus petite valeur appartenant à un intervalle.
+ */
+uint64_t Histogram::lowerBound(int bucket)
+{
+	if (bucket < SUB_BUCKETS)
+		return static_cast<uint64_t>(bucket);
+	int exponent = bucket / SUB_BUCKETS + SUB_BITS - 1;
+	uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+	return (1ull << exponent) | (sub << (exponent - SUB_BITS));
+}
+
+/**
+ * @brief Enregistre une valeur.
+ *
+ * @param value Valeur mesurée (par exemple une durée en nanosecondes).
+ */
+void Histogram::record(uint64_t value)
+{
+	++counts[bucketOf(value)];
+	++count;
+	sum += value;
+	if (value < min)
+		min = value;
+	if (value > max)
+		max = value;
+}
+
+/**
+ * @brief Ajoute toutes les valeurs d'un autre histogramme.
+ */
+void Histogram::merge(const Histogram& other)
+{
+	for (int i = 0; i < BUCKETS; ++i)
+		counts[i] += other.counts[i];
+	count += other.count;
+	sum += other.sum;
+	if (other.min < min)
+		min = other.min;
+	if (other.max > max)
+		max = other.max;
+}
+
+/**
+ * @brief Vide l'histogramme.
+ */
+void Histogram::clear()
+{
+	std::memset(counts, 0, sizeof(counts));
+	count = 0;
+	sum = 0;
+	min = UINT64_MAX;
+	max = 0;
+}
+
+/**
+ * @brief Nombre de valeurs enregistrées.
+ */
+uint64_t Histogram::getCount() const
+{
+	return count;
+}
+
+/**
+ * @brief Plus petite valeur enregistrée (0 si vide).
+ */
+uint64_t Histogram::getMin() const
+{
+	return count ? min : 0;
+}
+
+/**
+ * @brief Plus grande valeur enregistrée.
+ */
+uint64_t Histogram::getMax() const
+{
+	return max;
+}
+
+/**
+ * @brief Moyenne exacte des valeurs enregistrées.
+ */
+double Histogram::getMean() const
+{
+	return count ? static_cast<double>(sum) / count : 0.0;
+}
+
+/**
+ * @brief Valeur approchée du percentile demandé.
+ *
+ * Retourne le milieu de l'intervalle contenant le percentile, borné par le
+ * minimum et le maximum réellement observés.
+ *
+ * @param p Percentile entre 0 et 100.
+ * @return La valeur du percentile (0 si l'histogramme est vide).
+ */
+uint64_t Histogram::percentile(double p) const
+{
+	if (count == 0)
+		return 0;
+
+	uint64_t rank = static_cast<uint64_t>(p / 100.0 * count);
+	if (rank >= count)
+		rank = count - 1;
+
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKETS; ++i)
+	{
+		seen += counts[i];
+		if (seen > rank)
+		{
+			uint64_t low = lowerBound(i);
+			uint64_t high = i + 1 < BUCKETS ? lowerBound(i + 1) : max;
+			uint64_t value = low + (high - low) / 2;
+			if (value < getMin())
+				value = getMin();
+			if (value > max)
+				value = max;
+			return value;
+		}
+	}
+	return max;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file Histogram.hpp
+ * @brief Déclaration de la classe Histogram, histogramme de durées de taille fixe.
+ *
+ * Permet de calculer des percentiles (p50, p99...) sur un nombre illimité de
+ * mesures sans jamais allouer après la construction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Histogramme log-linéaire de valeurs entières (des nanosecondes en pratique).
+ *
+ * Chaque puissance de deux est découpée en SUB_BUCKETS intervalles égaux :
+ * l'erreur relative d'un percentile est donc bornée (environ 6 %), de la
+ * nanoseconde jusqu'à plusieurs siècles.
+ */
+class Histogram
+{
+	public:
+		static const int SUB_BITS = 3;						///< log2 du nombre d'intervalles par octave.
+		static const int SUB_BUCKETS = 1 << SUB_BITS;		///< Intervalles par puissance de deux.
+		static const int BUCKETS = 64 * SUB_BUCKETS;		///< Nombre total d'intervalles.
+
+		Histogram();
+		Histogram(const Histogram& other);
+		Histogram& operator=(const Histogram& other);
+		~Histogram();
+
+		void		record(uint64_t value);
+		void		merge(const Histogram& other);
+		void		clear();
+		uint64_t	getCount() const;
+		uint64_t	getMin() const;
+		uint64_t	getMax() const;
+		double		getMean() const;
+		uint64_t	percentile(double p) const;
+
+	private:
+		static int		bucketOf(uint64_t value);
+		static uint64_t	lowerBound(int bucket);
+
+		uint64_t	counts[BUCKETS];	///< Nombre de valeurs par intervalle.
+		uint64_t	count;				///< Nombre total de valeurs.
+		uint64_t	sum;				///< Somme des valeurs (pour la moyenne).
+		uint64_t	min;				///< Plus petite valeur enregistrée.
+		uint64_t	max;				///< Plus grande valeur enregistrée.
+};
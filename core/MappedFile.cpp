@@ -0,0 +1,140 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implémentation de la classe MappedFile.
+ */
+
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * @brief Constructeur par défaut : aucun fichier projeté.
+ */
+MappedFile::MappedFile()
+	: _fd(-1), _data(nullptr), _size(0)
+{}
+
+/**
+ * @brief Projette un fichier en lecture seule.
+ *
+ * Un fichier vide est accepté (data() est alors nul et size() vaut 0).
+ *
+ * @param path Chemin du fichier.
+ * @throw std::runtime_error si le fichier ne peut pas être ouvert ou projeté.
+ */
+MappedFile::MappedFile(const std::string& path)
+	: _fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)), _data(nullptr), _size(0), _path(path)
+{
+	if (_fd < 0)
+		throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+
+	struct stat info;
+	if (fstat(_fd, &info) != 0)
+	{
+		int error = errno;
+		close();
+		throw std::runtime_error("Failed to stat " + path + ": " + std::strerror(error));
+	}
+	_size = static_cast<size_t>(info.st_size);
+	if (_size > 0)
+	{
+		void* address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+		if (address == MAP_FAILED)
+		{
+			int error = errno;
+			close();
+			throw std::runtime_error("Failed to map " + path + ": " + std::strerror(error));
+		}
+		_data = address;
+	}
+}
+
+/**
+ * @brief Constructeur de déplacement.
+ */
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: _fd(other._fd), _data(other._data), _size(other._size), _path(std::move(other._path))
+{
+	other._fd = -1;
+	other._data = nullptr;
+	other._size = 0;
+}
+
+/**
+ * @brief Affectation par déplacement : libère la projection courante.
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		_fd = other._fd;
+		_data = other._data;
+		_size = other._size;
+		_path = std::move(other._path);
+		other._fd = -1;
+		other._data = nullptr;
+		other._size = 0;
+	}
+	return *this;
+}
+
+/**
+ * @brief Destructeur : libère la projection et ferme le fichier.
+ */
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/**
+ * @brief Premier octet du fichier (nul si rien n'est projeté).
+ */
+const uint8_t* MappedFile::data() const
+{
+	return static_cast<const uint8_t*>(_data);
+}
+
+/**
+ * @brief Taille du fichier en octets.
+ */
+size_t MappedFile::size() const
+{
+	return _size;
+}
+
+/**
+ * @brief Chemin du fichier.
+ */
+const std::string& MappedFile::getPath() const
+{
+	return _path;
+}
+
+/**
+ * @brief Descripteur du fichier, ouvert en lecture seule (-1 s'il est fermé).
+ */
+int MappedFile::getDescriptor() const
+{
+	return _fd;
+}
+
+/**
+ * @brief Libère la projection et ferme le fichier (sans effet si rien n'est ouvert).
+ */
+void MappedFile::close()
+{
+	if (_data)
+		munmap(_data, _size);
+	if (_fd >= 0)
+		::close(_fd);
+	_fd = -1;
+	_data = nullptr;
+	_size = 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Déclaration de la classe MappedFile, fichier projeté en mémoire en lecture seule.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Projette un fichier entier en mémoire (mmap) et le libère à sa destruction.
+ *
+ * Les pages ne sont lues qu'à leur premier accès : ouvrir un gros fichier
+ * ne coûte rien tant qu'il n'est pas parcouru. Le fichier reste ouvert
+ * pour que des parties puissent en être projetées ailleurs (getDescriptor()).
+ * Non copiable ; peut être déplacé.
+ */
+class MappedFile
+{
+	public:
+		MappedFile();
+		explicit MappedFile(const std::string& path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		const uint8_t*		data() const;
+		size_t				size() const;
+		const std::string&	getPath() const;
+		int					getDescriptor() const;
+		void				close();
+
+	private:
+		int			_fd;	///< Descripteur du fichier (-1 si fermé), pour d'autres projections.
+		void*		_data;	///< Adresse de la projection, nulle si rien n'est projeté.
+		size_t		_size;	///< Taille du fichier en octets.
+		std::string	_path;	///< Chemin du fichier.
+};
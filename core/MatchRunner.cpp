@@ -0,0 +1,201 @@
+/**
+ * @file MatchRunner.cpp
+ * @brief Implémentation du tournoi de parties en parallèle.
+ */
+
+#include "MatchRunner.hpp"
+#include "GameState.hpp"
+#include "Rng.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+	/**
+	 * @brief Compteurs partagés du tournoi, mis à jour par opérations atomiques.
+	 */
+	struct MatchTotals
+	{
+		std::atomic<uint64_t>	ticks;
+		std::atomic<uint64_t>	wins;
+		std::atomic<uint64_t>	totalScore;
+		std::atomic<uint64_t>	bestScore;
+		std::atomic<uint64_t>	checksum;
+	};
+
+	/**
+	 * @brief Indique si la tête peut entrer dans une case sans mourir.
+	 */
+	bool isSafe(const GameState& state, const Point& p)
+	{
+		const Grid& grid = state.getGrid();
+		if (!grid.contains(p))
+			return false;
+		Cell cell = grid.at(p);
+		return cell == Cell::EMPTY || cell == Cell::FOOD;
+	}
+
+	/**
+	 * @brief Joueur glouton : se rapproche de la nourriture par une case sûre.
+	 *
+	 * Parmi les directions qui ne mènent pas à une collision immédiate, choisit
+	 * celle qui rapproche le plus de la nourriture ; de temps en temps, une
+	 * direction sûre au hasard pour varier les parties.
+	 *
+	 * @param state Partie en cours.
+	 * @param rng Flux aléatoire propre à la partie.
+	 * @return L'entrée à jouer (NONE s'il n'existe aucune case sûre).
+	 */
+	Input chooseInput(const GameState& state, Rng& rng)
+	{
+		static const Input inputs[] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };
+		static const int dx[] = { 0, 0, -1, 1 };
+		static const int dy[] = { -1, 1, 0, 0 };
+
+		const Point& head = state.getSnake().getHead();
+		const Point& food = state.getFood();
+		int current = static_cast<int>(state.getSnake().getDirection());
+		int safe[4];
+		int safeCount = 0;
+		int best = -1;
+		int bestDistance = 0;
+
+		for (int d = 0; d < 4; ++d)
+		{
+			Point next(head.x + dx[d], head.y + dy[d]);
+			if (d == (current ^ 1) || !isSafe(state, next))
+				continue;
+			safe[safeCount++] = d;
+			int distance = std::abs(food.x - next.x) + std::abs(food.y - next.y);
+			if (best < 0 || distance < bestDistance)
+			{
+				best = d;
+				bestDistance = distance;
+			}
+		}
+		if (safeCount == 0)
+			return Input::NONE;
+		if (rng.bounded(8) == 0)
+			return inputs[safe[rng.bounded(safeCount)]];
+		return inputs[best];
+	}
+
+	/**
+	 * @brief Remplace `target` par `value` si celle-ci est plus grande.
+	 */
+	void atomicMax(std::atomic<uint64_t>& target, uint64_t value)
+	{
+		uint64_t current = target.load(std::memory_order_relaxed);
+		while (current < value
+			&& !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			;
+	}
+
+	/**
+	 * @brief Joue une partie complète et ajoute son résultat aux totaux.
+	 */
+	void playMatch(const MatchConfig& config, uint64_t match, MatchTotals& totals)
+	{
+		uint64_t seed = matchSeed(config.seed, match);
+		GameState state(config.width, config.height, config.obstacles, seed);
+		state.setScoreLimit(config.scoreLimit);
+		Rng rng(~seed);
+		uint64_t ticks = 0;
+
+		for (; ticks < config.maxTicks && !state.isFinished(); ++ticks)
+		{
+			state.setDirection(chooseInput(state, rng));
+			state.update();
+		}
+
+		uint64_t score = static_cast<uint64_t>(state.getScore());
+		uint64_t mix = match ^ (score << 32) ^ (ticks << 48);
+		totals.ticks.fetch_add(ticks, std::memory_order_relaxed);
+		totals.totalScore.fetch_add(score, std::memory_order_relaxed);
+		totals.checksum.fetch_add(Rng::splitmix64(mix), std::memory_order_relaxed);
+		if (state.isWon())
+			totals.wins.fetch_add(1, std::memory_order_relaxed);
+		atomicMax(totals.bestScore, score);
+	}
+}
+
+/**
+ * @brief Graine de la partie d'indice donné d'un tournoi.
+ *
+ * @param seed Graine du tournoi.
+ * @param match Indice de la partie.
+ * @return Une graine propre à la partie, indépendante de l'ordre d'exécution.
+ */
+uint64_t matchSeed(uint64_t seed, uint64_t match)
+{
+	uint64_t state = seed + match * 0x9E3779B97F4A7C15ull;
+	return Rng::splitmix64(state);
+}
+
+/**
+ * @brief Joue `config.matches` parties sur les threads du pool.
+ *
+ * Chaque partie est une tâche ; les threads inactifs volent les parties en
+ * attente des autres, ce qui équilibre la charge malgré des durées de partie
+ * très variables. Les totaux sont mis à jour par opérations atomiques.
+ *
+ * @param pool Pool de threads (son temps d'activité est remis à zéro).
+ * @param config Paramètres du tournoi.
+ * @return Les totaux, le débit et l'utilisation de chaque thread.
+ */
+MatchReport runMatches(ThreadPool& pool, const MatchConfig& config)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	MatchTotals totals;
+	totals.ticks = 0;
+	totals.wins = 0;
+	totals.totalScore = 0;
+	totals.bestScore = 0;
+	totals.checksum = 0;
+
+	pool.resetBusy();
+	Clock::time_point begin = Clock::now();
+	for (uint64_t match = 0; match < config.matches; ++match)
+		pool.submit([&config, &totals, match] { playMatch(config, match, totals); });
+	pool.wait();
+	double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+	MatchReport report;
+	report.matches = config.matches;
+	report.ticks = totals.ticks;
+	report.wins = totals.wins;
+	report.totalScore = totals.totalScore;
+	report.bestScore = totals.bestScore;
+	report.checksum = totals.checksum;
+	report.seconds = seconds;
+	for (unsigned i = 0; i < pool.getThreadCount(); ++i)
+		report.utilization.push_back(seconds > 0 ? pool.getBusyNs(i) * 1e-9 / seconds : 0);
+	return report;
+}
+
+/**
+ * @brief Affiche un rapport de tournoi, une mesure par ligne (`clé: valeur`).
+ *
+ * @param report Résultats à afficher.
+ * @param out Flux de sortie.
+ */
+void printMatchReport(const MatchReport& report, std::ostream& out)
+{
+	double rate = report.seconds > 0 ? report.matches / report.seconds : 0;
+	double mean = report.matches > 0 ? static_cast<double>(report.totalScore) / report.matches : 0;
+
+	out << "matches: " << report.matches << "\n"
+	    << "threads: " << report.utilization.size() << "\n"
+	    << "seconds: " << report.seconds << "\n"
+	    << "games_per_sec: " << rate << "\n"
+	    << "ticks_per_sec: " << static_cast<uint64_t>(report.seconds > 0 ? report.ticks / report.seconds : 0) << "\n"
+	    << "wins: " << report.wins << "\n"
+	    << "mean_score: " << mean << "\n"
+	    << "best_score: " << report.bestScore << "\n"
+	    << "checksum: " << std::hex << report.checksum << std::dec << "\n";
+	for (size_t i = 0; i < report.utilization.size(); ++i)
+		out << "thread_" << i << "_utilization: " << report.utilization[i] << "\n";
+}
@@ -0,0 +1,50 @@
+/**
+ * @file MatchRunner.hpp
+ * @brief Exécution en parallèle de nombreuses parties indépendantes (tournoi).
+ *
+ * Utilisée par l'option `--matches` : chaque partie est une tâche du pool de
+ * threads (ThreadPool), avec sa propre graine et ses propres flux aléatoires.
+ * Les résultats sont agrégés sans verrou et ne dépendent que de la graine du
+ * tournoi, quel que soit le nombre de threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Paramètres d'un tournoi.
+ */
+struct MatchConfig
+{
+	int			width;		///< Largeur du plateau.
+	int			height;		///< Hauteur du plateau.
+	bool		obstacles;	///< Active les obstacles.
+	uint64_t	seed;		///< Graine du tournoi (les graines des parties en dérivent).
+	uint64_t	matches;	///< Nombre de parties à jouer.
+	uint64_t	maxTicks;	///< Ticks au-delà desquels une partie est abandonnée.
+	int			scoreLimit;	///< Score qui termine une partie (0 : jusqu'au plateau plein).
+};
+
+/**
+ * @brief Résultats agrégés d'un tournoi.
+ */
+struct MatchReport
+{
+	uint64_t				matches;		///< Parties jouées.
+	uint64_t				ticks;			///< Ticks simulés, toutes parties confondues.
+	uint64_t				wins;			///< Parties gagnées (score limite ou plateau plein).
+	uint64_t				totalScore;		///< Somme des scores.
+	uint64_t				bestScore;		///< Meilleur score.
+	uint64_t				checksum;		///< Empreinte des résultats, indépendante de l'ordre.
+	double					seconds;		///< Durée du tournoi.
+	std::vector<double>		utilization;	///< Part du temps passée à jouer, par thread.
+};
+
+uint64_t	matchSeed(uint64_t seed, uint64_t match);
+MatchReport	runMatches(ThreadPool& pool, const MatchConfig& config);
+void		printMatchReport(const MatchReport& report, std::ostream& out);
@@ -0,0 +1,149 @@
+/**
+ * @file ObstacleGenerator.cpp
+ * @brief Implémentation du tirage des obstacles par bandes.
+ */
+
+#include "ObstacleGenerator.hpp"
+#include "Rng.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+	const int BAND_ROWS = 64;	///< Nombre de lignes par bande.
+
+	/**
+	 * @brief Compte les cases libres d'une bande.
+	 */
+	size_t countFree(const Grid& grid, int firstRow, int lastRow)
+	{
+		const Cell* cells = grid.getRow(firstRow);
+		size_t size = static_cast<size_t>(lastRow - firstRow) * grid.getWidth();
+		size_t count = 0;
+
+		for (size_t i = 0; i < size; ++i)
+			count += cells[i] == Cell::EMPTY;
+		return count;
+	}
+
+	/**
+	 * @brief Choisit `need` cases libres parmi les `available` d'une bande.
+	 *
+	 * Les rangs retenus sont tirés par l'algorithme de Floyd dans un bitset de
+	 * `available` bits (un tirage par obstacle, tous les sous-ensembles de
+	 * taille `need` équiprobables), puis un seul parcours de la bande associe
+	 * chaque rang à sa case libre.
+	 */
+	void selectInBand(const Grid& grid, int firstRow, int lastRow, size_t available,
+		size_t need, uint64_t seed, std::vector<Point>& out)
+	{
+		if (need == 0)
+			return;
+
+		Rng rng(seed);
+		std::vector<uint64_t> chosen((available + 63) / 64, 0);
+
+		for (size_t j = available - need; j < available; ++j)
+		{
+			size_t t = rng.bounded(j + 1);
+			size_t bit = (chosen[t / 64] >> (t % 64)) & 1 ? j : t;
+			chosen[bit / 64] |= 1ull << (bit % 64);
+		}
+
+		out.reserve(need);
+		size_t rank = 0;
+		for (int y = firstRow; y < lastRow; ++y)
+		{
+			const Cell* row = grid.getRow(y);
+			for (int x = 0; x < grid.getWidth(); ++x)
+			{
+				if (row[x] != Cell::EMPTY)
+					continue;
+				if ((chosen[rank / 64] >> (rank % 64)) & 1)
+					out.push_back(Point(x, y));
+				++rank;
+			}
+		}
+	}
+
+	/**
+	 * @brief Exécute `job(band)` pour chaque bande, éventuellement sur plusieurs threads.
+	 */
+	template <typename Job>
+	void forEachBand(size_t bands, unsigned threads, const Job& job)
+	{
+		if (threads <= 1 || bands <= 1)
+		{
+			for (size_t band = 0; band < bands; ++band)
+				job(band);
+			return;
+		}
+		std::vector<std::thread> workers;
+		for (unsigned t = 0; t < threads && t < bands; ++t)
+		{
+			workers.emplace_back([&, t]()
+			{
+				for (size_t band = t; band < bands; band += threads)
+					job(band);
+			});
+		}
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+}
+
+/**
+ * @brief Tire `count` cases libres distinctes de la grille.
+ *
+ * Les quotas par bande sont calculés à partir des cumuls de cases libres,
+ * de sorte que leur somme vaut exactement `count`. Chaque bande dérive son
+ * flux aléatoire de la graine et de son numéro.
+ *
+ * @param grid Grille d'occupation, seules ses cases vides sont candidates.
+ * @param count Nombre d'obstacles voulus (ramené au nombre de cases libres).
+ * @param seed Graine du tirage.
+ * @param threads Nombre de threads à utiliser (1 pour un tirage séquentiel).
+ * @return Les positions choisies, ligne par ligne.
+ */
+std::vector<Point> sampleObstacles(const Grid& grid, size_t count, uint64_t seed, unsigned threads)
+{
+	size_t bands = (grid.getHeight() + BAND_ROWS - 1) / BAND_ROWS;
+	std::vector<size_t> freePerBand(bands);
+	std::vector<std::vector<Point>> picked(bands);
+
+	forEachBand(bands, threads, [&](size_t band)
+	{
+		int first = static_cast<int>(band) * BAND_ROWS;
+		freePerBand[band] = countFree(grid, first, std::min(first + BAND_ROWS, grid.getHeight()));
+	});
+
+	size_t totalFree = 0;
+	for (size_t free : freePerBand)
+		totalFree += free;
+	if (count > totalFree)
+		count = totalFree;
+
+	std::vector<size_t> quota(bands);
+	size_t cumulated = 0;
+	for (size_t band = 0; band < bands; ++band)
+	{
+		size_t before = totalFree ? count * cumulated / totalFree : 0;
+		cumulated += freePerBand[band];
+		size_t after = totalFree ? count * cumulated / totalFree : 0;
+		quota[band] = after - before;
+	}
+
+	forEachBand(bands, threads, [&](size_t band)
+	{
+		int first = static_cast<int>(band) * BAND_ROWS;
+		uint64_t bandSeed = seed ^ (0xD1B54A32D192ED03ull * (band + 1));
+		selectInBand(grid, first, std::min(first + BAND_ROWS, grid.getHeight()),
+			freePerBand[band], quota[band], bandSeed, picked[band]);
+	});
+
+	std::vector<Point> result;
+	result.reserve(count);
+	for (const std::vector<Point>& band : picked)
+		result.insert(result.end(), band.begin(), band.end());
+	return result;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file ObstacleGenerator.hpp
+ * @brief Tirage des obstacles sans remise sur les cases libres du plateau.
+ *
+ * Le plateau est découpé en bandes de lignes. Chaque bande reçoit un quota
+ * d'obstacles proportionnel à son nombre de cases libres, puis choisit ses
+ * cases sans remise (algorithme de Floyd sur un bitset) avec son propre flux
+ * pseudo-aléatoire. Le coût est linéaire en la surface du plateau,
+ * les bandes peuvent être traitées en parallèle, et le résultat ne dépend que
+ * de la graine, pas du nombre de threads.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Grid.hpp"
+
+std::vector<Point>	sampleObstacles(const Grid& grid, size_t count, uint64_t seed, unsigned threads);
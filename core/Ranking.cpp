@@ -0,0 +1,113 @@
+/**
+ * @file Ranking.cpp
+ * @brief Implémentation du classement de joueurs automatiques.
+ */
+
+#include "Ranking.hpp"
+#include "GameState.hpp"
+#include "MatchRunner.hpp"
+#include "../includes/InputQueue.hpp"
+#include <algorithm>
+
+namespace
+{
+	/**
+	 * @brief Joue une partie avec un contrôleur et ajoute son résultat.
+	 */
+	void playGame(IController& controller, const RankingConfig& config, uint64_t game, RankingResult& result)
+	{
+		GameState state(config.width, config.height, config.obstacles, matchSeed(config.seed, game));
+		state.setScoreLimit(config.scoreLimit);
+		uint64_t ticks = 0;
+
+		for (; ticks < config.maxTicks && !state.isFinished(); ++ticks)
+		{
+			uint64_t start = InputQueue::now();
+			Input input = controller.nextInput(state);
+			result.decideNs.record(InputQueue::now() - start);
+			state.queueDirection(input);
+			state.update();
+		}
+
+		++result.games;
+		result.ticks += ticks;
+		result.totalScore += static_cast<uint64_t>(state.getScore());
+		result.bestScore = std::max(result.bestScore, state.getScore());
+		if (state.isWon())
+			++result.wins;
+	}
+
+	/**
+	 * @brief Score moyen d'un contrôleur.
+	 */
+	double meanScore(const RankingResult& result)
+	{
+		return result.games > 0 ? static_cast<double>(result.totalScore) / result.games : 0;
+	}
+}
+
+/**
+ * @brief Fait jouer `config.games` parties à chaque contrôleur, puis les classe.
+ *
+ * Tous les contrôleurs jouent les mêmes graines. Le rang par score suit le
+ * score moyen (à égalité, le plus de victoires, puis le moins de ticks) ;
+ * le rang par latence suit la durée médiane de décision, puis le p99.
+ *
+ * @param entries Contrôleurs à classer.
+ * @param config Paramètres des parties.
+ * @return Un résultat par contrôleur, du meilleur score au moins bon.
+ */
+std::vector<RankingResult> rankControllers(const std::vector<RankingEntry>& entries, const RankingConfig& config)
+{
+	std::vector<RankingResult> results(entries.size());
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		RankingResult& result = results[i];
+		result.name = entries[i].name;
+		result.games = 0;
+		result.wins = 0;
+		result.totalScore = 0;
+		result.bestScore = 0;
+		result.ticks = 0;
+		for (uint64_t game = 0; game < config.games; ++game)
+			playGame(*entries[i].controller, config, game, result);
+	}
+
+	std::vector<RankingResult*> order;
+	for (RankingResult& result : results)
+		order.push_back(&result);
+	std::stable_sort(order.begin(), order.end(), [](const RankingResult* a, const RankingResult* b) {
+		uint64_t a50 = a->decideNs.percentile(50), b50 = b->decideNs.percentile(50);
+		return a50 != b50 ? a50 < b50 : a->decideNs.percentile(99) < b->decideNs.percentile(99);
+	});
+	for (size_t i = 0; i < order.size(); ++i)
+		order[i]->latencyRank = i + 1;
+
+	std::stable_sort(results.begin(), results.end(), [](const RankingResult& a, const RankingResult& b) {
+		if (meanScore(a) != meanScore(b))
+			return meanScore(a) > meanScore(b);
+		return a.wins != b.wins ? a.wins > b.wins : a.ticks < b.ticks;
+	});
+	for (size_t i = 0; i < results.size(); ++i)
+		results[i].scoreRank = i + 1;
+	return results;
+}
+
+/**
+ * @brief Affiche le classement, une ligne CSV par contrôleur (du meilleur score au moins bon).
+ *
+ * @param results Résultats de rankControllers().
+ * @param out Flux de sortie.
+ */
+void printRanking(const std::vector<RankingResult>& results, std::ostream& out)
+{
+	out << "score_rank,latency_rank,controller,games,wins,mean_score,best_score,mean_ticks,"
+	    << "decide_p50_ns,decide_p99_ns,decide_max_ns\n";
+	for (const RankingResult& result : results)
+		out << result.scoreRank << "," << result.latencyRank << "," << result.name << "," << result.games << ","
+		    << result.wins << "," << meanScore(result) << "," << result.bestScore << ","
+		    << (result.games > 0 ? static_cast<double>(result.ticks) / result.games : 0) << ","
+		    << result.decideNs.percentile(50) << "," << result.decideNs.percentile(99) << ","
+		    << result.decideNs.getMax() << "\n";
+}
@@ -0,0 +1,61 @@
+/**
+ * @file Ranking.hpp
+ * @brief Classement de joueurs automatiques sur les mêmes parties.
+ *
+ * Utilisé par l'option `--rank` : chaque contrôleur joue la même série de
+ * parties (mêmes graines que le tournoi, voir matchSeed()), l'une après
+ * l'autre sur le thread appelant pour que les temps de décision ne se
+ * gênent pas. Les contrôleurs sont ensuite classés par score, puis par
+ * latence de décision.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Histogram.hpp"
+#include "../includes/IController.hpp"
+
+/**
+ * @brief Un contrôleur à classer.
+ */
+struct RankingEntry
+{
+	std::string		name;		///< Nom affiché (chemin de la bibliothèque, ou nom du joueur intégré).
+	IController*	controller;	///< Contrôleur (non possédé).
+};
+
+/**
+ * @brief Paramètres d'un classement.
+ */
+struct RankingConfig
+{
+	int			width;		///< Largeur du plateau.
+	int			height;		///< Hauteur du plateau.
+	bool		obstacles;	///< Active les obstacles.
+	uint64_t	seed;		///< Graine de la série (les graines des parties en dérivent).
+	uint64_t	games;		///< Parties jouées par chaque contrôleur.
+	uint64_t	maxTicks;	///< Ticks au-delà desquels une partie est abandonnée.
+	int			scoreLimit;	///< Score qui termine une partie (0 : jusqu'au plateau plein).
+};
+
+/**
+ * @brief Résultats d'un contrôleur.
+ */
+struct RankingResult
+{
+	std::string	name;			///< Nom du contrôleur.
+	uint64_t	games;			///< Parties jouées.
+	uint64_t	wins;			///< Parties gagnées (score limite ou plateau plein).
+	uint64_t	totalScore;		///< Somme des scores.
+	int			bestScore;		///< Meilleur score.
+	uint64_t	ticks;			///< Ticks joués, toutes parties confondues.
+	Histogram	decideNs;		///< Durée de chaque appel à nextInput().
+	size_t		scoreRank;		///< Rang par score moyen, puis victoires et ticks (1 : le meilleur).
+	size_t		latencyRank;	///< Rang par latence médiane, puis p99 (1 : le plus rapide).
+};
+
+std::vector<RankingResult>	rankControllers(const std::vector<RankingEntry>& entries, const RankingConfig& config);
+void						printRanking(const std::vector<RankingResult>& results, std::ostream& out);
@@ -0,0 +1,366 @@
+/**
+ * @file Replay.cpp
+ * @brief Implémentation de l'enregistrement et de la relecture des parties.
+ */
+
+#include "Replay.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	const char		MAGIC[4] = { 'N', 'I', 'B', 'R' };	///< Signature du fichier.
+	const uint8_t	VERSION = 2;						///< Version du format (2 : croissance par la tête, score limite).
+	const uint64_t	CODES = 5;							///< Codes d'entrée (quatre directions et l'aide).
+	const uint8_t	OBSTACLES_FLAG = 1;					///< Bit des options : obstacles activés.
+
+	/**
+	 * @brief Ajoute un entier little-endian de `bytes` octets.
+	 */
+	void putInt(std::vector<uint8_t>& out, uint64_t value, int bytes)
+	{
+		for (int i = 0; i < bytes; ++i)
+			out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+	}
+
+	/**
+	 * @brief Lit un entier little-endian de `bytes` octets.
+	 */
+	uint64_t getInt(const uint8_t* in, int bytes)
+	{
+		uint64_t value = 0;
+		for (int i = 0; i < bytes; ++i)
+			value |= static_cast<uint64_t>(in[i]) << (8 * i);
+		return value;
+	}
+
+	/**
+	 * @brief Ajoute un entier en varint (7 bits par octet, bit de poids fort : suite).
+	 */
+	void putVarint(std::vector<uint8_t>& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	/**
+	 * @brief Code d'une entrée dans le fichier.
+	 */
+	uint64_t inputCode(Input input)
+	{
+		switch (input)
+		{
+			case Input::UP:    return 0;
+			case Input::DOWN:  return 1;
+			case Input::LEFT:  return 2;
+			case Input::RIGHT: return 3;
+			default:           return 4;
+		}
+	}
+}
+
+/**
+ * @brief Indique si une entrée modifie la partie et doit être enregistrée.
+ *
+ * @param input Entrée reçue.
+ * @return true pour les quatre directions et le menu d'aide.
+ */
+bool isReplayInput(Input input)
+{
+	return input == Input::UP || input == Input::DOWN || input == Input::LEFT
+		|| input == Input::RIGHT || input == Input::HELP;
+}
+
+/**
+ * @brief Applique une entrée enregistrée comme la simulation l'a fait.
+ *
+ * HELP bascule le menu d'aide ; une direction est mise en attente, sauf
+ * pendant le menu d'aide.
+ *
+ * @param game Partie rejouée.
+ * @param input Entrée enregistrée.
+ */
+void applyReplayInput(GameState& game, Input input)
+{
+	if (input == Input::HELP)
+		game.toggleHelpMenu();
+	else if (!game.isHelpMenuActive())
+		game.queueDirection(input);
+}
+
+/**
+ * @brief Prépare l'enregistrement d'une partie.
+ *
+ * @param header Paramètres de la partie.
+ */
+ReplayWriter::ReplayWriter(const ReplayHeader& header)
+	: _header(header), _count(0), _lastTick(0)
+{}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+ReplayWriter::~ReplayWriter() {}
+
+/**
+ * @brief Ajoute une entrée prise en compte avant le tick `tick + 1`.
+ *
+ * @param tick Ticks joués au moment de l'entrée (jamais inférieur à celui de l'entrée précédente).
+ * @param input Direction ou HELP ; les autres entrées sont ignorées.
+ * @throw std::runtime_error si les ticks ne sont pas croissants.
+ */
+void ReplayWriter::record(uint64_t tick, Input input)
+{
+	if (!isReplayInput(input))
+		return;
+	if (tick < _lastTick)
+		throw std::runtime_error("Replay records must be in tick order");
+	putVarint(_records, (tick - _lastTick) * CODES + inputCode(input));
+	_lastTick = tick;
+	++_count;
+}
+
+/**
+ * @brief Nombre d'entrées enregistrées.
+ */
+uint64_t ReplayWriter::getRecordCount() const
+{
+	return _count;
+}
+
+/**
+ * @brief Écrit l'enregistrement avec le résultat de la partie.
+ *
+ * @param path Chemin du fichier.
+ * @param ticks Ticks joués.
+ * @param last État final de la partie (score et empreinte).
+ * @throw std::runtime_error si le fichier ne peut pas être écrit.
+ */
+void ReplayWriter::save(const std::string& path, uint64_t ticks, const GameState& last) const
+{
+	std::vector<uint8_t> header;
+	header.insert(header.end(), MAGIC, MAGIC + sizeof(MAGIC));
+	putInt(header, VERSION, 1);
+	putInt(header, _header.obstacles ? OBSTACLES_FLAG : 0, 1);
+	putInt(header, static_cast<uint32_t>(_header.width), 4);
+	putInt(header, static_cast<uint32_t>(_header.height), 4);
+	putInt(header, _header.seed, 8);
+	putInt(header, _header.tickRate, 4);
+	putInt(header, _header.scoreLimit, 4);
+	putInt(header, ticks, 8);
+	putInt(header, static_cast<uint32_t>(last.getScore()), 4);
+	putInt(header, last.hash(), 8);
+	putInt(header, _count, 8);
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+		throw std::runtime_error("Failed to open " + path);
+	file.write(reinterpret_cast<const char*>(header.data()), header.size());
+	file.write(reinterpret_cast<const char*>(_records.data()), _records.size());
+	if (!file)
+		throw std::runtime_error("Failed to write " + path);
+}
+
+/**
+ * @brief Ouvre un enregistrement et valide son en-tête.
+ *
+ * @param path Chemin du fichier.
+ * @throw std::runtime_error si le fichier est illisible, d'un autre format
+ *        ou d'une autre version, ou décrit un plateau invalide (côtés hors
+ *        de [REPLAY_MIN_SIZE, REPLAY_MAX_SIZE]).
+ */
+ReplayReader::ReplayReader(const std::string& path)
+	: _file(path), _offset(REPLAY_HEADER_SIZE), _read(0), _tick(0)
+{
+	const uint8_t* data = _file.data();
+	if (_file.size() < REPLAY_HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+		throw std::runtime_error(path + " is not a nibbler replay");
+	if (data[4] != VERSION)
+		throw std::runtime_error(path + ": unsupported replay version " + std::to_string(data[4]));
+
+	_header.obstacles = (data[5] & OBSTACLES_FLAG) != 0;
+	uint64_t width = getInt(data + 6, 4);
+	uint64_t height = getInt(data + 10, 4);
+	_header.seed = getInt(data + 14, 8);
+	_header.tickRate = static_cast<uint32_t>(getInt(data + 22, 4));
+	_header.scoreLimit = static_cast<uint32_t>(getInt(data + 26, 4));
+	_ticks = getInt(data + 30, 8);
+	_score = static_cast<int>(getInt(data + 38, 4));
+	_hash = getInt(data + 42, 8);
+	_count = getInt(data + 50, 8);
+	if (width < REPLAY_MIN_SIZE || width > REPLAY_MAX_SIZE || height < REPLAY_MIN_SIZE || height > REPLAY_MAX_SIZE)
+		throw std::runtime_error(path + ": invalid replay board size");
+	if (_header.tickRate == 0 || _header.scoreLimit > static_cast<uint32_t>(INT32_MAX))
+		throw std::runtime_error(path + ": invalid replay parameters");
+	_header.width = static_cast<int>(width);
+	_header.height = static_cast<int>(height);
+}
+
+/**
+ * @brief Destructeur : libère la projection.
+ */
+ReplayReader::~ReplayReader() {}
+
+/**
+ * @brief Paramètres de la partie enregistrée.
+ */
+const ReplayHeader& ReplayReader::getHeader() const
+{
+	return _header;
+}
+
+/**
+ * @brief Ticks joués par la partie enregistrée.
+ */
+uint64_t ReplayReader::getTicks() const
+{
+	return _ticks;
+}
+
+/**
+ * @brief Score final de la partie enregistrée.
+ */
+int ReplayReader::getScore() const
+{
+	return _score;
+}
+
+/**
+ * @brief Empreinte de l'état final de la partie enregistrée.
+ */
+uint64_t ReplayReader::getHash() const
+{
+	return _hash;
+}
+
+/**
+ * @brief Nombre d'entrées enregistrées.
+ */
+uint64_t ReplayReader::getRecordCount() const
+{
+	return _count;
+}
+
+/**
+ * @brief Taille du fichier en octets.
+ */
+size_t ReplayReader::getFileSize() const
+{
+	return _file.size();
+}
+
+/**
+ * @brief Décode l'entrée suivante.
+ *
+ * @param record [out] Entrée lue.
+ * @return false une fois toutes les entrées lues.
+ * @throw std::runtime_error si le fichier est tronqué.
+ */
+bool ReplayReader::next(ReplayRecord& record)
+{
+	if (_read == _count)
+		return false;
+
+	const uint8_t* data = _file.data();
+	uint64_t value = 0;
+	for (int shift = 0;; shift += 7)
+	{
+		if (_offset >= _file.size() || shift > 63)
+			throw std::runtime_error(_file.getPath() + ": truncated replay");
+		uint8_t byte = data[_offset++];
+		value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			break;
+	}
+
+	static const Input inputs[CODES] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT, Input::HELP };
+	_tick += value / CODES;
+	record.tick = _tick;
+	record.input = inputs[value % CODES];
+	++_read;
+	return true;
+}
+
+/**
+ * @brief Revient à la première entrée.
+ */
+void ReplayReader::rewind()
+{
+	_offset = REPLAY_HEADER_SIZE;
+	_read = 0;
+	_tick = 0;
+}
+
+/**
+ * @brief Rejoue la partie enregistrée aussi vite que possible, sans affichage.
+ *
+ * Les entrées d'un tick sont appliquées (voir applyReplayInput()) avant
+ * sa mise à jour, comme le fait la simulation. La relecture s'arrête au
+ * nombre de ticks enregistré, ou plus tôt si la partie se termine.
+ *
+ * @param reader Enregistrement (relu depuis sa première entrée).
+ * @return Résultat, comparé à celui de l'enregistrement.
+ */
+ReplayReport playReplay(ReplayReader& reader)
+{
+	const ReplayHeader& header = reader.getHeader();
+	GameState game(header.width, header.height, header.obstacles, header.seed);
+	game.setScoreLimit(static_cast<int>(header.scoreLimit));
+	ReplayReport report = { 0, 0, 0, 0, 0, false };
+	ReplayRecord record;
+
+	reader.rewind();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool pending = reader.next(record);
+	for (;;)
+	{
+		while (pending && record.tick == report.ticks)
+		{
+			applyReplayInput(game, record.input);
+			++report.records;
+			pending = reader.next(record);
+		}
+		// Le menu d'aide suspend la partie : il ne peut rester ouvert qu'à la fin
+		if (report.ticks >= reader.getTicks() || game.isFinished() || game.isHelpMenuActive())
+			break;
+		game.update();
+		++report.ticks;
+	}
+	report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	report.score = game.getScore();
+	report.hash = game.hash();
+	report.matches = !pending && report.ticks == reader.getTicks()
+		&& report.score == reader.getScore() && report.hash == reader.getHash();
+	return report;
+}
+
+/**
+ * @brief Affiche le résultat d'une relecture (une valeur par ligne, `clé: valeur`).
+ *
+ * @param reader Enregistrement rejoué.
+ * @param report Résultat de playReplay().
+ * @param out Flux de sortie.
+ */
+void printReplayReport(const ReplayReader& reader, const ReplayReport& report, std::ostream& out)
+{
+	const ReplayHeader& header = reader.getHeader();
+	double rate = report.seconds > 0 ? report.ticks / report.seconds : 0;
+
+	out << "seed: " << header.seed << "\n"
+	    << "board: " << header.width << "x" << header.height << (header.obstacles ? " obstacles" : "") << "\n"
+	    << "file_bytes: " << reader.getFileSize() << "\n"
+	    << "records: " << report.records << "/" << reader.getRecordCount() << "\n"
+	    << "ticks: " << report.ticks << "/" << reader.getTicks() << "\n"
+	    << "score: " << report.score << "/" << reader.getScore() << "\n"
+	    << "hash: " << std::hex << report.hash << "/" << reader.getHash() << std::dec << "\n"
+	    << "seconds: " << report.seconds << "\n"
+	    << "ticks_per_sec: " << static_cast<uint64_t>(rate) << "\n"
+	    << "result: " << (report.matches ? "match" : "MISMATCH") << "\n";
+}
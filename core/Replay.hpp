@@ -0,0 +1,133 @@
+/**
+ * @file Replay.hpp
+ * @brief Enregistrement d'une partie dans un fichier binaire compact et relecture.
+ *
+ * Une partie est entièrement déterminée par sa graine, son plateau et les
+ * entrées prises en compte à chaque tick : c'est tout ce que le fichier
+ * contient, avec le score et l'empreinte (GameState::hash()) de l'état
+ * final, qui permettent à la relecture de vérifier qu'elle a reproduit la
+ * partie.
+ *
+ * Format (entiers little-endian) :
+ * - en-tête de 58 octets : "NIBR", version (u8), options (u8, bit 0 :
+ *   obstacles), largeur (u32), hauteur (u32), graine (u64), ticks par
+ *   seconde (u32), score limite (u32, 0 : aucun), ticks joués (u64), score
+ *   final (u32), empreinte finale (u64), nombre d'entrées (u64) ;
+ * - une entrée par varint (LEB128) : `delta * 5 + code`, où delta est
+ *   l'écart en ticks avec l'entrée précédente et code 0 à 3 une direction
+ *   (UP, DOWN, LEFT, RIGHT), 4 le menu d'aide. Une entrée tient sur un
+ *   seul octet tant que les virages sont espacés de moins de 26 ticks.
+ */
+
+#pragma once
+
+#include "GameState.hpp"
+#include "MappedFile.hpp"
+#include "../includes/Input.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+const size_t REPLAY_HEADER_SIZE = 58;	///< Taille de l'en-tête d'un enregistrement, en octets.
+const int REPLAY_MIN_SIZE = 30;			///< Côté minimal d'un plateau enregistré (celui de la ligne de commande).
+const int REPLAY_MAX_SIZE = 10000;		///< Côté maximal d'un plateau enregistré.
+
+/**
+ * @brief Paramètres de la partie enregistrée.
+ */
+struct ReplayHeader
+{
+	int			width;		///< Largeur du plateau.
+	int			height;		///< Hauteur du plateau.
+	bool		obstacles;	///< Obstacles activés.
+	uint64_t	seed;		///< Graine de la partie.
+	uint32_t	tickRate;	///< Ticks par seconde lors de l'enregistrement (relecture en temps réel).
+	uint32_t	scoreLimit;	///< Score qui termine la partie (voir GameState::setScoreLimit()).
+};
+
+/**
+ * @brief Une entrée prise en compte par la partie.
+ */
+struct ReplayRecord
+{
+	uint64_t	tick;	///< Ticks joués avant l'entrée : elle s'applique avant le tick suivant.
+	Input		input;	///< Direction mise en attente, ou HELP.
+};
+
+/**
+ * @class ReplayWriter
+ * @brief Accumule les entrées d'une partie en mémoire et les écrit à la fin.
+ */
+class ReplayWriter
+{
+	public:
+		explicit ReplayWriter(const ReplayHeader& header);
+		ReplayWriter(const ReplayWriter&) = delete;
+		ReplayWriter& operator=(const ReplayWriter&) = delete;
+		~ReplayWriter();
+
+		void		record(uint64_t tick, Input input);
+		uint64_t	getRecordCount() const;
+		void		save(const std::string& path, uint64_t ticks, const GameState& last) const;
+
+	private:
+		ReplayHeader			_header;	///< Paramètres de la partie.
+		std::vector<uint8_t>	_records;	///< Entrées déjà encodées.
+		uint64_t				_count;		///< Nombre d'entrées.
+		uint64_t				_lastTick;	///< Tick de la dernière entrée.
+};
+
+/**
+ * @class ReplayReader
+ * @brief Lit un enregistrement projeté en mémoire, entrée par entrée.
+ *
+ * L'en-tête est validé à l'ouverture ; les entrées sont décodées à la
+ * demande, sans copie du fichier.
+ */
+class ReplayReader
+{
+	public:
+		explicit ReplayReader(const std::string& path);
+		ReplayReader(const ReplayReader&) = delete;
+		ReplayReader& operator=(const ReplayReader&) = delete;
+		~ReplayReader();
+
+		const ReplayHeader&	getHeader() const;
+		uint64_t			getTicks() const;
+		int					getScore() const;
+		uint64_t			getHash() const;
+		uint64_t			getRecordCount() const;
+		size_t				getFileSize() const;
+		bool				next(ReplayRecord& record);
+		void				rewind();
+
+	private:
+		MappedFile		_file;		///< Fichier projeté.
+		ReplayHeader	_header;	///< Paramètres de la partie.
+		uint64_t		_ticks;		///< Ticks joués.
+		int				_score;		///< Score final.
+		uint64_t		_hash;		///< Empreinte de l'état final.
+		uint64_t		_count;		///< Nombre d'entrées.
+		size_t			_offset;	///< Position de la prochaine entrée dans le fichier.
+		uint64_t		_read;		///< Entrées déjà lues.
+		uint64_t		_tick;		///< Tick de la dernière entrée lue.
+};
+
+/**
+ * @brief Résultat d'une relecture.
+ */
+struct ReplayReport
+{
+	uint64_t	ticks;		///< Ticks rejoués.
+	uint64_t	records;	///< Entrées appliquées.
+	int			score;		///< Score final obtenu.
+	uint64_t	hash;		///< Empreinte de l'état final obtenu.
+	double		seconds;	///< Durée de la relecture.
+	bool		matches;	///< Score, empreinte et nombre de ticks identiques à l'enregistrement.
+};
+
+bool			isReplayInput(Input input);
+void			applyReplayInput(GameState& game, Input input);
+ReplayReport	playReplay(ReplayReader& reader);
+void			printReplayReport(const ReplayReader& reader, const ReplayReport& report, std::ostream& out);
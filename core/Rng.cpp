@@ -0,0 +1,193 @@
+/**
+ * @file Rng.cpp
+ * @brief Implémentation du générateur xoshiro256**.
+ *
+ * Référence : D. Blackman et S. Vigna, « Scrambled linear pseudorandom
+ * number generators » (xoshiro256**, splitmix64).
+ */
+
+#include "Rng.hpp"
+#include <chrono>
+#include <random>
+
+/**
+ * @brief Rotation à gauche sur 64 bits.
+ */
+static inline uint64_t rotl(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Constructeur par défaut : graine nulle (état non nul grâce à splitmix64).
+ */
+Rng::Rng()
+{
+	seed(0);
+}
+
+/**
+ * @brief Construit un générateur à partir d'une graine de 64 bits.
+ *
+ * @param value Graine ; deux générateurs de même graine produisent la même suite.
+ */
+Rng::Rng(uint64_t value)
+{
+	seed(value);
+}
+
+/**
+ * @brief Constructeur de copie : la copie reprend la suite au même point.
+ */
+Rng::Rng(const Rng& other)
+{
+	setState(other.state);
+}
+
+/**
+ * @brief Opérateur d'affectation.
+ */
+Rng& Rng::operator=(const Rng& other)
+{
+	if (this != &other)
+		setState(other.state);
+	return *this;
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+Rng::~Rng() {}
+
+/**
+ * @brief Réinitialise le générateur à partir d'une graine.
+ *
+ * Les quatre mots d'état sont dérivés de la graine par splitmix64, ce qui
+ * garantit un état bien mélangé même pour des graines voisines.
+ *
+ * @param value Graine.
+ */
+void Rng::seed(uint64_t value)
+{
+	for (int i = 0; i < STATE_WORDS; ++i)
+		state[i] = splitmix64(value);
+}
+
+/**
+ * @brief Produit les 64 bits pseudo-aléatoires suivants.
+ */
+uint64_t Rng::next()
+{
+	uint64_t result = rotl(state[1] * 5, 7) * 9;
+	uint64_t t = state[1] << 17;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = rotl(state[3], 45);
+	return result;
+}
+
+/**
+ * @brief Tire un entier uniforme dans [0, bound), sans biais.
+ *
+ * Méthode de Lemire : une multiplication 64x64 -> 128 bits, et un rejet
+ * (rarissime) seulement lorsque la partie basse tombe sous le seuil.
+ *
+ * @param bound Borne exclusive, non nulle.
+ * @return Un entier dans [0, bound).
+ */
+uint64_t Rng::bounded(uint64_t bound)
+{
+	unsigned __int128 m = static_cast<unsigned __int128>(next()) * bound;
+	uint64_t low = static_cast<uint64_t>(m);
+
+	if (low < bound)
+	{
+		uint64_t threshold = -bound % bound;
+		while (low < threshold)
+		{
+			m = static_cast<unsigned __int128>(next()) * bound;
+			low = static_cast<uint64_t>(m);
+		}
+	}
+	return static_cast<uint64_t>(m >> 64);
+}
+
+/**
+ * @brief Avance le générateur de 2^128 tirages.
+ *
+ * Permet de découper une même graine en 2^128 flux qui ne se recouvrent pas :
+ * on copie le générateur puis on appelle jump() entre chaque copie.
+ */
+void Rng::jump()
+{
+	static const uint64_t JUMP[] = {
+		0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+		0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+	};
+	uint64_t s[STATE_WORDS] = { 0, 0, 0, 0 };
+
+	for (uint64_t word : JUMP)
+	{
+		for (int b = 0; b < 64; ++b)
+		{
+			if (word & (1ull << b))
+				for (int i = 0; i < STATE_WORDS; ++i)
+					s[i] ^= state[i];
+			next();
+		}
+	}
+	setState(s);
+}
+
+/**
+ * @brief Copie l'état interne (pour une sauvegarde de partie).
+ *
+ * @param out Tableau recevant les STATE_WORDS mots d'état.
+ */
+void Rng::getState(uint64_t out[STATE_WORDS]) const
+{
+	for (int i = 0; i < STATE_WORDS; ++i)
+		out[i] = state[i];
+}
+
+/**
+ * @brief Restaure un état interne précédemment obtenu par getState().
+ *
+ * @param in Tableau contenant les STATE_WORDS mots d'état.
+ */
+void Rng::setState(const uint64_t in[STATE_WORDS])
+{
+	for (int i = 0; i < STATE_WORDS; ++i)
+		state[i] = in[i];
+}
+
+/**
+ * @brief Générateur splitmix64, utilisé pour dériver des états ou des graines.
+ *
+ * @param value État de 64 bits, avancé à chaque appel.
+ * @return 64 bits bien mélangés.
+ */
+uint64_t Rng::splitmix64(uint64_t& value)
+{
+	uint64_t z = (value += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+ * @brief Produit une graine non reproductible, pour les parties sans --seed.
+ *
+ * @return Une graine tirée de std::random_device mélangée à l'horloge.
+ */
+uint64_t Rng::randomSeed()
+{
+	std::random_device device;
+	uint64_t value = (static_cast<uint64_t>(device()) << 32) ^ device();
+	value ^= static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	return splitmix64(value);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file Rng.hpp
+ * @brief Déclaration de la classe Rng, générateur pseudo-aléatoire déterministe.
+ *
+ * Chaque partie possède son propre générateur : une même graine produit
+ * exactement la même partie, et plusieurs parties peuvent tourner en
+ * parallèle dans un même processus sans état global partagé.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Générateur xoshiro256** initialisé par splitmix64.
+ *
+ * Rapide (quelques instructions par tirage), d'une période de 2^256 - 1, et
+ * capable de sauter 2^128 tirages d'un coup pour découper des flux
+ * indépendants (un par thread ou par partie).
+ */
+class Rng
+{
+	public:
+		static const int STATE_WORDS = 4;	///< Taille de l'état interne en mots de 64 bits.
+
+		Rng();
+		explicit Rng(uint64_t seed);
+		Rng(const Rng& other);
+		Rng& operator=(const Rng& other);
+		~Rng();
+
+		void		seed(uint64_t seed);
+		uint64_t	next();
+		uint64_t	bounded(uint64_t bound);
+		void		jump();
+		void		getState(uint64_t out[STATE_WORDS]) const;
+		void		setState(const uint64_t in[STATE_WORDS]);
+
+		static uint64_t	splitmix64(uint64_t& state);
+		static uint64_t	randomSeed();
+
+	private:
+		uint64_t	state[STATE_WORDS];	///< État du générateur (jamais entièrement nul).
+};
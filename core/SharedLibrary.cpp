@@ -0,0 +1,110 @@
+/**
+ * @file SharedLibrary.cpp
+ * @brief Implémentation de la classe SharedLibrary.
+ */
+
+#include "SharedLibrary.hpp"
+#include <dlfcn.h>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Constructeur par défaut : aucune bibliothèque chargée.
+ */
+SharedLibrary::SharedLibrary()
+	: _handle(nullptr)
+{}
+
+/**
+ * @brief Charge une bibliothèque partagée.
+ *
+ * Les symboles sont résolus dès le chargement (RTLD_NOW) : une dépendance
+ * manquante est détectée ici plutôt qu'au premier appel.
+ *
+ * @param path Chemin de la bibliothèque.
+ * @throw std::runtime_error avec le message de dlerror() en cas d'échec.
+ */
+SharedLibrary::SharedLibrary(const std::string& path)
+	: _handle(dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)), _path(path)
+{
+	if (!_handle)
+	{
+		const char* error = dlerror();
+		throw std::runtime_error("Failed to load " + path + ": " + (error ? error : "unknown error"));
+	}
+}
+
+/**
+ * @brief Constructeur de déplacement.
+ */
+SharedLibrary::SharedLibrary(SharedLibrary&& other) noexcept
+	: _handle(other._handle), _path(std::move(other._path))
+{
+	other._handle = nullptr;
+}
+
+/**
+ * @brief Affectation par déplacement : décharge la bibliothèque courante.
+ */
+SharedLibrary& SharedLibrary::operator=(SharedLibrary&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		_handle = other._handle;
+		_path = std::move(other._path);
+		other._handle = nullptr;
+	}
+	return *this;
+}
+
+/**
+ * @brief Destructeur : décharge la bibliothèque.
+ */
+SharedLibrary::~SharedLibrary()
+{
+	close();
+}
+
+/**
+ * @brief Indique si une bibliothèque est chargée.
+ */
+bool SharedLibrary::isLoaded() const
+{
+	return _handle != nullptr;
+}
+
+/**
+ * @brief Chemin de la bibliothèque.
+ */
+const std::string& SharedLibrary::getPath() const
+{
+	return _path;
+}
+
+/**
+ * @brief Adresse d'un symbole exporté.
+ *
+ * @param name Nom du symbole (déclaré `extern "C"`).
+ * @return L'adresse du symbole.
+ * @throw std::runtime_error si la bibliothèque n'est pas chargée ou n'exporte pas ce symbole.
+ */
+void* SharedLibrary::symbol(const char* name) const
+{
+	if (!_handle)
+		throw std::runtime_error(std::string("No library loaded to look up ") + name);
+	void* address = dlsym(_handle, name);
+	if (!address)
+		throw std::runtime_error("Failed to find " + std::string(name) + "() in " + _path);
+	return address;
+}
+
+/**
+ * @brief Décharge la bibliothèque (sans effet si rien n'est chargé).
+ */
+void SharedLibrary::close()
+{
+	if (_handle)
+		dlclose(_handle);
+	_handle = nullptr;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file SharedLibrary.hpp
+ * @brief Déclaration de la classe SharedLibrary, bibliothèque partagée chargée avec dlopen().
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @class SharedLibrary
+ * @brief Possède le handle d'une bibliothèque partagée et la décharge à sa destruction.
+ *
+ * Non copiable ; peut être déplacée (le handle change alors de propriétaire).
+ */
+class SharedLibrary
+{
+	public:
+		SharedLibrary();
+		explicit SharedLibrary(const std::string& path);
+		SharedLibrary(const SharedLibrary&) = delete;
+		SharedLibrary& operator=(const SharedLibrary&) = delete;
+		SharedLibrary(SharedLibrary&& other) noexcept;
+		SharedLibrary& operator=(SharedLibrary&& other) noexcept;
+		~SharedLibrary();
+
+		bool				isLoaded() const;
+		const std::string&	getPath() const;
+		void*				symbol(const char* name) const;
+		void				close();
+
+	private:
+		void*		_handle;	///< Handle renvoyé par dlopen(), nul si rien n'est chargé.
+		std::string	_path;		///< Chemin de la bibliothèque.
+};
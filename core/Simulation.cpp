@@ -0,0 +1,339 @@
+/**
+ * @file Simulation.cpp
+ * @brief Implémentation de la simulation sur thread dédié.
+ */
+
+#include "Simulation.hpp"
+#include "../includes/ScopedTimer.hpp"
+
+/**
+ * @brief Prépare la simulation d'une partie (sans démarrer le thread).
+ *
+ * Le premier instantané (état initial) est publié immédiatement. La partie
+ * enregistre ses événements de rendu, joints à chaque instantané.
+ *
+ * @param width Largeur du plateau.
+ * @param height Hauteur du plateau.
+ * @param obstacles Active les obstacles.
+ * @param seed Graine de la partie.
+ * @param tickRate Ticks par seconde.
+ */
+Simulation::Simulation(int width, int height, bool obstacles, uint64_t seed, double tickRate)
+	: Simulation(GameState(width, height, obstacles, seed), tickRate)
+{}
+
+/**
+ * @brief Prépare la simulation d'une partie déjà commencée (sauvegarde restaurée).
+ *
+ * @param start État de départ de la partie.
+ * @param tickRate Ticks par seconde.
+ */
+Simulation::Simulation(const GameState& start, double tickRate)
+	: game(start), scheduler(tickRate), tick(0), published(0), stats(nullptr), recorder(nullptr),
+	  replay(nullptr), replayPending(false), controller(nullptr), stopping(false), paused(false),
+	  done(false)
+{
+	game.recordEvents(true);
+	publish();
+	acquireFrame();
+}
+
+/**
+ * @brief Arrête le thread s'il tourne encore.
+ */
+Simulation::~Simulation()
+{
+	stop();
+}
+
+/**
+ * @brief Démarre le thread de simulation.
+ */
+void Simulation::start()
+{
+	stopping = false;
+	done = false;
+	scheduler.start();
+	thread = std::thread(&Simulation::run, this);
+}
+
+/**
+ * @brief Demande l'arrêt du thread et attend sa fin.
+ */
+void Simulation::stop()
+{
+	stopping = true;
+	if (thread.joinable())
+		thread.join();
+}
+
+/**
+ * @brief Suspend ou reprend les ticks ; à la reprise, le temps suspendu n'est pas rattrapé.
+ */
+void Simulation::setPaused(bool value)
+{
+	paused = value;
+}
+
+/**
+ * @brief Mesure la durée de chaque tick et compte les ticks (à appeler avant start()).
+ *
+ * @param destination Mesures à compléter, ou nullptr.
+ */
+void Simulation::setStats(FrameStats* destination)
+{
+	stats = destination;
+}
+
+/**
+ * @brief Enregistre les entrées prises en compte, avec leur tick (à appeler avant start()).
+ *
+ * @param destination Enregistrement à compléter, ou nullptr.
+ */
+void Simulation::setRecorder(ReplayWriter* destination)
+{
+	recorder = destination;
+}
+
+/**
+ * @brief Rejoue un enregistrement : les entrées reçues sont ignorées (à appeler avant start()).
+ *
+ * La partie doit avoir été créée avec les paramètres de l'enregistrement.
+ * Le thread s'arrête de lui-même au dernier tick enregistré.
+ *
+ * @param source Enregistrement à rejouer, ou nullptr.
+ */
+void Simulation::setReplay(ReplayReader* source)
+{
+	replay = source;
+	replayPending = false;
+	if (replay)
+	{
+		replay->rewind();
+		replayPending = replay->next(replayNext);
+	}
+}
+
+/**
+ * @brief Confie les directions à un joueur automatique (à appeler avant start()).
+ *
+ * Le contrôleur choisit une direction avant chaque tick ; elle est
+ * enregistrée comme une entrée reçue (setRecorder()). Les directions reçues
+ * sont ignorées, la touche d'aide reste prise en compte.
+ *
+ * @param source Joueur automatique, ou nullptr pour jouer avec les entrées reçues.
+ */
+void Simulation::setController(IController* source)
+{
+	controller = source;
+}
+
+/**
+ * @brief Indique que le thread a terminé : partie finie, ou enregistrement rejoué en entier.
+ */
+bool Simulation::isDone() const
+{
+	return done;
+}
+
+/**
+ * @brief File des entrées à transmettre à la partie (le thread principal en est le seul producteur).
+ */
+InputQueue& Simulation::getInputs()
+{
+	return inputs;
+}
+
+/**
+ * @brief Récupère le dernier instantané publié (côté rendu).
+ *
+ * @return true si un nouvel instantané est disponible depuis l'appel précédent.
+ */
+bool Simulation::acquireFrame()
+{
+	return frames.acquire();
+}
+
+/**
+ * @brief Dernier instantané obtenu par acquireFrame().
+ */
+const Frame& Simulation::getFrame() const
+{
+	return frames.front();
+}
+
+/**
+ * @brief Fraction du tick écoulée depuis l'instantané courant, entre 0 et 1.
+ *
+ * Calculée à partir de l'instant de capture : le thread de rendu n'a pas
+ * besoin d'accéder à la cadence de la simulation.
+ */
+float Simulation::getAlpha() const
+{
+	const Frame& frame = frames.front();
+	if (frame.isHelpMenuActive() || paused)
+		return 1.0f;
+
+	double interval = std::chrono::duration<double, std::nano>(scheduler.getInterval()).count();
+	double alpha = (InputQueue::now() - frame.getTimeNs()) / interval;
+	return static_cast<float>(alpha < 0 ? 0 : (alpha > 1 ? 1 : alpha));
+}
+
+/**
+ * @brief Cadence et statistiques de dérive (à lire après stop()).
+ */
+const TickScheduler& Simulation::getScheduler() const
+{
+	return scheduler;
+}
+
+/**
+ * @brief Latence des entrées, de leur réception par la GUI à leur prise en compte (à lire après stop()).
+ */
+const Histogram& Simulation::getInputLatency() const
+{
+	return inputLatency;
+}
+
+/**
+ * @brief État de la partie (à lire après stop()).
+ */
+const GameState& Simulation::getGame() const
+{
+	return game;
+}
+
+/**
+ * @brief Ticks joués (à lire après stop()).
+ */
+uint64_t Simulation::getTicks() const
+{
+	return tick;
+}
+
+/**
+ * @brief Copie l'état de la partie et ses événements dans le tampon d'écriture et le publie.
+ */
+void Simulation::publish()
+{
+	Frame& frame = frames.back();
+	frame.capture(game, tick, InputQueue::now());
+	frame.setEvents(game.getEvents(), ++published);
+	game.clearEvents();
+	frames.publish();
+}
+
+/**
+ * @brief Applique les entrées reçues : aide, et virages mis en attente.
+ *
+ * Les entrées prises en compte sont enregistrées (setRecorder()) ; pendant
+ * une relecture, les entrées reçues sont ignorées, et avec un contrôleur,
+ * les directions reçues.
+ */
+void Simulation::drainInputs()
+{
+	InputEvent event;
+	bool changed = false;
+
+	while (inputs.pop(event))
+	{
+		if (replay)
+			continue;
+		uint64_t now = InputQueue::now();
+		inputLatency.record(now > event.timeNs ? now - event.timeNs : 0);
+		if (event.input == Input::HELP)
+		{
+			game.toggleHelpMenu();
+			scheduler.start();
+			changed = true;
+			if (recorder)
+				recorder->record(tick, event.input);
+		}
+		else if (!controller && !game.isHelpMenuActive() && game.queueDirection(event.input) && recorder)
+			recorder->record(tick, event.input);
+	}
+	if (changed)
+		publish();
+}
+
+/**
+ * @brief Applique les entrées de l'enregistrement rejoué prévues avant le tick courant.
+ */
+void Simulation::playRecords()
+{
+	bool help = game.isHelpMenuActive();
+
+	while (replayPending && replayNext.tick == tick)
+	{
+		applyReplayInput(game, replayNext.input);
+		replayPending = replay->next(replayNext);
+	}
+	if (game.isHelpMenuActive() != help)
+		publish();
+}
+
+/**
+ * @brief Boucle du thread : entrées, ticks dus, publication, attente du tick suivant.
+ */
+void Simulation::run()
+{
+	bool wasPaused = false;
+
+	while (!stopping && !game.isFinished())
+	{
+		if (paused)
+		{
+			wasPaused = true;
+			std::this_thread::sleep_for(scheduler.getInterval());
+			continue;
+		}
+		if (wasPaused)
+		{
+			scheduler.start();
+			wasPaused = false;
+		}
+
+		drainInputs();
+		if (replay)
+		{
+			playRecords();
+			if (tick >= replay->getTicks())
+				break;
+		}
+		if (game.isHelpMenuActive())
+		{
+			std::this_thread::sleep_for(scheduler.getInterval());
+			continue;
+		}
+
+		int ticks = scheduler.advance();
+		for (int i = 0; i < ticks && !game.isFinished(); ++i)
+		{
+			if (replay && i > 0)
+			{
+				playRecords();
+				if (tick >= replay->getTicks() || game.isHelpMenuActive())
+					break;
+			}
+			if (controller)
+			{
+				ScopedTimer timer(stats, StatsPhase::PLAN);
+				Input input = controller->nextInput(game);
+				if (game.queueDirection(input) && recorder)
+					recorder->record(tick, input);
+			}
+			{
+				ScopedTimer timer(stats, StatsPhase::UPDATE);
+				game.update();
+			}
+			if (stats)
+				stats->count(StatsCounter::TICKS);
+			scheduler.recordTick();
+			++tick;
+		}
+		if (ticks > 0)
+			publish();
+		std::this_thread::sleep_until(scheduler.nextTick());
+	}
+	done = true;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file Simulation.hpp
+ * @brief Déclaration de la classe Simulation, partie jouée sur son propre thread.
+ *
+ * La simulation avance à cadence fixe sur un thread dédié et publie un
+ * instantané (Frame) après chaque tick dans un triple tampon ; le thread
+ * principal lit les entrées de la GUI, les transmet par une file sans
+ * verrou et affiche le dernier instantané. Un rendu lent (synchronisation
+ * verticale, terminal distant) ne retarde donc jamais un tick.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include "Frame.hpp"
+#include "FrameStats.hpp"
+#include "GameState.hpp"
+#include "Histogram.hpp"
+#include "Replay.hpp"
+#include "TickScheduler.hpp"
+#include "../includes/IController.hpp"
+#include "../includes/InputQueue.hpp"
+#include "../includes/TripleBuffer.hpp"
+
+/**
+ * @class Simulation
+ * @brief Possède la partie et sa cadence ; seul son thread les modifie.
+ *
+ * Côté thread principal :
+ * - getInputs() reçoit les directions et la touche d'aide ;
+ * - acquireFrame() / getFrame() donnent le dernier instantané publié ;
+ * - setPaused() suspend les ticks (changement de GUI) sans rattrapage ;
+ * - setStats(), avant start(), fait mesurer la durée de chaque tick ;
+ * - setRecorder(), avant start(), enregistre les entrées prises en compte ;
+ * - setReplay(), avant start(), rejoue un enregistrement à la place des
+ *   entrées reçues, jusqu'à son dernier tick (isDone()) ;
+ * - setController(), avant start(), confie les directions à un joueur
+ *   automatique (les directions reçues sont ignorées, l'aide reste active).
+ *
+ * Après stop(), la cadence, la latence des entrées et l'état final de la
+ * partie peuvent être lus.
+ */
+class Simulation
+{
+	public:
+		Simulation(int width, int height, bool obstacles, uint64_t seed, double tickRate);
+		Simulation(const GameState& start, double tickRate);
+		Simulation(const Simulation&) = delete;
+		Simulation& operator=(const Simulation&) = delete;
+		~Simulation();
+
+		void				start();
+		void				stop();
+		void				setPaused(bool paused);
+		void				setStats(FrameStats* stats);
+		void				setRecorder(ReplayWriter* recorder);
+		void				setReplay(ReplayReader* replay);
+		void				setController(IController* controller);
+		bool				isDone() const;
+		InputQueue&			getInputs();
+		bool				acquireFrame();
+		const Frame&		getFrame() const;
+		float				getAlpha() const;
+		const TickScheduler&	getScheduler() const;
+		const Histogram&	getInputLatency() const;
+		const GameState&	getGame() const;
+		uint64_t			getTicks() const;
+
+	private:
+		void	run();
+		void	drainInputs();
+		void	playRecords();
+		void	publish();
+
+		GameState			game;			///< La partie (modifiée par le thread de simulation uniquement).
+		TickScheduler		scheduler;		///< Cadence des ticks.
+		InputQueue			inputs;			///< Entrées venant du thread principal.
+		TripleBuffer<Frame>	frames;			///< Instantanés publiés pour le rendu.
+		Histogram			inputLatency;	///< Délai entre réception d'une entrée et sa prise en compte.
+		uint64_t			tick;			///< Ticks joués.
+		uint64_t			published;		///< Instantanés publiés.
+		FrameStats*			stats;			///< Mesures des ticks (nul : aucune).
+		ReplayWriter*		recorder;		///< Enregistrement des entrées (nul : aucun).
+		ReplayReader*		replay;			///< Enregistrement rejoué (nul : entrées reçues).
+		ReplayRecord		replayNext;		///< Prochaine entrée de l'enregistrement rejoué.
+		bool				replayPending;	///< replayNext reste à appliquer.
+		IController*		controller;		///< Joueur automatique (nul : entrées reçues).
+		std::thread			thread;			///< Thread de simulation.
+		std::atomic<bool>	stopping;		///< Arrêt demandé.
+		std::atomic<bool>	paused;			///< Ticks suspendus.
+		std::atomic<bool>	done;			///< Le thread a terminé (fin de partie ou d'enregistrement).
+};
@@ -7,42 +7,76 @@
  */
 
 #include "Snake.hpp"
+#include "Snapshot.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
 
 /**
- * @brief Constructeur par défaut : serpent de 4 segments à l'origine, vers la droite.
+ * @brief Arrondit une capacité à la puissance de deux supérieure (au moins 4).
+ *
+ * @param capacity Capacité demandée.
+ * @return La plus petite puissance de deux supérieure ou égale.
  */
-Snake::Snake() : direction(Direction::RIGHT)
+static size_t roundCapacity(size_t capacity)
 {
-	body.push_front({0, 0});
-	body.push_back({-1, 0});
-	body.push_back({-2, 0});
-	body.push_back({-3, 0});
+	size_t rounded = 4;
+	while (rounded < capacity)
+		rounded <<= 1;
+	return rounded;
 }
 
+/**
+ * @brief Constructeur par défaut : serpent de 4 segments à l'origine, vers la droite.
+ */
+Snake::Snake() : Snake(0, 0)
+{}
+
 /**
  * @brief Constructeur de copie.
+ *
+ * Seuls les segments vivants sont recopiés, en commençant au début du tampon.
  */
 Snake::Snake(const Snake& other)
-	: body(other.body), direction(other.direction)
-{}
+	: body(nullptr), capacity(0), headIndex(0), length(0), lastTail(other.lastTail),
+	  direction(other.direction)
+{
+	allocate(other.capacity);
+	*this = other;
+}
 
 /**
  * @brief Opérateur d'affectation.
+ *
+ * Le tampon existant est réutilisé lorsque les capacités sont identiques,
+ * ce qui rend la copie d'un serpent proportionnelle à sa longueur.
  */
 Snake& Snake::operator=(const Snake& other)
 {
 	if (this != &other)
 	{
-		body = other.body;
+		if (capacity != other.capacity)
+			allocate(other.capacity);
+		BodyView view = other.getBody();
+		std::memcpy(body, view.first.data, view.first.size * sizeof(Point));
+		std::memcpy(body + view.first.size, view.second.data, view.second.size * sizeof(Point));
+		headIndex = 0;
+		length = other.length;
+		lastTail = other.lastTail;
 		direction = other.direction;
 	}
 	return *this;
 }
 
 /**
- * @brief Destructeur par défaut.
+ * @brief Destructeur : libère le tampon circulaire.
  */
-Snake::~Snake() {}
+Snake::~Snake()
+{
+	std::free(body);
+}
 
 
 /**
@@ -51,47 +85,93 @@ Snake::~Snake() {}
  * La tête est placée aux coordonnées de départ, et 3 segments supplémentaires
  * sont ajoutés derrière elle, dans la direction opposée au mouvement initial.
  */
-Snake::Snake(int startX, int startY) : direction(Direction::RIGHT)
+Snake::Snake(int startX, int startY) : Snake(startX, startY, DEFAULT_CAPACITY)
+{}
+
+/**
+ * @brief Constructeur avec capacité : le tampon peut contenir `capacity` segments.
+ *
+ * La capacité est arrondie à la puissance de deux supérieure. Pour une partie,
+ * on passe la surface du plateau : le serpent ne peut jamais la dépasser.
+ *
+ * @param startX Abscisse de la tête.
+ * @param startY Ordonnée de la tête.
+ * @param capacity Nombre maximal de segments.
+ */
+Snake::Snake(int startX, int startY, size_t capacity)
+	: body(nullptr), capacity(0), headIndex(0), length(0), lastTail(startX - 3, startY),
+	  direction(Direction::RIGHT)
 {
-	body.push_front({startX, startY});
-	body.push_back({startX - 1, startY});
-	body.push_back({startX - 2, startY}); 
-	body.push_back({startX - 3, startY});
+	allocate(capacity);
+	restart(startX, startY);
 }
 
 /**
- * @brief Déplace le serpent dans la direction actuelle
+ * @brief Replace le serpent dans son état de départ, dans le même tampon.
+ *
+ * Quatre segments horizontaux, la tête en (`startX`, `startY`), vers la
+ * droite : l'état que donne le constructeur, sans allocation.
+ *
+ * @param startX Abscisse de la tête.
+ * @param startY Ordonnée de la tête.
  */
-void Snake::move()
+void Snake::restart(int startX, int startY)
 {
-	Point head = body.front();
+	headIndex = 0;
+	length = 0;
+	lastTail = Point(startX - 3, startY);
+	direction = Direction::RIGHT;
+	pushFront({startX - 3, startY});
+	pushFront({startX - 2, startY});
+	pushFront({startX - 1, startY});
+	pushFront({startX, startY});
+}
 
-	switch (direction)
-	{
-		case Direction::UP:    
-			head.y -= 1; 
-			break;
-		case Direction::DOWN:
-		 	head.y += 1;
-			break;
-		case Direction::LEFT:
-		 	head.x -= 1;
-			break;
-		case Direction::RIGHT:
-			head.x += 1;
-			break;
-	}
+/**
+ * @brief Alloue un tampon vide de la capacité demandée.
+ *
+ * calloc() est utilisé pour que les pages d'un grand tampon ne soient
+ * réellement occupées qu'au fur et à mesure de la croissance du serpent
+ * (un point à zéro vaut Point(0, 0)).
+ *
+ * @param requested Capacité minimale du tampon.
+ */
+void Snake::allocate(size_t requested)
+{
+	size_t rounded = roundCapacity(requested);
+	Point* storage = static_cast<Point*>(std::calloc(rounded, sizeof(Point)));
+	if (!storage)
+		throw std::bad_alloc();
+	std::free(body);
+	body = storage;
+	capacity = rounded;
+	headIndex = 0;
+	length = 0;
+}
 
-	body.push_front(head); // Ajoute la nouvelle tête
-	body.pop_back(); // Supprime l'ancienne queue
+/**
+ * @brief Ajoute un segment devant la tête.
+ *
+ * @param p Position de la nouvelle tête.
+ * @throw std::length_error si le tampon est plein.
+ */
+void Snake::pushFront(const Point& p)
+{
+	if (length == capacity)
+		throw std::length_error("Snake body capacity exceeded");
+	headIndex = (headIndex - 1) & (capacity - 1);
+	body[headIndex] = p;
+	++length;
 }
 
 /**
- * @brief Fait grandir le serpent (ajoute un nouveau point sans retirer la queue)
+ * @brief Calcule la case dans laquelle la tête va entrer.
+ *
+ * @return La position de la tête après un pas dans la direction actuelle.
  */
-void Snake::grow()
+Point Snake::nextHead() const
 {
-	Point head = body.front();
+	Point head = getHead();
 
 	switch (direction)
 	{
@@ -99,17 +179,39 @@ void Snake::grow()
 			head.y -= 1;
 			break;
 		case Direction::DOWN:
-			head.y += 1;
+		 	head.y += 1;
 			break;
 		case Direction::LEFT:
-			head.x -= 1;
+		 	head.x -= 1;
 			break;
 		case Direction::RIGHT:
 			head.x += 1;
 			break;
 	}
+	return head;
+}
+
+/**
+ * @brief Déplace le serpent dans la direction actuelle
+ */
+void Snake::move()
+{
+	Point head = nextHead();
+
+	lastTail = getTail();
+	--length; // Supprime l'ancienne queue
+	pushFront(head); // Ajoute la nouvelle tête
+}
 
-	body.push_front(head);
+/**
+ * @brief Fait grandir le serpent (ajoute un nouveau point sans retirer la queue)
+ *
+ * La queue n'a pas bougé : getPreviousTail() renvoie la queue actuelle.
+ */
+void Snake::grow()
+{
+	lastTail = getTail();
+	pushFront(nextHead());
 }
 
 /**
@@ -122,21 +224,83 @@ void Snake::grow()
  */
 bool Snake::checkCollision(const Point& pos, bool ignoreHead) const
 {
-	size_t start = ignoreHead ? 1 : 0;
-	for (size_t i = start; i < body.size(); ++i)
+	BodyView view = getBody();
+	const Point* skip = ignoreHead ? view.first.data : nullptr;
+
+	for (const PointSpan& span : { view.first, view.second })
 	{
-		if (body[i].x == pos.x && body[i].y == pos.y)
-			return true;
+		for (const Point& p : span)
+		{
+			if (p.x == pos.x && p.y == pos.y && &p != skip)
+				return true;
+		}
 	}
 	return false;
 }
 
 /**
- * @brief Retourne le corps complet du serpent (en lecture seule)
+ * @brief Retourne le corps complet du serpent (en lecture seule), en deux suites contiguës.
  */
-const std::deque<Point>& Snake::getBody() const
+BodyView Snake::getBody() const
 {
-	return body;
+	size_t firstSize = capacity - headIndex;
+	if (firstSize > length)
+		firstSize = length;
+	return BodyView{ { body + headIndex, firstSize }, { body, length - firstSize } };
+}
+
+/**
+ * @brief Retourne la position de la tête.
+ */
+const Point& Snake::getHead() const
+{
+	return body[headIndex];
+}
+
+/**
+ * @brief Retourne la position du dernier segment.
+ */
+const Point& Snake::getTail() const
+{
+	return body[(headIndex + length - 1) & (capacity - 1)];
+}
+
+/**
+ * @brief Retourne la position qu'occupait la queue avant le dernier move().
+ *
+ * Avec les segments actuels, elle donne la position de chaque segment au
+ * tick précédent : le segment i était à la place du segment i + 1, et le
+ * dernier à la place de cette ancienne queue.
+ */
+const Point& Snake::getPreviousTail() const
+{
+	return lastTail;
+}
+
+/**
+ * @brief Retourne le segment d'indice donné (0 pour la tête).
+ *
+ * @param index Indice du segment, inférieur à getLength().
+ */
+const Point& Snake::getSegment(size_t index) const
+{
+	return body[(headIndex + index) & (capacity - 1)];
+}
+
+/**
+ * @brief Retourne le nombre de segments du serpent.
+ */
+size_t Snake::getLength() const
+{
+	return length;
+}
+
+/**
+ * @brief Retourne le nombre maximal de segments que le tampon peut contenir.
+ */
+size_t Snake::getCapacity() const
+{
+	return capacity;
 }
 
 /**
@@ -162,3 +326,64 @@ void Snake::setDirection(Direction newDir)
     }
 	direction = newDir;
 }
+
+/**
+ * @brief Retourne la direction actuelle du serpent.
+ */
+Direction Snake::getDirection() const
+{
+	return direction;
+}
+
+/**
+ * @brief Écrit le serpent dans une sauvegarde : capacité, direction, dernière queue et corps.
+ *
+ * Le corps est écrit de la tête vers la queue (les deux parties du tampon
+ * circulaire bout à bout).
+ *
+ * @param out Sauvegarde en cours.
+ */
+void Snake::save(SnapshotWriter& out) const
+{
+	BodyView view = getBody();
+
+	out.write<uint64_t>(capacity);
+	out.write<uint8_t>(static_cast<uint8_t>(direction));
+	out.write(lastTail);
+	out.beginArray(length);
+	out.writeElements(view.first.data, view.first.size);
+	out.writeElements(view.second.data, view.second.size);
+}
+
+/**
+ * @brief Remplace le serpent par celui d'une sauvegarde (la tête en début de tampon).
+ *
+ * La capacité sauvegardée doit être celle que le moteur choisit pour le
+ * plateau (minCapacity arrondie) : le serpent grandit sans jamais réallouer
+ * son tampon, et un fichier ne peut pas imposer une allocation démesurée.
+ *
+ * @param in Sauvegarde en cours de lecture.
+ * @param minCapacity Capacité minimale (la surface du plateau).
+ * @throw std::runtime_error si le serpent sauvegardé est incohérent.
+ */
+void Snake::load(SnapshotReader& in, size_t minCapacity)
+{
+	uint64_t savedCapacity = in.read<uint64_t>();
+	uint8_t savedDirection = in.read<uint8_t>();
+	Point savedTail = in.read<Point>();
+	// Seule la capacité que le moteur aurait choisie est acceptée : le fichier ne dimensionne pas l'allocation
+	if (savedCapacity != roundCapacity(minCapacity) || savedDirection > static_cast<uint8_t>(Direction::RIGHT))
+		in.fail("snake");
+
+	uint64_t count = 0;
+	const Point* segments = in.readArray<Point>(count, savedCapacity);
+	if (count == 0)
+		in.fail("snake length");
+	if (savedCapacity != capacity)
+		allocate(savedCapacity);
+	std::memcpy(body, segments, count * sizeof(Point));
+	headIndex = 0;
+	length = count;
+	lastTail = savedTail;
+	direction = static_cast<Direction>(savedDirection);
+}
@@ -7,14 +7,17 @@
 
 #pragma once
 
-#include <deque>
+#include <cstddef>
 #include <iostream>
 #include "../includes/Point.hpp"
 
+class SnapshotReader;
+class SnapshotWriter;
+
 /**
  * @brief Enumération des directions possibles du serpent.
  */
-enum class Direction 
+enum class Direction
 {
 	UP,
 	DOWN,
@@ -22,28 +25,79 @@ enum class Direction
 	RIGHT,
 };
 
+/**
+ * @brief Vue en lecture seule sur une suite contiguë de segments.
+ */
+struct PointSpan
+{
+	const Point*	data;	///< Premier segment de la suite.
+	size_t			size;	///< Nombre de segments.
+
+	const Point* begin() const { return data; }
+	const Point* end() const { return data + size; }
+};
+
+/**
+ * @brief Vue sur le corps complet du serpent, de la tête vers la queue.
+ *
+ * Le corps étant stocké dans un tampon circulaire, il est exposé sous la forme
+ * d'au plus deux suites contiguës : `first` commence par la tête, `second`
+ * (éventuellement vide) se poursuit jusqu'à la queue.
+ */
+struct BodyView
+{
+	PointSpan	first;	///< Segments depuis la tête jusqu'à la fin du tampon.
+	PointSpan	second;	///< Segments restants depuis le début du tampon.
+
+	size_t size() const { return first.size + second.size; }
+};
+
 /**
  * @brief Classe représentant le serpent dans le jeu.
  *
  * Gère le déplacement, la croissance, les collisions, et la direction.
+ * Le corps est stocké dans un tampon circulaire de capacité fixe (puissance
+ * de deux, dimensionnée sur la surface du plateau) : aucun déplacement ni
+ * aucune croissance n'alloue de mémoire après la construction.
  */
-class Snake 
+class Snake
 {
 	public:
+		static const size_t DEFAULT_CAPACITY = 1024;	///< Capacité si aucune n'est précisée.
+
 		Snake();
 		Snake(const Snake& other);
 		Snake& operator=(const Snake& other);
 		~Snake();
 
 		Snake(int startX, int startY);
+		Snake(int startX, int startY, size_t capacity);
 
+		void restart(int startX, int startY);
 		void move();
 		void grow();
 		bool checkCollision(const Point& pos, bool ignoreHead) const;
-		const std::deque<Point>& getBody() const;
+		BodyView getBody() const;
+		const Point& getHead() const;
+		const Point& getTail() const;
+		const Point& getPreviousTail() const;
+		const Point& getSegment(size_t index) const;
+		Point nextHead() const;
+		size_t getLength() const;
+		size_t getCapacity() const;
 		void setDirection(Direction newDir);
+		Direction getDirection() const;
+		void save(SnapshotWriter& out) const;
+		void load(SnapshotReader& in, size_t minCapacity);
 
 	private:
-		std::deque<Point> body;	///< Corps du serpent, stocké comme une liste de points.
-		Direction direction;	///< Direction actuelle du serpent.
+		void allocate(size_t capacity);
+		void pushFront(const Point& p);
+
+		Point*		body;		///< Tampon circulaire contenant le corps du serpent.
+		size_t		capacity;	///< Taille du tampon (puissance de deux).
+		size_t		headIndex;	///< Position de la tête dans le tampon.
+		size_t		length;		///< Nombre de segments du serpent.
+		Point		lastTail;	///< Position précédente de la queue : retirée par move(), inchangée par grow() (pour l'interpolation).
+		Direction	direction;	///< Direction actuelle du serpent.
 };
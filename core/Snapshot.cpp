@@ -0,0 +1,182 @@
+/**
+ * @file Snapshot.cpp
+ * @brief Implémentation de la sauvegarde binaire des parties.
+ */
+
+#include "Snapshot.hpp"
+#include "GameState.hpp"
+#include <cstdio>
+
+namespace
+{
+	const char	MAGIC[4] = { 'N', 'I', 'B', 'S' };	///< Signature du fichier.
+}
+
+const uint32_t SnapshotWriter::VERSION;
+const size_t SnapshotWriter::ALIGNMENT;
+const size_t SnapshotWriter::PAGE;
+
+/**
+ * @brief Crée le fichier temporaire et écrit la signature et la version.
+ *
+ * @param path Chemin du fichier (remplacé par finish()).
+ * @throw std::runtime_error si le fichier ne peut pas être créé.
+ */
+SnapshotWriter::SnapshotWriter(const std::string& path)
+	: _path(path), _tempPath(path + ".tmp"), _offset(0), _finished(false)
+{
+	_file.open(_tempPath, std::ios::binary | std::ios::trunc);
+	if (!_file)
+		throw std::runtime_error("Failed to open " + _tempPath);
+	writeBytes(MAGIC, sizeof(MAGIC));
+	write(VERSION);
+}
+
+/**
+ * @brief Destructeur : supprime le fichier temporaire si finish() n'a pas abouti.
+ */
+SnapshotWriter::~SnapshotWriter()
+{
+	if (!_finished)
+	{
+		_file.close();
+		std::remove(_tempPath.c_str());
+	}
+}
+
+/**
+ * @brief Commence un tableau de `count` éléments (suivis d'appels à writeElements()).
+ */
+void SnapshotWriter::beginArray(uint64_t count, size_t alignment)
+{
+	write(count);
+	align(alignment);
+}
+
+/**
+ * @brief Termine l'écriture et remplace le fichier final par le fichier temporaire.
+ *
+ * @throw std::runtime_error si une écriture ou le renommage a échoué.
+ */
+void SnapshotWriter::finish()
+{
+	_file.close();
+	if (!_file)
+		throw std::runtime_error("Failed to write " + _tempPath);
+	if (std::rename(_tempPath.c_str(), _path.c_str()) != 0)
+		throw std::runtime_error("Failed to replace " + _path);
+	_finished = true;
+}
+
+/**
+ * @brief Écrit des octets bruts.
+ */
+void SnapshotWriter::writeBytes(const void* data, size_t size)
+{
+	_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	_offset += size;
+}
+
+/**
+ * @brief Complète par des zéros jusqu'au prochain multiple de `alignment`.
+ */
+void SnapshotWriter::align(size_t alignment)
+{
+	static const char zeros[PAGE] = {};
+	writeBytes(zeros, (alignment - _offset % alignment) % alignment);
+}
+
+/**
+ * @brief Projette une sauvegarde et vérifie sa signature et sa version.
+ *
+ * @param path Chemin du fichier.
+ * @throw std::runtime_error si le fichier est illisible, d'un autre format ou d'une autre version.
+ */
+SnapshotReader::SnapshotReader(const std::string& path)
+	: _file(path), _offset(0)
+{
+	if (_file.size() < sizeof(MAGIC) || std::memcmp(_file.data(), MAGIC, sizeof(MAGIC)) != 0)
+		throw std::runtime_error(path + " is not a nibbler snapshot");
+	_offset = sizeof(MAGIC);
+	uint32_t version = read<uint32_t>();
+	if (version != SnapshotWriter::VERSION)
+		throw std::runtime_error(path + ": unsupported snapshot version " + std::to_string(version));
+}
+
+/**
+ * @brief Destructeur : libère la projection.
+ */
+SnapshotReader::~SnapshotReader() {}
+
+/**
+ * @brief Refuse la sauvegarde.
+ *
+ * @param reason Incohérence rencontrée.
+ * @throw std::runtime_error toujours.
+ */
+void SnapshotReader::fail(const std::string& reason) const
+{
+	throw std::runtime_error(_file.getPath() + ": invalid snapshot (" + reason + ")");
+}
+
+/**
+ * @brief Vérifie que toute la sauvegarde a été lue.
+ *
+ * @throw std::runtime_error s'il reste des octets.
+ */
+void SnapshotReader::finish() const
+{
+	if (_offset != _file.size())
+		fail("trailing data");
+}
+
+/**
+ * @brief Avance de `size` octets et renvoie leur adresse.
+ *
+ * @throw std::runtime_error si le fichier est trop court.
+ */
+const uint8_t* SnapshotReader::take(size_t size)
+{
+	if (size > _file.size() - _offset)
+		fail("truncated");
+	const uint8_t* data = _file.data() + _offset;
+	_offset += size;
+	return data;
+}
+
+/**
+ * @brief Saute le remplissage jusqu'au prochain multiple de `alignment`.
+ */
+void SnapshotReader::align(size_t alignment)
+{
+	take((alignment - _offset % alignment) % alignment);
+}
+
+/**
+ * @brief Sauvegarde l'état complet d'une partie.
+ *
+ * @param state Partie à sauvegarder.
+ * @param path Chemin du fichier (remplacé s'il existe).
+ * @throw std::runtime_error si le fichier ne peut pas être écrit.
+ */
+void saveSnapshot(const GameState& state, const std::string& path)
+{
+	SnapshotWriter out(path);
+	state.save(out);
+	out.finish();
+}
+
+/**
+ * @brief Restaure une partie sauvegardée par saveSnapshot().
+ *
+ * @param path Chemin du fichier.
+ * @return La partie, identique à celle qui a été sauvegardée.
+ * @throw std::runtime_error si le fichier est illisible ou incohérent.
+ */
+GameState loadSnapshot(const std::string& path)
+{
+	SnapshotReader in(path);
+	GameState state(in);
+	in.finish();
+	return state;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file Snapshot.hpp
+ * @brief Sauvegarde binaire versionnée de l'état complet d'une partie.
+ *
+ * Le fichier commence par "NIBS" et la version du format, puis chaque
+ * classe écrit ses champs dans l'ordre (GameState::save(), Grid::save(),
+ * Snake::save()). Les tableaux (corps du serpent, obstacles, cases de la
+ * grille, cases libres) sont précédés de leur taille et s'écrivent d'un
+ * bloc. Ceux de la grille commencent sur une page de 4 Kio : à la
+ * restauration, ils sont projetés en copie privée au lieu d'être copiés.
+ * Chaque case est toutefois relue pour vérifier la grille (voir
+ * Grid::load() et GameState::checkGrid()) : un plateau de 10000x10000
+ * se restaure en une seconde environ, au rythme de la lecture du fichier.
+ *
+ * Le fichier est écrit sous un nom temporaire puis renommé : une partie
+ * restaurée depuis ce même fichier garde l'ancienne version projetée.
+ *
+ * Les entiers sont écrits dans l'ordre natif, qui doit être little-endian.
+ */
+
+#pragma once
+
+#include "MappedFile.hpp"
+#include "../includes/PagedArray.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+# error "Snapshots are stored little-endian"
+#endif
+
+class GameState;
+
+/**
+ * @class SnapshotWriter
+ * @brief Écrit les champs d'une sauvegarde dans un fichier.
+ */
+class SnapshotWriter
+{
+	public:
+		static const uint32_t VERSION = 2;		///< Version du format écrit (2 : score limite).
+		static const size_t ALIGNMENT = 8;		///< Alignement par défaut des tableaux.
+		static const size_t PAGE = 4096;		///< Alignement des tableaux projetés à la restauration.
+
+		explicit SnapshotWriter(const std::string& path);
+		SnapshotWriter(const SnapshotWriter&) = delete;
+		SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+		~SnapshotWriter();
+
+		/**
+		 * @brief Écrit une valeur entière ou un Point.
+		 */
+		template <typename T>
+		void write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+			writeBytes(&value, sizeof(T));
+		}
+
+		/**
+		 * @brief Écrit un tableau : sa taille, puis ses éléments à partir d'un multiple de `alignment` octets.
+		 */
+		template <typename T>
+		void writeArray(const T* data, uint64_t count, size_t alignment = ALIGNMENT)
+		{
+			beginArray(count, alignment);
+			writeElements(data, count);
+		}
+
+		/**
+		 * @brief Écrit une partie des éléments d'un tableau commencé par beginArray().
+		 */
+		template <typename T>
+		void writeElements(const T* data, uint64_t count)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+			writeBytes(data, count * sizeof(T));
+		}
+
+		void	beginArray(uint64_t count, size_t alignment = ALIGNMENT);
+		void	finish();
+
+	private:
+		void	writeBytes(const void* data, size_t size);
+		void	align(size_t alignment);
+
+		std::ofstream	_file;		///< Fichier temporaire en cours d'écriture.
+		std::string		_path;		///< Chemin final.
+		std::string		_tempPath;	///< Chemin du fichier temporaire.
+		uint64_t		_offset;	///< Octets écrits.
+		bool			_finished;	///< Le fichier a été renommé à son chemin final.
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Lit une sauvegarde projetée en mémoire.
+ *
+ * Chaque lecture vérifie qu'elle reste dans le fichier : une sauvegarde
+ * tronquée ou corrompue lève std::runtime_error au lieu de produire un
+ * état invalide.
+ */
+class SnapshotReader
+{
+	public:
+		explicit SnapshotReader(const std::string& path);
+		SnapshotReader(const SnapshotReader&) = delete;
+		SnapshotReader& operator=(const SnapshotReader&) = delete;
+		~SnapshotReader();
+
+		/**
+		 * @brief Lit une valeur entière ou un Point.
+		 */
+		template <typename T>
+		T read()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+			T value;
+			std::memcpy(&value, take(sizeof(T)), sizeof(T));
+			return value;
+		}
+
+		/**
+		 * @brief Lit un tableau écrit par SnapshotWriter::writeArray() et renvoie ses éléments, sans copie.
+		 *
+		 * @param count [out] Nombre d'éléments.
+		 * @param limit Nombre d'éléments au plus (au-delà, la sauvegarde est refusée).
+		 * @return Premier élément, dans le fichier projeté (valide tant que le lecteur existe).
+		 */
+		template <typename T>
+		const T* readArray(uint64_t& count, uint64_t limit)
+		{
+			count = read<uint64_t>();
+			if (count > limit)
+				fail("array too large");
+			align(SnapshotWriter::ALIGNMENT);
+			return reinterpret_cast<const T*>(take(count * sizeof(T)));
+		}
+
+		/**
+		 * @brief Projette un tableau écrit avec l'alignement SnapshotWriter::PAGE.
+		 *
+		 * Si la taille de page du système ne divise pas la position du
+		 * tableau, ses éléments sont copiés.
+		 *
+		 * @param out [out] Tableau projeté.
+		 * @param limit Nombre d'éléments au plus.
+		 * @param capacity Capacité du tableau.
+		 */
+		template <typename T>
+		void mapArray(PagedArray<T>& out, uint64_t limit, size_t capacity)
+		{
+			uint64_t count = read<uint64_t>();
+			if (count > limit || count > capacity)
+				fail("array too large");
+			align(SnapshotWriter::PAGE);
+			size_t offset = _offset;
+			const uint8_t* data = take(count * sizeof(T));
+			if (offset % static_cast<size_t>(sysconf(_SC_PAGESIZE)) == 0)
+				out.map(_file.getDescriptor(), offset, count, capacity);
+			else
+			{
+				out.reserve(capacity);
+				std::memcpy(out.data(), data, count * sizeof(T));
+				out.resize(count);
+			}
+		}
+
+		/**
+		 * @brief Lit un tableau dans un std::vector (copie d'un bloc).
+		 */
+		template <typename T>
+		void readVector(std::vector<T>& out, uint64_t limit)
+		{
+			uint64_t count = 0;
+			const T* data = readArray<T>(count, limit);
+			out.assign(data, data + count);
+		}
+
+		[[noreturn]] void	fail(const std::string& reason) const;
+		void				finish() const;
+
+	private:
+		const uint8_t*	take(size_t size);
+		void			align(size_t alignment);
+
+		MappedFile	_file;		///< Fichier projeté.
+		size_t		_offset;	///< Position de la prochaine lecture.
+};
+
+void		saveSnapshot(const GameState& state, const std::string& path);
+GameState	loadSnapshot(const std::string& path);
@@ -0,0 +1,216 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implémentation du pool de threads à vol de tâches.
+ */
+
+#include "ThreadPool.hpp"
+#include <chrono>
+
+namespace
+{
+	thread_local const ThreadPool*	t_pool = nullptr;	///< Pool auquel appartient le thread courant.
+	thread_local int				t_worker = -1;		///< Indice du thread courant dans ce pool.
+}
+
+/**
+ * @brief Démarre le pool.
+ *
+ * @param count Nombre de threads (0 pour defaultThreadCount()).
+ */
+ThreadPool::ThreadPool(unsigned count)
+	: queued(0), pending(0), nextQueue(0), stopping(false)
+{
+	if (count == 0)
+		count = defaultThreadCount();
+	for (unsigned i = 0; i < count; ++i)
+	{
+		workers.push_back(std::unique_ptr<Worker>(new Worker()));
+		workers.back()->busyNs = 0;
+	}
+	for (unsigned i = 0; i < count; ++i)
+		threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+/**
+ * @brief Termine les tâches en file puis arrête les threads.
+ */
+ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> guard(sleepLock);
+		idle.wait(guard, [this] { return pending == 0; });
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+/**
+ * @brief Nombre de threads par défaut : un par cœur disponible.
+ */
+unsigned ThreadPool::defaultThreadCount()
+{
+	unsigned count = std::thread::hardware_concurrency();
+	return count > 0 ? count : 1;
+}
+
+/**
+ * @brief Indice du thread courant dans le pool qui l'exécute, -1 hors d'un pool.
+ */
+int ThreadPool::currentWorker()
+{
+	return t_worker;
+}
+
+/**
+ * @brief Ajoute une tâche au pool.
+ *
+ * Depuis un thread du pool, la tâche va dans sa propre file (elle sera
+ * exécutée en priorité par ce thread, ou volée par un autre) ; sinon, dans
+ * la file suivante à tour de rôle.
+ *
+ * @param task Tâche à exécuter.
+ */
+void ThreadPool::submit(std::function<void()> task)
+{
+	unsigned index = (t_pool == this) ? static_cast<unsigned>(t_worker)
+		: nextQueue.fetch_add(1, std::memory_order_relaxed) % workers.size();
+	Worker& worker = *workers[index];
+
+	pending.fetch_add(1);
+	{
+		std::lock_guard<std::mutex> guard(worker.lock);
+		worker.tasks.push_back(std::move(task));
+	}
+	queued.fetch_add(1);
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+	}
+	wake.notify_one();
+}
+
+/**
+ * @brief Attend la fin de toutes les tâches soumises.
+ *
+ * Ne doit pas être appelée depuis un thread du pool.
+ *
+ * @throw La première exception levée par une tâche depuis le dernier wait().
+ */
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> guard(sleepLock);
+	idle.wait(guard, [this] { return pending == 0; });
+	if (failure)
+	{
+		std::exception_ptr error = failure;
+		failure = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+/**
+ * @brief Nombre de threads du pool.
+ */
+unsigned ThreadPool::getThreadCount() const
+{
+	return static_cast<unsigned>(workers.size());
+}
+
+/**
+ * @brief Temps cumulé passé par un thread à exécuter des tâches, en nanosecondes.
+ *
+ * @param worker Indice du thread.
+ */
+uint64_t ThreadPool::getBusyNs(unsigned worker) const
+{
+	return workers[worker]->busyNs.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Remet à zéro les temps d'activité de tous les threads.
+ */
+void ThreadPool::resetBusy()
+{
+	for (std::unique_ptr<Worker>& worker : workers)
+		worker->busyNs.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Prend une tâche : la plus récente de sa propre file, sinon la plus
+ * ancienne d'une autre file.
+ *
+ * @param index Indice du thread demandeur.
+ * @param task [out] Tâche obtenue.
+ * @return true si une tâche a été obtenue.
+ */
+bool ThreadPool::takeTask(unsigned index, std::function<void()>& task)
+{
+	size_t count = workers.size();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Worker& worker = *workers[(index + i) % count];
+		std::lock_guard<std::mutex> guard(worker.lock);
+
+		if (worker.tasks.empty())
+			continue;
+		if (i == 0)
+		{
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+		}
+		queued.fetch_sub(1);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Boucle d'un thread : exécute ou vole des tâches, dort quand il n'y en a plus.
+ *
+ * @param index Indice du thread.
+ */
+void ThreadPool::workerLoop(unsigned index)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	t_pool = this;
+	t_worker = static_cast<int>(index);
+	for (;;)
+	{
+		std::function<void()> task;
+
+		if (!takeTask(index, task))
+		{
+			std::unique_lock<std::mutex> guard(sleepLock);
+			wake.wait(guard, [this] { return stopping || queued > 0; });
+			if (stopping && queued == 0)
+				return;
+			continue;
+		}
+
+		Clock::time_point start = Clock::now();
+		try {
+			task();
+		} catch (...) {
+			std::lock_guard<std::mutex> guard(sleepLock);
+			if (!failure)
+				failure = std::current_exception();
+		}
+		workers[index]->busyNs.fetch_add(static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()),
+			std::memory_order_relaxed);
+
+		if (pending.fetch_sub(1) == 1)
+		{
+			std::lock_guard<std::mutex> guard(sleepLock);
+			idle.notify_all();
+		}
+	}
+}
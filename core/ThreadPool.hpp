@@ -0,0 +1,77 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Déclaration de la classe ThreadPool, pool de threads à vol de tâches.
+ *
+ * Chaque thread possède sa propre file de tâches : il dépile les siennes par
+ * la fin et, quand elle est vide, vole la tâche la plus ancienne d'un autre
+ * thread. Les tâches de durées très inégales (parties courtes ou longues)
+ * se répartissent ainsi sans coordination centrale.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Pool de threads persistant avec une file par thread et vol de tâches.
+ *
+ * Une tâche soumise depuis un thread du pool va dans la file de ce thread ;
+ * depuis l'extérieur, les files sont remplies à tour de rôle. wait() bloque
+ * jusqu'à ce que toutes les tâches soumises soient terminées et relance la
+ * première exception levée par l'une d'elles.
+ *
+ * Le temps passé par chaque thread à exécuter des tâches est cumulé pour
+ * mesurer l'utilisation de chaque cœur.
+ */
+class ThreadPool
+{
+	public:
+		explicit ThreadPool(unsigned count);
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		~ThreadPool();
+
+		void		submit(std::function<void()> task);
+		void		wait();
+		unsigned	getThreadCount() const;
+		uint64_t	getBusyNs(unsigned worker) const;
+		void		resetBusy();
+
+		static int	currentWorker();
+		static unsigned	defaultThreadCount();
+
+	private:
+		/**
+		 * @brief File et compteurs propres à un thread (sur sa propre ligne de cache).
+		 */
+		struct alignas(64) Worker
+		{
+			std::mutex							lock;	///< Protège la file.
+			std::deque<std::function<void()>>	tasks;	///< Tâches en attente.
+			std::atomic<uint64_t>				busyNs;	///< Temps passé dans les tâches.
+		};
+
+		void	workerLoop(unsigned index);
+		bool	takeTask(unsigned index, std::function<void()>& task);
+
+		std::vector<std::unique_ptr<Worker>>	workers;	///< Une file par thread.
+		std::vector<std::thread>				threads;	///< Threads du pool.
+		std::mutex								sleepLock;	///< Protège l'endormissement et la fin.
+		std::condition_variable					wake;		///< Réveille les threads inactifs.
+		std::condition_variable					idle;		///< Signale que tout est terminé.
+		std::atomic<size_t>						queued;		///< Tâches en file.
+		std::atomic<size_t>						pending;	///< Tâches en file ou en cours.
+		std::atomic<unsigned>					nextQueue;	///< File suivante pour une soumission externe.
+		std::exception_ptr						failure;	///< Première exception levée par une tâche.
+		bool									stopping;	///< Arrêt demandé par le destructeur.
+};
@@ -0,0 +1,191 @@
+/**
+ * @file TickScheduler.cpp
+ * @brief Implémentation de la cadence fixe de la simulation.
+ */
+
+#include "TickScheduler.hpp"
+#include <stdexcept>
+
+/**
+ * @brief Constructeur par défaut : 10 ticks par seconde.
+ */
+TickScheduler::TickScheduler() : TickScheduler(10.0)
+{}
+
+/**
+ * @brief Construit une cadence de `tickRate` ticks par seconde.
+ *
+ * @param tickRate Fréquence de la simulation, en Hz.
+ * @throw std::invalid_argument si la fréquence n'est pas strictement positive.
+ */
+TickScheduler::TickScheduler(double tickRate)
+	: intervalNs(0), accumulatorNs(0), scheduled(0), nextIndex(1), ticks(0), skipped(0)
+{
+	if (!(tickRate > 0))
+		throw std::invalid_argument("tick rate must be positive");
+	intervalNs = static_cast<int64_t>(1e9 / tickRate);
+	if (intervalNs < 1)
+		intervalNs = 1;
+	start();
+}
+
+/**
+ * @brief Constructeur de copie.
+ */
+TickScheduler::TickScheduler(const TickScheduler& other)
+	: intervalNs(other.intervalNs), accumulatorNs(other.accumulatorNs),
+	  origin(other.origin), last(other.last), scheduled(other.scheduled),
+	  nextIndex(other.nextIndex), ticks(other.ticks), skipped(other.skipped),
+	  drift(other.drift)
+{}
+
+/**
+ * @brief Opérateur d'affectation.
+ */
+TickScheduler& TickScheduler::operator=(const TickScheduler& other)
+{
+	if (this != &other)
+	{
+		intervalNs = other.intervalNs;
+		accumulatorNs = other.accumulatorNs;
+		origin = other.origin;
+		last = other.last;
+		scheduled = other.scheduled;
+		nextIndex = other.nextIndex;
+		ticks = other.ticks;
+		skipped = other.skipped;
+		drift = other.drift;
+	}
+	return *this;
+}
+
+/**
+ * @brief Destructeur par défaut.
+ */
+TickScheduler::~TickScheduler() {}
+
+/**
+ * @brief (Re)démarre la cadence maintenant, sans retard accumulé.
+ *
+ * À appeler après une pause (menu d'aide, changement de GUI) pour que le
+ * temps passé hors du jeu ne soit pas rattrapé. Les statistiques sont
+ * conservées.
+ */
+void TickScheduler::start()
+{
+	origin = Clock::now();
+	last = origin;
+	accumulatorNs = 0;
+	scheduled = 0;
+	nextIndex = 1;
+}
+
+/**
+ * @brief Ajoute le temps écoulé depuis l'appel précédent et compte les ticks dus.
+ *
+ * @return Le nombre de ticks à jouer maintenant (0 à MAX_CATCH_UP).
+ */
+int TickScheduler::advance()
+{
+	Clock::time_point now = Clock::now();
+	accumulatorNs += std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+	last = now;
+
+	int64_t due = accumulatorNs / intervalNs;
+	if (due > MAX_CATCH_UP)
+	{
+		skipped += due - MAX_CATCH_UP;
+		scheduled += due - MAX_CATCH_UP;
+		accumulatorNs -= (due - MAX_CATCH_UP) * intervalNs;
+		due = MAX_CATCH_UP;
+	}
+	accumulatorNs -= due * intervalNs;
+	nextIndex = scheduled + 1;
+	scheduled += due;
+	return static_cast<int>(due);
+}
+
+/**
+ * @brief Date un tick qui vient d'être joué et enregistre son retard.
+ *
+ * À appeler après chacun des ticks annoncés par advance(), dans l'ordre.
+ */
+void TickScheduler::recordTick()
+{
+	Clock::time_point ideal = origin + std::chrono::nanoseconds(nextIndex++ * intervalNs);
+	int64_t late = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - ideal).count();
+
+	drift.record(late > 0 ? static_cast<uint64_t>(late) : 0);
+	++ticks;
+}
+
+/**
+ * @brief Fraction du tick en cours déjà écoulée (0 juste après un tick, proche de 1 juste avant le suivant).
+ */
+float TickScheduler::getAlpha() const
+{
+	return static_cast<float>(accumulatorNs) / static_cast<float>(intervalNs);
+}
+
+/**
+ * @brief Instant auquel le prochain tick sera dû.
+ */
+TickScheduler::Clock::time_point TickScheduler::nextTick() const
+{
+	return last + std::chrono::nanoseconds(intervalNs - accumulatorNs);
+}
+
+/**
+ * @brief Durée d'un tick.
+ */
+TickScheduler::Clock::duration TickScheduler::getInterval() const
+{
+	return std::chrono::nanoseconds(intervalNs);
+}
+
+/**
+ * @brief Fréquence de la simulation, en Hz.
+ */
+double TickScheduler::getTickRate() const
+{
+	return 1e9 / static_cast<double>(intervalNs);
+}
+
+/**
+ * @brief Nombre de ticks joués.
+ */
+uint64_t TickScheduler::getTicks() const
+{
+	return ticks;
+}
+
+/**
+ * @brief Nombre de ticks abandonnés faute de pouvoir rattraper le retard.
+ */
+uint64_t TickScheduler::getSkipped() const
+{
+	return skipped;
+}
+
+/**
+ * @brief Histogramme du retard de chaque tick sur son instant idéal, en nanosecondes.
+ */
+const Histogram& TickScheduler::getDrift() const
+{
+	return drift;
+}
+
+/**
+ * @brief Affiche les statistiques de cadence, une mesure par ligne (`clé: valeur`).
+ *
+ * @param out Flux de sortie.
+ */
+void TickScheduler::printReport(std::ostream& out) const
+{
+	out << "tick_rate_hz: " << getTickRate() << "\n"
+	    << "ticks: " << ticks << "\n"
+	    << "ticks_skipped: " << skipped << "\n"
+	    << "tick_drift_p50_ns: " << drift.percentile(50) << "\n"
+	    << "tick_drift_p99_ns: " << drift.percentile(99) << "\n"
+	    << "tick_drift_max_ns: " << drift.getMax() << "\n";
+}
@@ -0,0 +1,63 @@
+/**
+ * @file TickScheduler.hpp
+ * @brief Déclaration de la classe TickScheduler, cadence fixe de la simulation.
+ *
+ * La simulation avance par ticks de durée fixe, indépendamment du nombre
+ * d'images affichées : le temps réel écoulé s'accumule et chaque tranche
+ * complète déclenche un tick. La fraction restante sert à interpoler
+ * l'affichage entre deux ticks.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "Histogram.hpp"
+
+/**
+ * @class TickScheduler
+ * @brief Accumulateur de temps à pas fixe, avec statistiques de dérive.
+ *
+ * À chaque image, advance() indique combien de ticks jouer (au plus
+ * MAX_CATCH_UP : au-delà, le retard est abandonné plutôt que rattrapé, pour
+ * ne pas s'emballer après une pause). Chaque tick joué est daté par
+ * recordTick() : son retard sur l'instant idéal est enregistré dans un
+ * histogramme.
+ */
+class TickScheduler
+{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		static const int MAX_CATCH_UP = 5;	///< Ticks joués au plus par image.
+
+		TickScheduler();
+		explicit TickScheduler(double tickRate);
+		TickScheduler(const TickScheduler& other);
+		TickScheduler& operator=(const TickScheduler& other);
+		~TickScheduler();
+
+		void				start();
+		int					advance();
+		void				recordTick();
+		float				getAlpha() const;
+		Clock::time_point	nextTick() const;
+		Clock::duration		getInterval() const;
+		double				getTickRate() const;
+		uint64_t			getTicks() const;
+		uint64_t			getSkipped() const;
+		const Histogram&	getDrift() const;
+		void				printReport(std::ostream& out) const;
+
+	private:
+		int64_t				intervalNs;		///< Durée d'un tick.
+		int64_t				accumulatorNs;	///< Temps écoulé pas encore consommé par un tick.
+		Clock::time_point	origin;			///< Début de la cadence courante.
+		Clock::time_point	last;			///< Dernier appel à advance().
+		uint64_t			scheduled;		///< Ticks échus depuis origin (joués ou abandonnés).
+		uint64_t			nextIndex;		///< Rang du prochain tick à dater.
+		uint64_t			ticks;			///< Ticks joués.
+		uint64_t			skipped;		///< Ticks abandonnés (retard trop important).
+		Histogram			drift;			///< Retard de chaque tick sur son instant idéal (ns).
+};
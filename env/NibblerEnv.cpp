@@ -0,0 +1,196 @@
+/**
+ * @file NibblerEnv.cpp
+ * @brief Implémentation du lot de parties de libnibbler_env.so.
+ */
+
+#include "NibblerEnv.hpp"
+#include "../core/Rng.hpp"
+#include <cstring>
+#include <stdexcept>
+
+const int NibblerEnv::MIN_SIZE;
+const size_t NibblerEnv::PLANES;
+const int NibblerEnv::HUNGER_FACTOR;
+
+namespace
+{
+	const uint64_t SEED_STRIDE = 0x9E3779B97F4A7C15ull;	///< Écart entre les suites de graines de deux parties.
+}
+
+/**
+ * @brief Constructeur : crée les parties, aucun tampon n'est encore lié.
+ *
+ * @param envs Nombre de parties.
+ * @param width Largeur des plateaux, bords compris.
+ * @param height Hauteur des plateaux, bords compris.
+ * @param seed Graine du lot (chaque partie en dérive sa propre suite).
+ * @throw std::invalid_argument si `envs` est nul ou le plateau plus petit que MIN_SIZE.
+ */
+NibblerEnv::NibblerEnv(size_t envs, int width, int height, uint64_t seed)
+	: _width(width), _height(height), _area(0), _observations(nullptr)
+{
+	if (envs == 0)
+		throw std::invalid_argument("NibblerEnv: no environment");
+	if (width < MIN_SIZE || height < MIN_SIZE)
+		throw std::invalid_argument("NibblerEnv: board is too small");
+	_area = static_cast<size_t>(width) * height;
+
+	_games.reserve(envs);
+	_seeds.resize(envs);
+	_hunger.assign(envs, 0);
+	for (size_t i = 0; i < envs; ++i)
+	{
+		_seeds[i] = seed + i * SEED_STRIDE;
+		_games.emplace_back(width, height, false, Rng::splitmix64(_seeds[i]));
+		_games.back().setScoreLimit(0);
+	}
+}
+
+/**
+ * @brief Destructeur par défaut (le tampon appartient à l'appelant).
+ */
+NibblerEnv::~NibblerEnv() {}
+
+/**
+ * @brief Nombre de parties.
+ */
+size_t NibblerEnv::size() const
+{
+	return _games.size();
+}
+
+/**
+ * @brief Octets d'observation par partie (PLANES plans de largeur * hauteur cases).
+ */
+size_t NibblerEnv::observationSize() const
+{
+	return PLANES * _area;
+}
+
+/**
+ * @brief Recommence toutes les parties et écrit leurs plans en entier dans `observations`.
+ *
+ * @param observations Tampon de size() * observationSize() octets, lié jusqu'au prochain reset().
+ */
+void NibblerEnv::reset(uint8_t* observations)
+{
+	_observations = observations;
+	for (size_t i = 0; i < _games.size(); ++i)
+		restart(i);
+}
+
+/**
+ * @brief Fait avancer chaque partie d'un tick et met ses plans à jour en place.
+ *
+ * Avant le tick, la tête, la queue et la nourriture sont notées ; après,
+ * seules ces cases et la nouvelle tête sont réécrites. La queue est effacée
+ * avant que la tête ne soit posée : la tête peut entrer dans la case que la
+ * queue vient de libérer.
+ *
+ * @param actions Une action par partie (0 à 3 : direction, sinon aucune).
+ * @param rewards [out] +1 pour un repas, -1 pour une mort, 0 sinon.
+ * @param dones [out] 1 pour une partie terminée (et recommencée), 0 sinon.
+ * @return false si aucun tampon n'est lié (rien n'est fait).
+ */
+bool NibblerEnv::step(const uint8_t* actions, float* rewards, uint8_t* dones)
+{
+	if (!_observations)
+		return false;
+
+	const uint32_t starving = static_cast<uint32_t>(HUNGER_FACTOR * _area);
+	const size_t stride = observationSize();
+	for (size_t i = 0; i < _games.size(); ++i)
+	{
+		GameState& game = _games[i];
+		const Snake& snake = game.getSnake();
+		uint8_t* planes = _observations + i * stride;
+
+		if (actions[i] < 4)
+			game.setDirection(static_cast<Input>(actions[i]));
+		Point oldHead = snake.getHead();
+		Point oldTail = snake.getTail();
+		Point oldFood = game.getFood();
+		size_t oldLength = snake.getLength();
+		game.update();
+
+		bool ate = snake.getLength() != oldLength;
+		_hunger[i] = ate ? 0 : _hunger[i] + 1;
+		rewards[i] = ate ? 1.0f : 0.0f;
+		if (game.isFinished() || _hunger[i] >= starving)
+		{
+			if (game.isFinished() && !game.isWon())
+				rewards[i] = -1.0f;
+			dones[i] = 1;
+			restart(i);
+			continue;
+		}
+		dones[i] = 0;
+
+		const Point& head = snake.getHead();
+		if (!ate)
+			*cell(planes, SNAKE_PLANE, oldTail) = 0;
+		*cell(planes, HEAD_PLANE, oldHead) = 0;
+		*cell(planes, SNAKE_PLANE, head) = 1;
+		*cell(planes, HEAD_PLANE, head) = 1;
+		if (ate)
+		{
+			*cell(planes, FOOD_PLANE, oldFood) = 0;
+			*cell(planes, FOOD_PLANE, game.getFood()) = 1;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Écrit en entier les plans d'une partie.
+ *
+ * @param env Indice de la partie.
+ * @param out Tampon de observationSize() octets.
+ */
+void NibblerEnv::writeObservation(size_t env, uint8_t* out) const
+{
+	const GameState& game = _games[env];
+	const Grid& grid = game.getGrid();
+	BodyView body = game.getSnake().getBody();
+
+	std::memset(out, 0, observationSize());
+	for (const PointSpan& span : { body.first, body.second })
+		for (const Point& p : span)
+			*cell(out, SNAKE_PLANE, p) = 1;
+	*cell(out, HEAD_PLANE, game.getSnake().getHead()) = 1;
+	*cell(out, FOOD_PLANE, game.getFood()) = 1;
+
+	uint8_t* obstacles = out + OBSTACLE_PLANE * _area;
+	for (int y = 0; y < _height; ++y)
+	{
+		const Cell* row = grid.getRow(y);
+		for (int x = 0; x < _width; ++x)
+			obstacles[static_cast<size_t>(y) * _width + x] = row[x] == Cell::WALL || row[x] == Cell::OBSTACLE;
+	}
+}
+
+/**
+ * @brief Partie d'indice donné.
+ */
+const GameState& NibblerEnv::getGame(size_t env) const
+{
+	return _games[env];
+}
+
+/**
+ * @brief Octet d'une case dans un plan d'une partie.
+ */
+uint8_t* NibblerEnv::cell(uint8_t* planes, Plane plane, const Point& p) const
+{
+	return planes + plane * _area + static_cast<size_t>(p.y) * _width + p.x;
+}
+
+/**
+ * @brief Recommence une partie avec la graine suivante de sa suite et réécrit ses plans.
+ */
+void NibblerEnv::restart(size_t env)
+{
+	_games[env].restart(Rng::splitmix64(_seeds[env]));
+	_hunger[env] = 0;
+	writeObservation(env, _observations + env * observationSize());
+}
@@ -0,0 +1,66 @@
+/**
+ * @file NibblerEnv.hpp
+ * @brief Déclaration de la classe NibblerEnv, lot de parties derrière l'API C de libnibbler_env.so.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../core/GameState.hpp"
+
+/**
+ * @class NibblerEnv
+ * @brief N parties GameState et leurs plans d'observation dans un tampon de l'appelant.
+ *
+ * reset() écrit les plans en entier ; step() n'écrit ensuite que les cases
+ * qui changent pendant le tick (tête, queue, nourriture), soit quelques
+ * octets par partie quelle que soit la taille du plateau. Une partie qui se
+ * termine est recommencée en place (GameState::restart()) et ses plans
+ * réécrits : sans obstacles, aucun pas n'alloue de mémoire.
+ *
+ * Non copiable : les parties écrivent dans le tampon lié.
+ */
+class NibblerEnv
+{
+	public:
+		static const int MIN_SIZE = 10;			///< Côté minimal du plateau, bords compris.
+		static const size_t PLANES = 4;			///< Plans d'observation par partie.
+		static const int HUNGER_FACTOR = 4;		///< Ticks sans manger, en multiples de la surface, avant abandon.
+
+		NibblerEnv(size_t envs, int width, int height, uint64_t seed);
+		NibblerEnv(const NibblerEnv&) = delete;
+		NibblerEnv& operator=(const NibblerEnv&) = delete;
+		~NibblerEnv();
+
+		size_t				size() const;
+		size_t				observationSize() const;
+		void				reset(uint8_t* observations);
+		bool				step(const uint8_t* actions, float* rewards, uint8_t* dones);
+		void				writeObservation(size_t env, uint8_t* out) const;
+		const GameState&	getGame(size_t env) const;
+
+	private:
+		/**
+		 * @brief Plans d'une partie dans un tampon d'observations.
+		 */
+		enum Plane
+		{
+			SNAKE_PLANE,
+			HEAD_PLANE,
+			FOOD_PLANE,
+			OBSTACLE_PLANE,
+		};
+
+		uint8_t*	cell(uint8_t* planes, Plane plane, const Point& p) const;
+		void		restart(size_t env);
+
+		int						_width;			///< Largeur commune des plateaux.
+		int						_height;		///< Hauteur commune des plateaux.
+		size_t					_area;			///< Cases d'un plateau.
+		std::vector<GameState>	_games;			///< Une partie par environnement.
+		std::vector<uint64_t>	_seeds;			///< Suite des graines de chaque environnement.
+		std::vector<uint32_t>	_hunger;		///< Ticks depuis le dernier repas.
+		uint8_t*				_observations;	///< Tampon lié par reset(), nul sinon.
+};
@@ -0,0 +1,71 @@
+/**
+ * @file nibbler_env.cpp
+ * @brief Fonctions exportées par libnibbler_env.so (voir nibbler_env.h).
+ *
+ * Chaque fonction traduit son appel vers NibblerEnv ; aucune exception ne
+ * traverse l'API C.
+ */
+
+#include "nibbler_env.h"
+#include "NibblerEnv.hpp"
+#include <new>
+
+static_assert(NIBBLER_ENV_PLANES == NibblerEnv::PLANES, "nibbler_env.h and NibblerEnv disagree on planes");
+static_assert(NIBBLER_ENV_HUNGER_FACTOR == NibblerEnv::HUNGER_FACTOR, "nibbler_env.h and NibblerEnv disagree on hunger");
+
+/**
+ * @brief Environnement opaque de l'API C.
+ */
+struct nibbler_env
+{
+	NibblerEnv	env;	///< Parties et tampon lié.
+
+	nibbler_env(size_t envs, int width, int height, uint64_t seed) : env(envs, width, height, seed) {}
+};
+
+extern "C" nibbler_env* nibbler_env_create(int n_envs, int width, int height, uint64_t seed)
+{
+	if (n_envs <= 0)
+		return nullptr;
+	try
+	{
+		return new nibbler_env(static_cast<size_t>(n_envs), width, height, seed);
+	}
+	catch (const std::exception&)
+	{
+		return nullptr;
+	}
+}
+
+extern "C" void nibbler_env_destroy(nibbler_env* env)
+{
+	delete env;
+}
+
+extern "C" size_t nibbler_env_observation_size(const nibbler_env* env)
+{
+	return env ? env->env.observationSize() : 0;
+}
+
+extern "C" int nibbler_env_reset(nibbler_env* env, uint8_t* observations)
+{
+	if (!env || !observations)
+		return -1;
+	env->env.reset(observations);
+	return 0;
+}
+
+extern "C" int nibbler_env_step(nibbler_env* env, const uint8_t* actions, float* rewards, uint8_t* dones)
+{
+	if (!env || !actions || !rewards || !dones)
+		return -1;
+	return env->env.step(actions, rewards, dones) ? 0 : -1;
+}
+
+extern "C" int nibbler_env_write_observation(const nibbler_env* env, int index, uint8_t* out)
+{
+	if (!env || !out || index < 0 || static_cast<size_t>(index) >= env->env.size())
+		return -1;
+	env->env.writeObservation(static_cast<size_t>(index), out);
+	return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file nibbler_env.h
+ * @brief API C de libnibbler_env.so : lots de parties pour l'apprentissage par renforcement.
+ *
+ * Un environnement regroupe `n_envs` parties de même taille, qui suivent
+ * exactement les règles du jeu (GameState). Les observations sont écrites
+ * directement dans un tampon fourni par l'appelant, lié par
+ * nibbler_env_reset() : chaque appel à nibbler_env_step() n'y modifie que
+ * les cases qui ont changé, sans copie ni allocation.
+ *
+ * Disposition du tampon (`uint8_t`, contigu) :
+ * `obs[env][plan][y][x]`, soit nibbler_env_observation_size() octets par
+ * partie, avec NIBBLER_ENV_PLANES plans de `width * height` cases valant
+ * 0 ou 1 : serpent (tête comprise), tête, nourriture, obstacles (murs du
+ * bord compris).
+ *
+ * Actions (`uint8_t`, une par partie) : 0 haut, 1 bas, 2 gauche, 3 droite ;
+ * toute autre valeur garde la direction courante (un demi-tour aussi).
+ *
+ * Les parties n'ont pas de score limite : une partie se termine par la
+ * mort, le plateau plein, ou après NIBBLER_ENV_HUNGER_FACTOR * surface ticks
+ * sans manger. Elle recommence aussitôt avec la graine suivante : après un
+ * pas où `dones[i]` vaut 1, l'observation de la partie `i` est le premier
+ * état de la nouvelle partie.
+ *
+ * Aucune fonction n'est sûre si elle est appelée sur le même environnement
+ * depuis plusieurs threads à la fois ; des environnements distincts sont
+ * indépendants.
+ */
+
+#ifndef NIBBLER_ENV_H
+#define NIBBLER_ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NIBBLER_ENV_PLANES 4			/**< Plans d'observation par partie. */
+#define NIBBLER_ENV_HUNGER_FACTOR 4		/**< Ticks sans manger (multiples de la surface) avant abandon. */
+
+/** Environnement opaque. */
+typedef struct nibbler_env nibbler_env;
+
+/**
+ * @brief Crée `n_envs` parties de `width` x `height` cases (bords compris, au moins 10 x 10).
+ *
+ * @return L'environnement, ou NULL si un argument est invalide ou si la mémoire manque.
+ */
+nibbler_env*	nibbler_env_create(int n_envs, int width, int height, uint64_t seed);
+
+/**
+ * @brief Détruit un environnement (sans effet sur NULL).
+ */
+void			nibbler_env_destroy(nibbler_env* env);
+
+/**
+ * @brief Octets d'observation par partie : NIBBLER_ENV_PLANES * width * height.
+ */
+size_t			nibbler_env_observation_size(const nibbler_env* env);
+
+/**
+ * @brief Recommence toutes les parties et lie le tampon d'observations.
+ *
+ * Les parties reprennent la suite de leurs graines. Le tampon (n_envs *
+ * nibbler_env_observation_size() octets) est entièrement écrit ; il doit
+ * ensuite rester en place et inchangé jusqu'au prochain reset.
+ *
+ * @return 0, ou -1 si un argument est nul.
+ */
+int				nibbler_env_reset(nibbler_env* env, uint8_t* observations);
+
+/**
+ * @brief Fait avancer toutes les parties d'un tick.
+ *
+ * Récompense de chaque partie : +1 par nourriture mangée, -1 en cas de
+ * mort, 0 sinon.
+ *
+ * @param actions Une action par partie.
+ * @param rewards [out] Une récompense par partie.
+ * @param dones [out] 1 pour une partie terminée (et recommencée), 0 sinon.
+ * @return 0, ou -1 si un argument est nul ou si aucun tampon n'est lié.
+ */
+int				nibbler_env_step(nibbler_env* env, const uint8_t* actions, float* rewards, uint8_t* dones);
+
+/**
+ * @brief Réécrit en entier l'observation d'une partie à partir de son état.
+ *
+ * Le résultat est celui que nibbler_env_step() tient à jour en place dans
+ * le tampon lié : cette fonction sert à le vérifier.
+ *
+ * @param index Indice de la partie (0 à n_envs - 1).
+ * @param out [out] Tampon de nibbler_env_observation_size() octets.
+ * @return 0, ou -1 si un argument est nul ou l'indice hors du lot.
+ */
+int				nibbler_env_write_observation(const nibbler_env* env, int index, uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
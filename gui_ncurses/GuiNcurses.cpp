@@ -8,8 +8,10 @@
  */
 
 #include "GuiNcurses.hpp"
+#include "../includes/ScopedTimer.hpp"
 #include <iostream> // pour std::cout utilisé dans checkTerminalSize
-
+#include <algorithm>
+#include <stdexcept>
 
 /**
  * @brief Constructeur par défaut de GuiNcurses.
@@ -17,19 +19,24 @@
  * Initialise les dimensions de l'écran à 0.
  */
 GuiNcurses::GuiNcurses()
-	: _screenWidth(0), _screenHeight(0)
+	: _screenWidth(0), _screenHeight(0), _screen(nullptr), _fullRedraw(true), _helpShown(false), _termWidth(0), _termHeight(0),
+	  _score(0), _seed(0), _obstacleCount(0), _actorsStale(false), _head(-1), _food(-1), _stats(nullptr)
 {}
 
 /**
  * @brief Constructeur de copie pour GuiNcurses.
  *
- * Copie les dimensions de l'écran depuis un autre objet GuiNcurses.
+ * Copie les dimensions de l'écran depuis un autre objet GuiNcurses. L'écran
+ * ncurses n'est pas partagé : la copie doit être initialisée avec init().
  *
  * @param other L'objet GuiNcurses à copier.
  */
 GuiNcurses::GuiNcurses(const GuiNcurses& other)
-	: _screenWidth(other._screenWidth), _screenHeight(other._screenHeight)
-{}
+	: GuiNcurses()
+{
+	_screenWidth = other._screenWidth;
+	_screenHeight = other._screenHeight;
+}
 
 /**
  * @brief Opérateur d'affectation pour GuiNcurses.
@@ -45,6 +52,7 @@ GuiNcurses& GuiNcurses::operator=(const GuiNcurses& other)
 	{
 		_screenWidth  = other._screenWidth;
 		_screenHeight = other._screenHeight;
+		_fullRedraw = true;
 	}
 	return *this;
 }
@@ -83,13 +91,30 @@ void GuiNcurses::checkTerminalSize(int requiredWidth, int requiredHeight)
  * @param height Hauteur de la zone de jeu.
  */
 void GuiNcurses::init(int width, int height)
+{
+	init(width, height, stdout);
+}
+
+/**
+ * @brief Initialise ncurses en écrivant vers un flux donné.
+ *
+ * Permet notamment de mesurer ce qui est envoyé au terminal en redirigeant
+ * l'affichage vers un fichier.
+ *
+ * @param width Largeur de la zone de jeu.
+ * @param height Hauteur de la zone de jeu.
+ * @param output Flux du terminal (stdout en jeu).
+ */
+void GuiNcurses::init(int width, int height, FILE* output)
 {
 	_screenWidth = width;
 	_screenHeight = height;
-	WINDOW* win = initscr();
-	refresh();
-	if (win == nullptr)
+	_fullRedraw = true;
+	_helpShown = false;
+	_screen = newterm(nullptr, output, stdin);
+	if (_screen == nullptr)
 		throw std::runtime_error("Failed to initialize terminal");
+	refresh();
 	checkTerminalSize(width, height); 
 	noecho();
 	nodelay(stdscr, TRUE);
@@ -101,59 +126,379 @@ void GuiNcurses::init(int width, int height)
 }
 
 /**
- * @brief Dessine les obstacles du jeu.
- *
- * Cette fonction dessine les obstacles en utilisant des caractères spéciaux.
- *
- * @param obstacles Vecteur de points représentant les positions des obstacles.
+ * @brief Force un affichage complet au prochain frame.
  */
-void GuiNcurses::drawObstacles(const std::vector<Point>& obstacles)
+void GuiNcurses::invalidate()
 {
-	for (const Point& p : obstacles)
-	{
-		mvaddch(p.y, p.x, 'Z'); // caractère obstacle
-	}
+	_fullRedraw = true;
 }
 
-
 /**
  * @brief Affiche l'état du jeu ou le menu d'aide à l'écran avec Ncurses.
  * 
  * Si le menu d'aide est actif, affiche une liste des touches disponibles
  * pour contrôler le jeu, et met automatiquement la partie en pause.
- * Sinon, dessine l'état de la partie : le score, les murs, le serpent,
- * la nourriture et les obstacles.
+ * Sinon, dessine l'état de la partie : seules les cases qui ont changé
+ * depuis le frame précédent sont réécrites, sauf lorsqu'un affichage
+ * complet est nécessaire (premier frame, sortie du menu d'aide, terminal
+ * redimensionné, nouveaux obstacles).
  * 
  * @param state État actuel du jeu (serpent, score, menu actif, etc.).
  */
-void	GuiNcurses::render(const GameState& state)
+void	GuiNcurses::render(const Frame& state)
 {
 	if (state.isHelpMenuActive())
 	{
-		clear();
-
-		mvprintw(2, 5, "CONTROLES");
-		mvprintw(4, 7, "[FLECHE DU HAUT] : Monter");
-		mvprintw(5, 7, "[FLECHE DU BAS] : Descendre");
-		mvprintw(6, 7, "[FLECHE DE GAUCHE]  : Gauche");
-		mvprintw(7, 7, "[FLECHE DE DROITE] : Droite");
-		mvprintw(8, 7, "h    : Afficher / Cacher ce menu");
-		mvprintw(9, 7, "esc / q : Quitter");
-		mvprintw(11, 5, "Appuyez sur 'h' pour reprendre la partie...");
-		if (refresh() == ERR) {
-			throw std::runtime_error("Failed to refresh ncurses window");
-		}
+		if (!_helpShown)
+			renderHelp();
 		return;
 	}
+
+	int termHeight, termWidth;
+	getmaxyx(stdscr, termHeight, termWidth);
+	if (_helpShown || termWidth != _termWidth || termHeight != _termHeight
+		|| state.getSeed() != _seed || state.getObstacles().size() != _obstacleCount)
+		_fullRedraw = true;
+
+	ScopedTimer draw(_stats, StatsPhase::DRAW);
+	if (_fullRedraw)
+		renderFull(state);
+	else
+		renderChanges(state);
+	draw.stop();
+
+	ScopedTimer present(_stats, StatsPhase::PRESENT);
+	if (refresh() == ERR) {
+		throw std::runtime_error("Failed to refresh ncurses window");
+	}
+}
+
+/**
+ * @brief Applique les événements d'un tick à l'affichage courant.
+ *
+ * Chaque événement ne touche que sa case (et l'ancienne tête, qui devient
+ * du corps) : le coût ne dépend que du nombre de changements. Refusé si un
+ * affichage complet est nécessaire (menu d'aide, terminal redimensionné,
+ * premier frame).
+ *
+ * @param events Changements depuis le frame affiché, dans l'ordre.
+ * @return false si render() doit être appelée à la place.
+ */
+bool	GuiNcurses::apply(const RenderEventList& events)
+{
+	int termHeight, termWidth;
+	getmaxyx(stdscr, termHeight, termWidth);
+	if (_fullRedraw || _helpShown || termWidth != _termWidth || termHeight != _termHeight)
+		return false;
+
+	ScopedTimer draw(_stats, StatsPhase::DRAW);
+	_touched.clear();
+	for (const RenderEvent& event : events)
+	{
+		int index = cellIndex(event.cell);
+		switch (event.type)
+		{
+			case RenderEventType::HEAD_ADDED:
+				if (_head >= 0)
+					setCell(_head, 'O');
+				_head = index;
+				if (index >= 0)
+					setCell(index, '@' | COLOR_PAIR(1));
+				break;
+			case RenderEventType::TAIL_REMOVED:
+				if (index == _head)
+					_head = -1;
+				if (index >= 0)
+					setCell(index, baseCell(index));
+				break;
+			case RenderEventType::FOOD_MOVED:
+				_food = index;
+				break;
+			case RenderEventType::SCORE_CHANGED:
+				drawScore(event.value);
+				break;
+			case RenderEventType::OBSTACLE_ADDED:
+				if (index >= 0)
+				{
+					_background[index] = 'Z';
+					setCell(index, 'Z');
+				}
+				++_obstacleCount;
+				break;
+			case RenderEventType::GAME_OVER:
+				break;
+		}
+	}
+	// Comme dans render(), la nourriture est peinte par-dessus le serpent
+	if (_food >= 0)
+		setCell(_food, '*' | COLOR_PAIR(2));
+	_actorsStale = true;
+	commit();
+	draw.stop();
+
+	ScopedTimer present(_stats, StatsPhase::PRESENT);
+	if (refresh() == ERR) {
+		throw std::runtime_error("Failed to refresh ncurses window");
+	}
+	return true;
+}
+
+/**
+ * @brief Mesure la construction (DRAW) et l'envoi au terminal (PRESENT) de chaque frame.
+ *
+ * @param stats Destination des mesures, ou nullptr.
+ */
+void	GuiNcurses::setStats(FrameStats* stats)
+{
+	_stats = stats;
+}
+
+/**
+ * @brief Affiche le menu d'aide à la place du plateau.
+ */
+void	GuiNcurses::renderHelp()
+{
 	clear();
-	mvprintw(1, 2, "Score: %d", state.getScore());
-	drawWalls(_screenWidth, _screenHeight);
-	drawSnake(state.getSnake().getBody());
-	drawFood(state.getFood());
-	drawObstacles(state.getObstacles());
+
+	mvprintw(2, 5, "CONTROLES");
+	mvprintw(4, 7, "[FLECHE DU HAUT] : Monter");
+	mvprintw(5, 7, "[FLECHE DU BAS] : Descendre");
+	mvprintw(6, 7, "[FLECHE DE GAUCHE]  : Gauche");
+	mvprintw(7, 7, "[FLECHE DE DROITE] : Droite");
+	mvprintw(8, 7, "h    : Afficher / Cacher ce menu");
+	mvprintw(9, 7, "esc / q : Quitter");
+	mvprintw(11, 5, "Appuyez sur 'h' pour reprendre la partie...");
 	if (refresh() == ERR) {
 		throw std::runtime_error("Failed to refresh ncurses window");
 	}
+	_helpShown = true;
+}
+
+/**
+ * @brief Efface l'écran et redessine tout le plateau.
+ *
+ * Seul cas où les murs et les obstacles sont écrits vers le terminal.
+ *
+ * @param state Frame à afficher.
+ */
+void	GuiNcurses::renderFull(const Frame& state)
+{
+	size_t area = static_cast<size_t>(_screenWidth) * _screenHeight;
+
+	clear();
+	getmaxyx(stdscr, _termHeight, _termWidth);
+	_helpShown = false;
+	_seed = state.getSeed();
+	_obstacleCount = state.getObstacles().size();
+	drawBackground(state);
+	_shown.assign(area, ' ');
+	_wanted.assign(area, ' ');
+	_actors.clear();
+	_touched.clear();
+	_scoreText.clear();
+	for (size_t i = 0; i < area; ++i)
+	{
+		if (_background[i] != ' ')
+		{
+			_wanted[i] = _background[i];
+			_touched.push_back(static_cast<int>(i));
+		}
+	}
+	drawScore(state.getScore());
+	paintActors(state);
+	commit();
+	_fullRedraw = false;
+}
+
+/**
+ * @brief Ne réécrit que les cases qui ont changé depuis le frame précédent.
+ *
+ * Les cases du serpent et de la nourriture affichés sont rendues au fond,
+ * puis le nouveau serpent et la nouvelle nourriture sont peints par-dessus :
+ * seules les cases dont le contenu final diffère de l'affichage sont écrites.
+ *
+ * @param state Frame à afficher.
+ */
+void	GuiNcurses::renderChanges(const Frame& state)
+{
+	if (_actorsStale)
+		rebuildActors();
+	_touched.clear();
+	for (int index : _actors)
+	{
+		_wanted[index] = baseCell(index);
+		_touched.push_back(index);
+	}
+	if (state.getScore() != _score)
+		drawScore(state.getScore());
+	paintActors(state);
+	commit();
+}
+
+/**
+ * @brief Construit le fond du plateau : murs et obstacles.
+ *
+ * @param state Frame dont les obstacles sont dessinés.
+ */
+void	GuiNcurses::drawBackground(const Frame& state)
+{
+	int width = _screenWidth;
+	int height = _screenHeight;
+
+	_background.assign(static_cast<size_t>(width) * height, ' ');
+	for (int x = 0; x < width; ++x)
+	{
+		_background[x] = '#';
+		_background[(height - 1) * width + x] = '#';
+	}
+	for (int y = 0; y < height; ++y)
+	{
+		_background[y * width] = '#';
+		_background[y * width + width - 1] = '#';
+	}
+	for (const Point& p : state.getObstacles())
+	{
+		if (p.x >= 0 && p.x < width && p.y >= 0 && p.y < height)
+			_background[p.y * width + p.x] = 'Z'; // caractère obstacle
+	}
+}
+
+/**
+ * @brief Contenu d'une case en l'absence de serpent et de nourriture.
+ *
+ * Le score est écrit sur le fond, sous les murs et les obstacles.
+ *
+ * @param index Indice de la case (y * largeur + x).
+ */
+chtype	GuiNcurses::baseCell(int index) const
+{
+	if (_background[index] != ' ')
+		return _background[index];
+
+	int offset = index - SCORE_ROW * _screenWidth - SCORE_COLUMN;
+	if (offset >= 0 && offset < static_cast<int>(_scoreText.size()))
+		return static_cast<unsigned char>(_scoreText[offset]);
+	return ' ';
+}
+
+/**
+ * @brief Met à jour le texte du score et marque ses cases à redessiner.
+ *
+ * Les cases occupées par le serpent ou la nourriture restent inchangées.
+ *
+ * @param score Nouveau score.
+ */
+void	GuiNcurses::drawScore(int score)
+{
+	size_t previous = _scoreText.size();
+	int first = SCORE_ROW * _screenWidth + SCORE_COLUMN;
+	int last = (SCORE_ROW + 1) * _screenWidth;
+
+	_score = score;
+	_scoreText = "Score: " + std::to_string(score);
+	size_t length = std::max(previous, _scoreText.size());
+	for (size_t i = 0; i < length && first + static_cast<int>(i) < last; ++i)
+	{
+		int index = first + static_cast<int>(i);
+		if (!isActor(_wanted[index]))
+			setCell(index, baseCell(index));
+	}
+}
+
+/**
+ * @brief Peint le serpent et la nourriture dans les cases voulues.
+ *
+ * Le corps est dessiné avec 'O', la tête avec '@' en vert et la
+ * nourriture avec '*' en rouge.
+ *
+ * @param state Frame à afficher.
+ */
+void	GuiNcurses::paintActors(const Frame& state)
+{
+	const Snake& snake = state.getSnake();
+	BodyView body = snake.getBody();
+	int width = _screenWidth;
+	int height = _screenHeight;
+
+	_actors.clear();
+	_actorsStale = false;
+	_head = -1;
+	auto paint = [&](const Point& p, chtype cell)
+	{
+		if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height)
+			return;
+		int index = p.y * width + p.x;
+		_wanted[index] = cell;
+		_actors.push_back(index);
+		_touched.push_back(index);
+	};
+
+	for (const PointSpan& span : { body.first, body.second })
+		for (const Point& p : span)
+			paint(p, 'O');
+	if (body.size() > 0)
+	{
+		paint(snake.getHead(), '@' | COLOR_PAIR(1));
+		_head = cellIndex(snake.getHead());
+	}
+	paint(state.getFood(), '*' | COLOR_PAIR(2));
+	_food = cellIndex(state.getFood());
+}
+
+/**
+ * @brief Retrouve les cases du serpent et de la nourriture affichées.
+ *
+ * Nécessaire seulement lorsqu'un render() suit un apply() : parcourt tout
+ * le plateau, sans rien écrire vers le terminal.
+ */
+void	GuiNcurses::rebuildActors()
+{
+	_actors.clear();
+	for (size_t i = 0; i < _wanted.size(); ++i)
+		if (isActor(_wanted[i]))
+			_actors.push_back(static_cast<int>(i));
+	_actorsStale = false;
+}
+
+/**
+ * @brief Change le contenu voulu d'une case et la marque à comparer.
+ */
+void	GuiNcurses::setCell(int index, chtype cell)
+{
+	_wanted[index] = cell;
+	_touched.push_back(index);
+}
+
+/**
+ * @brief Indice d'une case du plateau, -1 si elle est hors de l'écran.
+ */
+int	GuiNcurses::cellIndex(const Point& p) const
+{
+	if (p.x < 0 || p.x >= _screenWidth || p.y < 0 || p.y >= _screenHeight)
+		return -1;
+	return p.y * _screenWidth + p.x;
+}
+
+/**
+ * @brief Indique si une case affiche le serpent ou la nourriture.
+ */
+bool	GuiNcurses::isActor(chtype cell)
+{
+	return cell == 'O' || cell == ('@' | COLOR_PAIR(1)) || cell == ('*' | COLOR_PAIR(2));
+}
+
+/**
+ * @brief Écrit les cases touchées dont le contenu voulu diffère de l'affichage.
+ */
+void	GuiNcurses::commit()
+{
+	for (int index : _touched)
+	{
+		if (_wanted[index] == _shown[index])
+			continue;
+		mvaddch(index / _screenWidth, index % _screenWidth, _wanted[index]);
+		_shown[index] = _wanted[index];
+	}
 }
 
 /**
@@ -170,6 +515,12 @@ Input GuiNcurses::getInput()
 {
 	int key = getch();
 
+	if (key == KEY_RESIZE)
+	{
+		_fullRedraw = true;
+		return Input::NONE;
+	}
+
 	// Flèches directionnelles
 	if (key == 27)
 	{
@@ -208,10 +559,12 @@ Input GuiNcurses::getInput()
 void	GuiNcurses::cleanup()
 {
 	auto ret = endwin();
+	if (_screen != nullptr)
+		delscreen(_screen);
+	_screen = nullptr;
 	if (ret == ERR) {
 		throw std::runtime_error("Failed to end ncurses mode");
 	}
-
 }
 
 
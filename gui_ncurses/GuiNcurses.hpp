@@ -9,15 +9,28 @@
 
 #pragma once
 #include "../includes/IGui.hpp"
+#include <cstdint>
+#include <cstdio>
 #include <ncurses.h>
-#include "../core/GameState.hpp"
-#include "GuiNcursesDraw.hpp"
+#include <string>
+#include <vector>
+#include "../core/Frame.hpp"
 
 /**
  * @brief Implémentation Ncurses de l’interface IGui.
- * 
+ *
  * Cette classe fournit l’affichage en terminal du jeu Snake en utilisant la bibliothèque Ncurses.
  * Elle respecte le contrat défini dans IGui : init, render, getInput, cleanup.
+ *
+ * L'affichage est incrémental : la GUI garde une copie de ce qu'elle a
+ * affiché dans chaque case du plateau et ne réécrit que les cases qui
+ * changent d'un frame à l'autre (tête, queue, nourriture, score). Les murs
+ * et les obstacles ne sont dessinés que lors d'un affichage complet : au
+ * premier frame, à la fermeture du menu d'aide, après un redimensionnement
+ * du terminal ou lorsque les obstacles changent.
+ *
+ * apply() va plus loin : à partir des événements d'un tick, seules les cases
+ * concernées sont recalculées, sans parcourir le corps du serpent.
  */
 class GuiNcurses : public IGui
 {
@@ -28,15 +41,52 @@ class GuiNcurses : public IGui
 		~GuiNcurses() override = default;
 
 		void	init(int width, int height) override;
-		void	render(const GameState& state) override;
+		void	init(int width, int height, FILE* output);
+		void	render(const Frame& state) override;
+		bool	apply(const RenderEventList& events) override;
+		void	setStats(FrameStats* stats) override;
 		Input	getInput() override;
 		void	checkTerminalSize(int requiredWidth, int requiredHeight);
 		void	showVictory() override;
 		void	showGameOver() override;
 		void	cleanup() override;
-		void	drawObstacles(const std::vector<Point>& obstacles);
+		void	invalidate();
 
 	private:
+		void	renderHelp();
+		void	renderFull(const Frame& state);
+		void	renderChanges(const Frame& state);
+		void	drawBackground(const Frame& state);
+		void	drawScore(int score);
+		void	paintActors(const Frame& state);
+		void	rebuildActors();
+		void	setCell(int index, chtype cell);
+		void	commit();
+		chtype	baseCell(int index) const;
+		int		cellIndex(const Point& p) const;
+		static bool	isActor(chtype cell);
+
+		static const int SCORE_ROW = 1;		///< Ligne du score.
+		static const int SCORE_COLUMN = 2;	///< Colonne du score.
+
 		int	_screenWidth;	///< Largeur de l'écran en caractères
 		int	_screenHeight;	///< Hauteur de l'écran en caractères
+		SCREEN*	_screen;	///< Écran ncurses créé par init().
+		bool	_fullRedraw;	///< Le prochain frame doit redessiner tout le plateau.
+		bool	_helpShown;		///< Le menu d'aide est affiché.
+		int		_termWidth;		///< Largeur du terminal lors du dernier affichage.
+		int		_termHeight;	///< Hauteur du terminal lors du dernier affichage.
+		int		_score;			///< Score affiché.
+		std::string	_scoreText;	///< Texte du score affiché.
+		uint64_t	_seed;		///< Graine de la partie affichée.
+		size_t	_obstacleCount;	///< Nombre d'obstacles affichés.
+		std::vector<chtype>	_background;	///< Murs et obstacles, par case.
+		std::vector<chtype>	_wanted;		///< Contenu voulu de chaque case pour ce frame.
+		std::vector<chtype>	_shown;			///< Contenu affiché de chaque case.
+		std::vector<int>	_touched;		///< Cases à comparer pour ce frame.
+		std::vector<int>	_actors;		///< Cases du serpent et de la nourriture affichées.
+		bool	_actorsStale;	///< _actors est à reconstruire (après apply()).
+		int		_head;			///< Case de la tête affichée, -1 si hors du plateau.
+		int		_food;			///< Case de la nourriture affichée, -1 si hors du plateau.
+		FrameStats*	_stats;		///< Mesures du rendu (nul : aucune).
 };
@@ -0,0 +1,90 @@
+/**
+ * @file GuiNull.cpp
+ * @brief Implémentation de la classe GuiNull (rendu vide, entrées scriptées).
+ */
+
+#include "GuiNull.hpp"
+#include <cstdlib>
+
+
+GuiNull::GuiNull()
+	: _cursor(0), _rng(0), _frames(0)
+{}
+
+/**
+ * @brief Lit la configuration des entrées dans l'environnement.
+ *
+ * @param width  Largeur du plateau (ignorée).
+ * @param height Hauteur du plateau (ignorée).
+ */
+void GuiNull::init(int width, int height)
+{
+	(void)width;
+	(void)height;
+
+	const char* script = std::getenv("NIBBLER_NULL_INPUT");
+	const char* seed = std::getenv("NIBBLER_NULL_SEED");
+
+	_script = (script && std::string(script) != "random") ? script : "";
+	_cursor = 0;
+	_rng.seed(seed ? std::strtoull(seed, nullptr, 10) : 0);
+}
+
+/**
+ * @brief Rendu vide : compte seulement les frames.
+ *
+ * @param state L'état du jeu (ignoré).
+ */
+void GuiNull::render(const Frame& state)
+{
+	(void)state;
+	++_frames;
+}
+
+/**
+ * @brief Retourne l'entrée suivante du script, ou une entrée aléatoire.
+ *
+ * En mode aléatoire, la direction change en moyenne une fois sur huit.
+ *
+ * @return Input La direction ou l'action simulée.
+ */
+Input GuiNull::getInput()
+{
+	static const Input DIRECTIONS[] = { Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT };
+
+	if (_script.empty())
+	{
+		uint64_t draw = _rng.bounded(32);
+		return draw < 4 ? DIRECTIONS[draw] : Input::NONE;
+	}
+
+	char c = _script[_cursor];
+	_cursor = (_cursor + 1) % _script.size();
+	switch (c)
+	{
+		case 'U': return Input::UP;
+		case 'D': return Input::DOWN;
+		case 'L': return Input::LEFT;
+		case 'R': return Input::RIGHT;
+		case 'q': return Input::EXIT;
+		default:  return Input::NONE;
+	}
+}
+
+/**
+ * @brief Aucun écran de victoire en mode sans affichage.
+ */
+void GuiNull::showVictory()
+{}
+
+/**
+ * @brief Aucun écran de défaite en mode sans affichage.
+ */
+void GuiNull::showGameOver()
+{}
+
+/**
+ * @brief Rien à libérer.
+ */
+void GuiNull::cleanup()
+{}
@@ -0,0 +1,51 @@
+/**
+ * @file GuiNull.hpp
+ * @brief Déclaration de la classe GuiNull, interface graphique sans affichage.
+ *
+ * Cette classe implémente l'interface IGui sans rien afficher : elle sert à
+ * faire tourner le moteur de jeu sur une machine sans écran (intégration
+ * continue, mesures de performance) avec des entrées scriptées ou aléatoires.
+ */
+
+#pragma once
+#include "../includes/IGui.hpp"
+#include "../core/Rng.hpp"
+#include <string>
+
+#include "../core/Frame.hpp"
+
+/**
+ * @class GuiNull
+ * @brief Implémentation vide de l'interface IGui.
+ *
+ * Le rendu ne fait rien. Les entrées proviennent de la variable
+ * d'environnement `NIBBLER_NULL_INPUT` :
+ * - `random` (défaut) : changements de direction aléatoires, reproductibles
+ *   grâce à `NIBBLER_NULL_SEED` ;
+ * - sinon un script rejoué en boucle, un caractère par appel à getInput() :
+ *   `U`, `D`, `L`, `R` pour les directions, `q` pour quitter, tout autre
+ *   caractère pour « aucune entrée ».
+ *
+ * Elle est compilée en bibliothèque dynamique (.so) et chargée à l'exécution.
+ */
+class GuiNull : public IGui
+{
+	public:
+		GuiNull();
+		GuiNull(const GuiNull&) = delete;
+		GuiNull& operator=(const GuiNull&) = delete;
+		~GuiNull() override = default;
+
+		void	init(int width, int height) override;
+		void	render(const Frame& state) override;
+		Input	getInput() override;
+		void	showVictory() override;
+		void	showGameOver() override;
+		void	cleanup() override;
+
+	private:
+		std::string	_script;		///< Script d'entrées (vide en mode aléatoire).
+		size_t		_cursor;		///< Position courante dans le script.
+		Rng			_rng;			///< Générateur des entrées aléatoires.
+		uint64_t	_frames;		///< Nombre d'appels à render().
+};
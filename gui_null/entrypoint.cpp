@@ -0,0 +1,29 @@
+/**
+ * @file entrypoint.cpp
+ * @brief Point d'entrée pour la GUI sans affichage.
+ *
+ * Ce fichier contient la fonction d'entrée pour la bibliothèque GUI nulle,
+ * permettant de créer une instance de GuiNull.
+ */
+
+#include "GuiNull.hpp"
+
+/**
+ * @brief Point d'entrée utilisé par dlsym() pour créer dynamiquement l'objet GUI.
+ *
+ * @return Un pointeur vers un objet GuiNull qui implémente l'interface IGui.
+ */
+extern "C" IGui* createGui()
+{
+	return new GuiNull();
+}
+
+/**
+ * @brief Détruit une GUI créée par createGui(), dans la bibliothèque qui l'a allouée.
+ *
+ * @param gui La GUI à détruire (peut être nul).
+ */
+extern "C" void destroyGui(IGui* gui)
+{
+	delete gui;
+}
@@ -0,0 +1,297 @@
+/**
+ * @file CellRenderer.cpp
+ * @brief Implémentation de la classe CellRenderer.
+ */
+
+#include "CellRenderer.hpp"
+#include "../includes/Interpolation.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	/**
+	 * @brief Shader de sommets : place le coin gl_VertexID du carré de l'instance.
+	 *
+	 * Les quatre sommets d'un GL_TRIANGLE_STRIP sont (0,0), (1,0), (0,1), (1,1).
+	 * Le plateau est projeté avec l'origine en haut à gauche.
+	 */
+	const char* VERTEX_SHADER =
+		"#version 330 core\n"
+		"layout(location = 0) in vec4 instance;\n"
+		"uniform vec2 board;\n"
+		"uniform vec3 palette[6];\n"
+		"out vec3 color;\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+		"	vec2 cell = (instance.xy + corner * instance.z) / board;\n"
+		"	gl_Position = vec4(cell.x * 2.0 - 1.0, 1.0 - cell.y * 2.0, 0.0, 1.0);\n"
+		"	color = palette[int(instance.w)];\n"
+		"}\n";
+
+	/**
+	 * @brief Shader de fragments : couleur unie.
+	 */
+	const char* FRAGMENT_SHADER =
+		"#version 330 core\n"
+		"in vec3 color;\n"
+		"out vec4 fragment;\n"
+		"void main()\n"
+		"{\n"
+		"	fragment = vec4(color, 1.0);\n"
+		"}\n";
+
+	/**
+	 * @brief Couleurs de la palette, dans l'ordre de CellColor.
+	 */
+	const GLfloat PALETTE[][3] = {
+		{ 0.0f, 1.0f, 0.0f },	// tête : vert
+		{ 0.0f, 0.8f, 1.0f },	// corps : bleu cyan
+		{ 1.0f, 0.6f, 0.0f },	// nourriture : orange clair
+		{ 1.0f, 1.0f, 1.0f },	// score : blanc
+		{ 0.4f, 0.4f, 0.4f },	// obstacles : gris foncé
+		{ 1.0f, 1.0f, 1.0f },	// touches du menu d'aide : blanc
+	};
+
+	static_assert(sizeof(PALETTE) / sizeof(PALETTE[0]) == static_cast<size_t>(CellColor::COUNT),
+		"the shader palette holds one color per CellColor");
+
+	/**
+	 * @brief Associe au VAO lié l'attribut d'instance lu dans le tampon donné.
+	 */
+	void bindInstanceAttribute(GLuint vbo)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(CellInstance), nullptr);
+		glVertexAttribDivisor(0, 1);
+	}
+}
+
+/**
+ * @brief Construit une instance.
+ *
+ * @param x Abscisse du coin haut gauche, en cases.
+ * @param y Ordonnée du coin haut gauche, en cases.
+ * @param size Côté du carré, en cases.
+ * @param color Couleur de la case.
+ */
+CellInstance::CellInstance(float x, float y, float size, CellColor color)
+	: x(x), y(y), size(size), color(static_cast<float>(color))
+{}
+
+/**
+ * @brief Constructeur : aucune ressource OpenGL n'est créée avant init().
+ */
+CellRenderer::CellRenderer()
+	: _program(0), _staticVao(0), _staticVbo(0), _staticCount(0), _dynamicVao(0), _dynamicVbo(0),
+	  _dynamicCapacity(0), _drawCalls(0)
+{}
+
+/**
+ * @brief Destructeur. Les ressources doivent avoir été libérées par release()
+ * tant que le contexte OpenGL existait encore.
+ */
+CellRenderer::~CellRenderer() {}
+
+/**
+ * @brief Compile un shader.
+ *
+ * @param type GL_VERTEX_SHADER ou GL_FRAGMENT_SHADER.
+ * @param source Code GLSL.
+ * @return L'identifiant du shader.
+ * @throw std::runtime_error avec le journal du compilateur en cas d'échec.
+ */
+GLuint CellRenderer::compileShader(GLenum type, const char* source)
+{
+	GLuint shader = glCreateShader(type);
+	GLint ok = GL_FALSE;
+
+	glShaderSource(shader, 1, &source, nullptr);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+	if (ok != GL_TRUE)
+	{
+		char log[512] = {};
+		glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+		glDeleteShader(shader);
+		throw std::runtime_error(std::string("Failed to compile shader: ") + log);
+	}
+	return shader;
+}
+
+/**
+ * @brief Crée le shader et les tampons. Le contexte OpenGL 3.3 core doit être courant.
+ *
+ * @param width Largeur du plateau, en cases.
+ * @param height Hauteur du plateau, en cases.
+ * @throw std::runtime_error si le shader ne compile pas ou ne se lie pas.
+ */
+void CellRenderer::init(int width, int height)
+{
+	GLuint vertex = compileShader(GL_VERTEX_SHADER, VERTEX_SHADER);
+	GLuint fragment = compileShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+	GLint ok = GL_FALSE;
+
+	_program = glCreateProgram();
+	glAttachShader(_program, vertex);
+	glAttachShader(_program, fragment);
+	glLinkProgram(_program);
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+	glGetProgramiv(_program, GL_LINK_STATUS, &ok);
+	if (ok != GL_TRUE)
+	{
+		char log[512] = {};
+		glGetProgramInfoLog(_program, sizeof(log), nullptr, log);
+		release();
+		throw std::runtime_error(std::string("Failed to link shader: ") + log);
+	}
+
+	glUseProgram(_program);
+	glUniform2f(glGetUniformLocation(_program, "board"), static_cast<GLfloat>(width),
+		static_cast<GLfloat>(height));
+	glUniform3fv(glGetUniformLocation(_program, "palette"), static_cast<GLsizei>(CellColor::COUNT),
+		&PALETTE[0][0]);
+
+	glGenVertexArrays(1, &_staticVao);
+	glGenBuffers(1, &_staticVbo);
+	glBindVertexArray(_staticVao);
+	bindInstanceAttribute(_staticVbo);
+
+	glGenVertexArrays(1, &_dynamicVao);
+	glGenBuffers(1, &_dynamicVbo);
+	glBindVertexArray(_dynamicVao);
+	bindInstanceAttribute(_dynamicVbo);
+
+	glBindVertexArray(0);
+	_staticCount = 0;
+	_dynamicCapacity = 0;
+}
+
+/**
+ * @brief Libère le shader et les tampons (le contexte doit encore être courant).
+ */
+void CellRenderer::release()
+{
+	if (_dynamicVbo)
+		glDeleteBuffers(1, &_dynamicVbo);
+	if (_dynamicVao)
+		glDeleteVertexArrays(1, &_dynamicVao);
+	if (_staticVbo)
+		glDeleteBuffers(1, &_staticVbo);
+	if (_staticVao)
+		glDeleteVertexArrays(1, &_staticVao);
+	if (_program)
+		glDeleteProgram(_program);
+	_program = _staticVao = _staticVbo = _dynamicVao = _dynamicVbo = 0;
+	_staticCount = 0;
+	_dynamicCapacity = 0;
+}
+
+/**
+ * @brief Remplace les cases statiques (obstacles), dessinées sous les autres.
+ *
+ * @param cells Cases statiques.
+ */
+void CellRenderer::setStaticCells(const std::vector<CellInstance>& cells)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, _staticVbo);
+	glBufferData(GL_ARRAY_BUFFER, cells.size() * sizeof(CellInstance), cells.data(), GL_STATIC_DRAW);
+	_staticCount = static_cast<GLsizei>(cells.size());
+}
+
+/**
+ * @brief Efface l'écran puis dessine les cases statiques et les cases données.
+ *
+ * Le tampon dynamique est orphelin à chaque appel, et ne grossit que
+ * lorsque le nombre de cases dépasse sa capacité.
+ *
+ * @param cells Cases dynamiques du frame.
+ * @param withStatic Dessine aussi les cases statiques.
+ */
+void CellRenderer::draw(const std::vector<CellInstance>& cells, bool withStatic)
+{
+	_drawCalls = 0;
+	glClear(GL_COLOR_BUFFER_BIT);
+	glUseProgram(_program);
+	if (withStatic)
+		drawInstances(_staticVao, _staticCount);
+	if (cells.empty())
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, _dynamicVbo);
+	while (_dynamicCapacity < cells.size())
+		_dynamicCapacity = _dynamicCapacity ? _dynamicCapacity * 2 : 256;
+	glBufferData(GL_ARRAY_BUFFER, _dynamicCapacity * sizeof(CellInstance), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, cells.size() * sizeof(CellInstance), cells.data());
+	drawInstances(_dynamicVao, static_cast<GLsizei>(cells.size()));
+}
+
+/**
+ * @brief Dessine `count` carrés décrits par le VAO donné, en un appel.
+ */
+void CellRenderer::drawInstances(GLuint vao, GLsizei count)
+{
+	if (count == 0)
+		return;
+	glBindVertexArray(vao);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+	glBindVertexArray(0);
+	++_drawCalls;
+}
+
+/**
+ * @brief Nombre d'appels de dessin du dernier frame (au plus deux).
+ */
+int CellRenderer::getDrawCalls() const
+{
+	return _drawCalls;
+}
+
+/**
+ * @brief Cases dynamiques d'un frame : serpent (interpolé), nourriture et score.
+ *
+ * @param state Frame à afficher.
+ * @param alpha Fraction du tick écoulée (voir interpolateSegment()).
+ * @param cells Tableau rempli, vidé au préalable.
+ */
+void CellRenderer::frameCells(const Frame& state, float alpha, std::vector<CellInstance>& cells)
+{
+	const Snake& snake = state.getSnake();
+	int nbBlocks = state.getScore() / 10;
+
+	cells.clear();
+	cells.reserve(snake.getLength() + 1 + nbBlocks);
+
+	// Chaque segment est placé entre sa case précédente et l'actuelle
+	for (size_t i = 0; i < snake.getLength(); ++i)
+	{
+		PointF p = interpolateSegment(snake, i, alpha);
+		cells.emplace_back(p.x, p.y, 1.0f, i == 0 ? CellColor::HEAD : CellColor::BODY);
+	}
+
+	const Point& food = state.getFood();
+	cells.emplace_back(static_cast<float>(food.x), static_cast<float>(food.y), 1.0f, CellColor::FOOD);
+
+	// Score en blocs de 20 pixels espacés de 25, à 10 pixels du bord (une case fait 20 pixels)
+	for (int i = 0; i < nbBlocks; ++i)
+		cells.emplace_back(0.5f + i * 1.25f, 0.5f, 1.0f, CellColor::SCORE);
+}
+
+/**
+ * @brief Cases statiques d'un frame : les obstacles.
+ *
+ * @param state Frame à afficher.
+ * @param cells Tableau rempli, vidé au préalable.
+ */
+void CellRenderer::obstacleCells(const Frame& state, std::vector<CellInstance>& cells)
+{
+	const std::vector<Point>& obstacles = state.getObstacles();
+
+	cells.clear();
+	cells.reserve(obstacles.size());
+	for (const Point& p : obstacles)
+		cells.emplace_back(static_cast<float>(p.x), static_cast<float>(p.y), 1.0f, CellColor::OBSTACLE);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file CellRenderer.hpp
+ * @brief Déclaration de la classe CellRenderer, rendu instancié des cases du plateau.
+ *
+ * Le rendu n'utilise que le profil core d'OpenGL 3.3 : il fonctionne avec
+ * le rasteriseur logiciel de Mesa (llvmpipe), donc sans carte graphique.
+ */
+
+#pragma once
+
+#ifdef __APPLE__
+# include <OpenGL/gl3.h>
+#else
+# ifndef GL_GLEXT_PROTOTYPES
+#  define GL_GLEXT_PROTOTYPES
+# endif
+# include <GL/gl.h>
+# include <GL/glext.h>
+#endif
+#include <cstddef>
+#include <vector>
+#include "../core/Frame.hpp"
+
+/**
+ * @brief Couleurs disponibles pour une case (indices de la palette du shader).
+ */
+enum class CellColor
+{
+	HEAD,
+	BODY,
+	FOOD,
+	SCORE,
+	OBSTACLE,
+	HELP,
+	COUNT,
+};
+
+/**
+ * @brief Données d'une instance : un carré coloré, en coordonnées de cases.
+ */
+struct CellInstance
+{
+	float	x;		///< Abscisse du coin haut gauche (en cases, éventuellement fractionnaire).
+	float	y;		///< Ordonnée du coin haut gauche.
+	float	size;	///< Côté du carré, en cases.
+	float	color;	///< Indice dans la palette (voir CellColor).
+
+	CellInstance(float x, float y, float size, CellColor color);
+};
+
+/**
+ * @class CellRenderer
+ * @brief Dessine toutes les cases d'un frame en au plus deux appels instanciés.
+ *
+ * Les cases statiques (obstacles) sont envoyées une fois par partie dans
+ * leur propre tampon. Les cases dynamiques (serpent, nourriture, score) sont
+ * envoyées à chaque frame dans un tampon « orphelin » : glBufferData() avec
+ * un pointeur nul laisse le pilote allouer une nouvelle zone plutôt que
+ * d'attendre que le GPU ait fini de lire la précédente.
+ *
+ * Un petit shader construit chaque carré à partir de gl_VertexID et des
+ * données de l'instance : aucun tampon de sommets n'est nécessaire.
+ */
+class CellRenderer
+{
+	public:
+		CellRenderer();
+		CellRenderer(const CellRenderer&) = delete;
+		CellRenderer& operator=(const CellRenderer&) = delete;
+		~CellRenderer();
+
+		void	init(int width, int height);
+		void	release();
+		void	setStaticCells(const std::vector<CellInstance>& cells);
+		void	draw(const std::vector<CellInstance>& cells, bool withStatic);
+		int		getDrawCalls() const;
+
+		static void	frameCells(const Frame& state, float alpha, std::vector<CellInstance>& cells);
+		static void	obstacleCells(const Frame& state, std::vector<CellInstance>& cells);
+
+	private:
+		static GLuint	compileShader(GLenum type, const char* source);
+		void			drawInstances(GLuint vao, GLsizei count);
+
+		GLuint		_program;		///< Programme du shader.
+		GLuint		_staticVao;		///< Attributs des cases statiques.
+		GLuint		_staticVbo;		///< Instances des cases statiques.
+		GLsizei		_staticCount;	///< Nombre de cases statiques.
+		GLuint		_dynamicVao;	///< Attributs des cases dynamiques.
+		GLuint		_dynamicVbo;	///< Instances des cases dynamiques, réallouées à chaque frame.
+		size_t		_dynamicCapacity;	///< Capacité du tampon dynamique, en instances.
+		int			_drawCalls;		///< Appels de dessin du dernier frame.
+};
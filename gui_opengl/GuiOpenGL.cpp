@@ -8,18 +8,23 @@
  */
 
 #include "GuiOpenGL.hpp"
+#include "../includes/ScopedTimer.hpp"
 
 
 GuiOpenGL::GuiOpenGL()
-	: _window(nullptr), _screenWidth(0), _screenHeight(0)
+	: _window(nullptr), _screenWidth(0), _screenHeight(0), _alpha(1.0f), _staticSeed(0),
+	  _staticCount(0), _staticLoaded(false), _stats(nullptr)
 {}
 
 /**
  * @brief Initialise la fenêtre et le contexte OpenGL avec GLFW.
  * 
  * Cette fonction configure la largeur/hauteur de l’affichage,
- * initialise GLFW, crée une fenêtre avec contexte OpenGL,
- * et définit les paramètres OpenGL de base (viewport, couleur de fond).
+ * initialise GLFW, crée une fenêtre avec un contexte OpenGL 3.3 core,
+ * et prépare le rendu instancié (shader, tampons, couleur de fond).
+ *
+ * Aucun appel au pipeline fixe n'est utilisé : le rendu fonctionne aussi
+ * avec le rasteriseur logiciel de Mesa (LIBGL_ALWAYS_SOFTWARE=1).
  *
  * @param width  Largeur en cases du plateau de jeu.
  * @param height Hauteur en cases du plateau de jeu.
@@ -35,10 +40,11 @@ void GuiOpenGL::init(int width, int height)
 		throw std::runtime_error("GLFW initialization failed");
 	}
 
-	// Paramètres OpenGL (version 3.3)
+	// Paramètres OpenGL (version 3.3, profil core)
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_COMPAT_PROFILE);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE); // requis sous macOS
 
 	_window = glfwCreateWindow(width * 20, height * 20, "Nibbler - OpenGL", NULL, NULL);
 	if (!_window)
@@ -51,164 +57,139 @@ void GuiOpenGL::init(int width, int height)
 	// Rendre le contexte courant
 	glfwMakeContextCurrent(_window);
 
+	// Chaque appui est reçu par callback : aucun n'est perdu entre deux images
+	glfwSetWindowUserPointer(_window, this);
+	glfwSetKeyCallback(_window, &GuiOpenGL::onKey);
+
+	// Synchronisation verticale : swapBuffers() cadence les images sur l'écran
 	glfwSwapInterval(1); 
 
-	// Définir la zone de rendu (viewport)
-	glViewport(0, 0, width * 20, height * 20);
+	// Zone de rendu : le framebuffer peut être plus grand que la fenêtre (écrans haute densité)
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(_window, &framebufferWidth, &framebufferHeight);
+	glViewport(0, 0, framebufferWidth, framebufferHeight);
 
 	// Couleur de fond par défaut (noir)
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
-	glOrtho(0, width * 20, height * 20, 0, -1, 1); // coord écran 2D classique (origine en haut à gauche)
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+	try
+	{
+		_cells.init(width, height);
+	}
+	catch (const std::exception&)
+	{
+		glfwDestroyWindow(_window);
+		_window = nullptr;
+		glfwTerminate();
+		throw;
+	}
+	_staticLoaded = false;
 }
 
 /**
  * @brief Affiche un menu d'aide simplifié avec des blocs directionnels en OpenGL.
- * Les touches sont représentées par des rectangles : ↑ ↓ ← →, H (aide), Q (quitter).
+ * Les touches sont représentées par des carrés : ↑ ← → ↓.
  */
 void GuiOpenGL::drawHelpMenu()
 {
-	glClear(GL_COLOR_BUFFER_BIT);
-
-	// ↑
-	glBegin(GL_QUADS);
-	glVertex2f(180, 60);
-	glVertex2f(220, 60);
-	glVertex2f(220, 100);
-	glVertex2f(180, 100);
-	glEnd();
-
-	// ←
-	glBegin(GL_QUADS);
-	glVertex2f(120, 120);
-	glVertex2f(160, 120);
-	glVertex2f(160, 160);
-	glVertex2f(120, 160);
-	glEnd();
-
-	// →
-	glBegin(GL_QUADS);
-	glVertex2f(240, 120);
-	glVertex2f(280, 120);
-	glVertex2f(280, 160);
-	glVertex2f(240, 160);
-	glEnd();
-
-	// ↓
-	glBegin(GL_QUADS);
-	glVertex2f(180, 180);
-	glVertex2f(220, 180);
-	glVertex2f(220, 220);
-	glVertex2f(180, 220);
-	glEnd();
+	_instances.clear();
+	_instances.emplace_back(9.0f, 3.0f, 2.0f, CellColor::HELP);	// ↑
+	_instances.emplace_back(6.0f, 6.0f, 2.0f, CellColor::HELP);	// ←
+	_instances.emplace_back(12.0f, 6.0f, 2.0f, CellColor::HELP);	// →
+	_instances.emplace_back(9.0f, 9.0f, 2.0f, CellColor::HELP);	// ↓
+	_cells.draw(_instances, false);
 
 	glfwSwapBuffers(_window);
 }
 
+/**
+ * @brief Envoie les obstacles au CellRenderer lorsque la partie ou leur nombre change.
+ *
+ * @param state Frame à afficher.
+ */
+void GuiOpenGL::loadObstacles(const Frame& state)
+{
+	size_t count = state.getObstacles().size();
+
+	if (_staticLoaded && _staticSeed == state.getSeed() && _staticCount == count)
+		return;
+
+	std::vector<CellInstance> cells;
+	CellRenderer::obstacleCells(state, cells);
+	_cells.setStaticCells(cells);
+	_staticSeed = state.getSeed();
+	_staticCount = count;
+	_staticLoaded = true;
+}
+
 /**
  * @brief Rendu graphique du jeu en OpenGL.
  *
  * Cette méthode dessine le serpent, la nourriture, le score et les obstacles
  * sur l'écran en utilisant OpenGL. Elle gère également l'affichage du menu d'aide.
  *
+ * Les obstacles restent dans un tampon statique ; le serpent (interpolé),
+ * la nourriture et les blocs du score sont rassemblés dans un seul tableau
+ * d'instances, dessiné en un appel.
+ *
  * @param state L'état actuel du jeu (serpent, nourriture, score, obstacles).
  */
-void GuiOpenGL::render(const GameState& state)
+void GuiOpenGL::render(const Frame& state)
 {
-	// Efface l'écran avec la couleur de fond (noir)
-	glClear(GL_COLOR_BUFFER_BIT);
-
 	if (state.isHelpMenuActive())
 	{
 		drawHelpMenu();
 		return;
 	}
-	// Dessine le serpent (vert)
-	glColor3f(0.0f, 0.8f, 1.0f); // Bleu cyan
-	for (size_t i = 0; i < state.getSnake().getBody().size(); ++i)
-	{
-		if (i == 0)
-			glColor3f(0.0f, 1.0f, 0.0f); // Vert pour la tête
-		else
-			glColor3f(0.0f, 0.8f, 1.0f); // Bleu cyan pour le corps
-
-		const Point& p = state.getSnake().getBody()[i];
-		float x = p.x * 20.0f;
-		float y = p.y * 20.0f;
-		
-		// Dessine une forme a 4 côtés (juste les points)
-		glBegin(GL_QUADS);
-			glVertex2f(x, y);
-			glVertex2f(x + 20.0f, y);
-			glVertex2f(x + 20.0f, y + 20.0f);
-			glVertex2f(x, y + 20.0f);
-		glEnd();
-	}
-
-	// Dessine la nourriture (rouge)
-	Point food = state.getFood();
-	float fx = food.x * 20.0f;
-	float fy = food.y * 20.0f;
-
-	glColor3f(1.0f, 0.6f, 0.0f); // Orange clair
-	glBegin(GL_QUADS);
-		glVertex2f(fx, fy);
-		glVertex2f(fx + 20.0f, fy);
-		glVertex2f(fx + 20.0f, fy + 20.0f);
-		glVertex2f(fx, fy + 20.0f);
-	glEnd();
-
-	// Dessine le score en blocs blancs
-	int score = state.getScore();
-	int nbBlocks = score / 10;
+	ScopedTimer draw(_stats, StatsPhase::DRAW);
+	loadObstacles(state);
+	CellRenderer::frameCells(state, _alpha, _instances);
+	_cells.draw(_instances, true);
+	draw.stop();
 
-	glColor3f(1.0f, 1.0f, 1.0f); // blanc
+	// Affiche la frame à l'écran
+	ScopedTimer present(_stats, StatsPhase::PRESENT);
+	glfwSwapBuffers(_window);
+}
 
-	for (int i = 0; i < nbBlocks; ++i)
-	{
-		float x = 10.0f + i * 25.0f;
-		float y = 10.0f;
-		glBegin(GL_QUADS);
-			glVertex2f(x, y);
-			glVertex2f(x + 20.0f, y);
-			glVertex2f(x + 20.0f, y + 20.0f);
-			glVertex2f(x, y + 20.0f);
-		glEnd();
-	}
-	// Dessine les obstacles (gris foncé)
-	glColor3f(0.4f, 0.4f, 0.4f);
 
-	for (const Point& p : state.getObstacles())
-	{
-		float x = p.x * 20.0f;
-		float y = p.y * 20.0f;
-
-		glBegin(GL_QUADS);
-			glVertex2f(x, y);
-			glVertex2f(x + 20.0f, y);
-			glVertex2f(x + 20.0f, y + 20.0f);
-			glVertex2f(x, y + 20.0f);
-		glEnd();
-	}
+/**
+ * @brief Mesure la construction (DRAW) et l'affichage (PRESENT) de chaque frame.
+ *
+ * @param stats Destination des mesures, ou nullptr.
+ */
+void GuiOpenGL::setStats(FrameStats* stats)
+{
+	_stats = stats;
+}
 
-	// Affiche la frame à l'écran
-	glfwSwapBuffers(_window);
+/**
+ * @brief Mémorise la fraction du tick écoulée pour le prochain rendu.
+ *
+ * @param alpha Entre 0 (tick précédent) et 1 (tick courant).
+ */
+void GuiOpenGL::setInterpolation(float alpha)
+{
+	_alpha = alpha;
 }
 
+/**
+ * @brief Le rendu OpenGL interpole le serpent, au rythme de la synchronisation verticale.
+ */
+bool GuiOpenGL::isSmooth() const
+{
+	return true;
+}
 
 /**
  * @brief Gère les entrées clavier via GLFW (OpenGL).
  * 
- * Utilise glfwPollEvents() pour détecter :
+ * Utilise glfwPollEvents() pour recevoir les appuis (par callback) :
  * - les flèches directionnelles
  * - les touches '1', '2', '3' pour changer de GUI
  * - les touches 'q' ou Échap pour quitter
  * 
- * @return Input La direction ou l'action détectée par l'utilisateur.
+ * @return Input La plus ancienne direction ou action non encore lue.
  */
 Input GuiOpenGL::getInput()
 {
@@ -216,44 +197,87 @@ Input GuiOpenGL::getInput()
 
 	if (glfwWindowShouldClose(_window))
 		return Input::EXIT;
+	if (_pending.empty())
+		return Input::NONE;
 
-	if (glfwGetKey(_window, GLFW_KEY_UP) == GLFW_PRESS)
-		return Input::UP;
-	if (glfwGetKey(_window, GLFW_KEY_DOWN) == GLFW_PRESS)
-		return Input::DOWN;
-	if (glfwGetKey(_window, GLFW_KEY_LEFT) == GLFW_PRESS)
-		return Input::LEFT;
-	if (glfwGetKey(_window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-		return Input::RIGHT;
-
-	if (glfwGetKey(_window, GLFW_KEY_1) == GLFW_PRESS)
-		return Input::SWITCH_TO_1;
-	if (glfwGetKey(_window, GLFW_KEY_2) == GLFW_PRESS)
-		return Input::SWITCH_TO_2;
-	if (glfwGetKey(_window, GLFW_KEY_3) == GLFW_PRESS)
-		return Input::SWITCH_TO_3;
-	if (glfwGetKey(_window, GLFW_KEY_ESCAPE) == GLFW_PRESS ||
-		glfwGetKey(_window, GLFW_KEY_Q) == GLFW_PRESS)
-		return Input::EXIT;
+	Input input = _pending.front().input;
+	_pending.pop_front();
+	return input;
+}
+
+/**
+ * @brief Transmet à la file d'entrées tous les appuis reçus depuis l'image précédente.
+ *
+ * Les événements gardent l'instant où le callback les a reçus.
+ *
+ * @param queue File d'entrées de la boucle de jeu.
+ */
+void GuiOpenGL::pollInputs(InputQueue& queue)
+{
+	glfwPollEvents();
 
-	if (glfwGetKey(_window, GLFW_KEY_H) == GLFW_PRESS)
-		return Input::HELP;
-	return Input::NONE;
+	for (const InputEvent& event : _pending)
+		queue.push(event);
+	_pending.clear();
+	if (glfwWindowShouldClose(_window))
+		queue.push(Input::EXIT);
+}
+
+/**
+ * @brief Callback clavier GLFW : mémorise chaque appui avec son instant de réception.
+ */
+void GuiOpenGL::onKey(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+	(void)scancode;
+	(void)mods;
+	if (action != GLFW_PRESS)
+		return;
+
+	GuiOpenGL* gui = static_cast<GuiOpenGL*>(glfwGetWindowUserPointer(window));
+	Input input = translateKey(key);
+	if (gui && input != Input::NONE)
+		gui->_pending.push_back(InputEvent{ input, InputQueue::now() });
+}
+
+/**
+ * @brief Associe une touche GLFW à une entrée du jeu.
+ *
+ * @param key Code de la touche.
+ * @return L'entrée correspondante, ou Input::NONE.
+ */
+Input GuiOpenGL::translateKey(int key)
+{
+	switch (key)
+	{
+		case GLFW_KEY_UP:		return Input::UP;
+		case GLFW_KEY_DOWN:		return Input::DOWN;
+		case GLFW_KEY_LEFT:		return Input::LEFT;
+		case GLFW_KEY_RIGHT:	return Input::RIGHT;
+		case GLFW_KEY_1:		return Input::SWITCH_TO_1;
+		case GLFW_KEY_2:		return Input::SWITCH_TO_2;
+		case GLFW_KEY_3:		return Input::SWITCH_TO_3;
+		case GLFW_KEY_ESCAPE:
+		case GLFW_KEY_Q:		return Input::EXIT;
+		case GLFW_KEY_H:		return Input::HELP;
+		default:				return Input::NONE;
+	}
 }
 
 /**
- * @brief Libère les ressources GLFW et réinitialise le terminal.
+ * @brief Libère les ressources GLFW.
  * 
- * Détruit la fenêtre GLFW si elle existe, termine GLFW et
- * restaure l'état du terminal avec la commande `stty sane`.
+ * Détruit la fenêtre GLFW si elle existe et termine GLFW. Le terminal
+ * est restauré par le GuiManager qui a ouvert la GUI.
  */
 void GuiOpenGL::cleanup()
 {
 	if (_window)
+	{
+		_cells.release();
 		glfwDestroyWindow(_window);
+	}
 	_window = nullptr;
 	glfwTerminate();
-	system("stty sane");
 }
 
 /**
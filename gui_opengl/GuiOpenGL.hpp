@@ -8,11 +8,12 @@
 
 #pragma once
 #include "../includes/IGui.hpp"
-#include <GL/gl.h>
-#include <GL/glu.h>
+#include "CellRenderer.hpp"
 #include <GLFW/glfw3.h>
+#include <deque>
+#include <vector>
 
-#include "../core/GameState.hpp"
+#include "../core/Frame.hpp"
 
 
 /**
@@ -24,6 +25,10 @@
  * le rendu graphique du jeu, la gestion des entrées clavier, l'affichage de messages
  * de fin (victoire ou défaite) et le nettoyage des ressources.
  * 
+ * Le rendu passe par un contexte OpenGL 3.3 core et un CellRenderer : chaque
+ * frame est dessiné en au plus deux appels instanciés, quelle que soit la
+ * longueur du serpent ou le nombre d'obstacles.
+ *
  * Elle est compilée en bibliothèque dynamique (.so) et chargée à l'exécution.
  */
 class GuiOpenGL : public IGui
@@ -35,15 +40,32 @@ class GuiOpenGL : public IGui
 		~GuiOpenGL() override = default;
 
 		void	init(int width, int height) override;
-		void	render(const GameState& state) override;
+		void	render(const Frame& state) override;
 		Input	getInput() override;
 		void	showVictory() override;
 		void	showGameOver() override;
 		void	cleanup() override;
+		void	setInterpolation(float alpha) override;
+		bool	isSmooth() const override;
+		void	pollInputs(InputQueue& queue) override;
+		void	setStats(FrameStats* stats) override;
 
 	private:
+		static void		onKey(GLFWwindow* window, int key, int scancode, int action, int mods);
+		static Input	translateKey(int key);
+
+		std::deque<InputEvent>	_pending;	///< Touches reçues par le callback, pas encore transmises.
 		GLFWwindow* _window = nullptr;	///< Pointeur vers la fenêtre GLFW.
 		int	_screenWidth;				///< Largeur de l'écran en pixels.
 		int	_screenHeight;				///< Hauteur de l'écran en pixels.
+		float	_alpha;					///< Fraction du tick écoulée (interpolation du serpent).
+		CellRenderer	_cells;			///< Rendu instancié des cases.
+		std::vector<CellInstance>	_instances;	///< Cases dynamiques du frame en cours.
+		uint64_t	_staticSeed;		///< Graine de la partie dont les obstacles sont chargés.
+		size_t	_staticCount;			///< Nombre d'obstacles chargés.
+		bool	_staticLoaded;			///< Des obstacles ont été chargés.
+		FrameStats*	_stats;				///< Mesures du rendu (nul : aucune).
+
 		void	drawHelpMenu();
+		void	loadObstacles(const Frame& state);
 };
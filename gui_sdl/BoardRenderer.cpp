@@ -0,0 +1,166 @@
+/**
+ * @file BoardRenderer.cpp
+ * @brief Implémentation de la classe BoardRenderer.
+ */
+
+#include "BoardRenderer.hpp"
+#include "../includes/Interpolation.hpp"
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Constructeur : rien n'est créé avant init().
+ */
+BoardRenderer::BoardRenderer()
+	: _renderer(nullptr), _static(nullptr), _width(0), _height(0), _staticValid(false), _seed(0),
+	  _obstacleCount(0)
+{}
+
+/**
+ * @brief Destructeur : libère la texture si release() n'a pas été appelé.
+ */
+BoardRenderer::~BoardRenderer()
+{
+	release();
+}
+
+/**
+ * @brief Prépare le rendu pour un plateau donné.
+ *
+ * @param renderer Renderer de la fenêtre, créé de préférence avec SDL_RENDERER_TARGETTEXTURE.
+ * @param width Largeur du plateau, en cases.
+ * @param height Hauteur du plateau, en cases.
+ * @throw std::runtime_error si la texture cible ne peut pas être créée alors
+ * que le renderer les gère.
+ */
+void BoardRenderer::init(SDL_Renderer* renderer, int width, int height)
+{
+	release();
+	_renderer = renderer;
+	_width = width;
+	_height = height;
+	if (SDL_RenderTargetSupported(renderer))
+	{
+		_static = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+			width * CELL_SIZE, height * CELL_SIZE);
+		if (!_static)
+			throw std::runtime_error(std::string("SDL_CreateTexture failed: ") + SDL_GetError());
+		SDL_SetTextureBlendMode(_static, SDL_BLENDMODE_NONE);
+	}
+	_staticValid = false;
+}
+
+/**
+ * @brief Libère la texture (le renderer doit encore exister).
+ */
+void BoardRenderer::release()
+{
+	if (_static)
+		SDL_DestroyTexture(_static);
+	_static = nullptr;
+	_staticValid = false;
+}
+
+/**
+ * @brief Force le prochain draw() à redessiner le fond et les obstacles.
+ *
+ * À appeler lorsque SDL signale la perte du contenu des textures cibles
+ * (SDL_RENDER_TARGETS_RESET).
+ */
+void BoardRenderer::invalidate()
+{
+	_staticValid = false;
+}
+
+/**
+ * @brief Dessine le fond noir et les obstacles dans la texture cible.
+ *
+ * Sans texture cible, seuls les rectangles des obstacles sont préparés.
+ *
+ * @param state Frame dont les obstacles sont dessinés.
+ */
+void BoardRenderer::drawStaticLayer(const Frame& state)
+{
+	_obstacles.clear();
+	for (const Point& p : state.getObstacles())
+		_obstacles.push_back({ p.x * CELL_SIZE, p.y * CELL_SIZE, CELL_SIZE, CELL_SIZE });
+	_seed = state.getSeed();
+	_obstacleCount = state.getObstacles().size();
+	_staticValid = true;
+	if (!_static)
+		return;
+
+	SDL_SetRenderTarget(_renderer, _static);
+	SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 255); // fond noir
+	SDL_RenderClear(_renderer);
+	fillRects(_obstacles, 100, 100, 100);
+	SDL_SetRenderTarget(_renderer, nullptr);
+}
+
+/**
+ * @brief Remplit des rectangles d'une même couleur, en un seul appel.
+ */
+void BoardRenderer::fillRects(const std::vector<SDL_Rect>& rects, Uint8 r, Uint8 g, Uint8 b)
+{
+	if (rects.empty())
+		return;
+	SDL_SetRenderDrawColor(_renderer, r, g, b, 255);
+	SDL_RenderFillRects(_renderer, rects.data(), static_cast<int>(rects.size()));
+}
+
+/**
+ * @brief Dessine un frame complet (sans l'afficher).
+ *
+ * - Fond et obstacles (gris foncé) : une copie de la texture pré-rendue
+ * - Corps du serpent (vert foncé), tête (bleu foncé), nourriture (rouge)
+ *   et score (blocs blancs) : un SDL_RenderFillRects() par couleur
+ *
+ * @param state Frame à dessiner.
+ * @param alpha Fraction du tick écoulée (voir interpolateSegment()).
+ */
+void BoardRenderer::draw(const Frame& state, float alpha)
+{
+	if (!_staticValid || state.getSeed() != _seed || state.getObstacles().size() != _obstacleCount)
+		drawStaticLayer(state);
+
+	if (_static)
+		SDL_RenderCopy(_renderer, _static, nullptr, nullptr);
+	else
+	{
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 255); // fond noir
+		SDL_RenderClear(_renderer);
+		fillRects(_obstacles, 100, 100, 100);
+	}
+
+	// Chaque segment est placé entre sa case précédente et l'actuelle
+	const Snake& snake = state.getSnake();
+	_body.clear();
+	for (size_t i = 1; i < snake.getLength(); ++i)
+	{
+		PointF p = interpolateSegment(snake, i, alpha);
+		_body.push_back({ static_cast<int>(p.x * CELL_SIZE + 0.5f), static_cast<int>(p.y * CELL_SIZE + 0.5f),
+			CELL_SIZE, CELL_SIZE });
+	}
+	fillRects(_body, 0, 200, 0);
+
+	if (snake.getLength() > 0)
+	{
+		PointF p = interpolateSegment(snake, 0, alpha);
+		SDL_Rect head = { static_cast<int>(p.x * CELL_SIZE + 0.5f), static_cast<int>(p.y * CELL_SIZE + 0.5f),
+			CELL_SIZE, CELL_SIZE };
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 200, 255);
+		SDL_RenderFillRect(_renderer, &head);
+	}
+
+	const Point& food = state.getFood();
+	SDL_Rect foodRect = { food.x * CELL_SIZE, food.y * CELL_SIZE, CELL_SIZE, CELL_SIZE };
+	SDL_SetRenderDrawColor(_renderer, 255, 0, 0, 255);
+	SDL_RenderFillRect(_renderer, &foodRect);
+
+	// Score : 1 bloc = 10 points
+	int nbBlocks = state.getScore() / 10;
+	_score.clear();
+	for (int i = 0; i < nbBlocks; ++i)
+		_score.push_back({ 10 + i * 25, 10, 20, 20 });
+	fillRects(_score, 255, 255, 255);
+}
@@ -0,0 +1,56 @@
+/**
+ * @file BoardRenderer.hpp
+ * @brief Déclaration de la classe BoardRenderer, rendu SDL groupé du plateau.
+ */
+
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+#include "../core/Frame.hpp"
+
+/**
+ * @class BoardRenderer
+ * @brief Dessine un Frame avec un SDL_Renderer en quelques appels.
+ *
+ * Le fond et les obstacles, qui ne bougent pas pendant une partie, sont
+ * dessinés une seule fois dans une texture cible, copiée d'un bloc à chaque
+ * frame. Elle n'est redessinée que lorsque la partie ou le nombre
+ * d'obstacles change, ou après invalidate() (perte des textures cibles).
+ * Les cases dynamiques sont regroupées par couleur et envoyées avec un
+ * SDL_RenderFillRects() par couleur.
+ *
+ * Si le renderer ne gère pas les textures cibles, les obstacles sont
+ * dessinés à chaque frame, eux aussi en un seul appel.
+ */
+class BoardRenderer
+{
+	public:
+		static const int CELL_SIZE = 20;	///< Côté d'une case, en pixels.
+
+		BoardRenderer();
+		BoardRenderer(const BoardRenderer&) = delete;
+		BoardRenderer& operator=(const BoardRenderer&) = delete;
+		~BoardRenderer();
+
+		void	init(SDL_Renderer* renderer, int width, int height);
+		void	release();
+		void	invalidate();
+		void	draw(const Frame& state, float alpha);
+
+	private:
+		void	drawStaticLayer(const Frame& state);
+		void	fillRects(const std::vector<SDL_Rect>& rects, Uint8 r, Uint8 g, Uint8 b);
+
+		SDL_Renderer*	_renderer;	///< Renderer de la fenêtre (non possédé).
+		SDL_Texture*	_static;	///< Fond et obstacles pré-rendus (nullptr sans textures cibles).
+		int			_width;			///< Largeur du plateau, en cases.
+		int			_height;		///< Hauteur du plateau, en cases.
+		bool		_staticValid;	///< La texture correspond à _seed et _obstacleCount.
+		uint64_t	_seed;			///< Graine de la partie pré-rendue.
+		size_t		_obstacleCount;	///< Nombre d'obstacles pré-rendus.
+		std::vector<SDL_Rect>	_obstacles;	///< Rectangles des obstacles.
+		std::vector<SDL_Rect>	_body;		///< Rectangles du corps du serpent.
+		std::vector<SDL_Rect>	_score;		///< Blocs du score.
+};
@@ -8,10 +8,12 @@
  */
 
 #include "GuiSDL.hpp"
+#include "../includes/ScopedTimer.hpp"
 
 
 GuiSDL::GuiSDL()
-	: _screenWidth(0), _screenHeight(0), _window(nullptr), _renderer(nullptr)
+	: _screenWidth(0), _screenHeight(0), _alpha(1.0f), _window(nullptr), _renderer(nullptr),
+	  _stats(nullptr)
 {}
 
 /**
@@ -82,7 +84,7 @@ void    GuiSDL::init(int width, int height)
 		throw std::runtime_error("SDL_CreateWindow failed");
 	}
 
-    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED);
+    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
 	if (!_renderer)
 	{
 		std::cerr << "❌ SDL_CreateRenderer failed: " << SDL_GetError() << std::endl;
@@ -90,6 +92,21 @@ void    GuiSDL::init(int width, int height)
 		SDL_Quit();
 		throw std::runtime_error("SDL_CreateRenderer failed");
 	}
+
+	try
+	{
+		_board.init(_renderer, width, height);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "❌ " << e.what() << std::endl;
+		SDL_DestroyRenderer(_renderer);
+		SDL_DestroyWindow(_window);
+		_renderer = nullptr;
+		_window = nullptr;
+		SDL_Quit();
+		throw;
+	}
 }
 
 
@@ -110,21 +127,13 @@ void GuiSDL::drawHelpMenu()
 	// Affiche des blocs symboliques pour les directions
 	SDL_SetRenderDrawColor(_renderer, 255, 255, 255, 255); // blanc
 
-	// "↑" en haut
-	SDL_Rect up = { 180, 60, 40, 40 };
-	SDL_RenderFillRect(_renderer, &up);
-
-	// "←" à gauche
-	SDL_Rect left = { 120, 120, 40, 40 };
-	SDL_RenderFillRect(_renderer, &left);
-
-	// "→" à droite
-	SDL_Rect right = { 240, 120, 40, 40 };
-	SDL_RenderFillRect(_renderer, &right);
-
-	// "↓" en bas
-	SDL_Rect down = { 180, 180, 40, 40 };
-	SDL_RenderFillRect(_renderer, &down);
+	const SDL_Rect keys[] = {
+		{ 180, 60, 40, 40 },	// "↑" en haut
+		{ 120, 120, 40, 40 },	// "←" à gauche
+		{ 240, 120, 40, 40 },	// "→" à droite
+		{ 180, 180, 40, 40 },	// "↓" en bas
+	};
+	SDL_RenderFillRects(_renderer, keys, 4);
 
 	SDL_RenderPresent(_renderer);
 }
@@ -134,17 +143,16 @@ void GuiSDL::drawHelpMenu()
  * 
  * Si le menu d'aide est activé (touche 'h'), cette fonction appelle
  * drawHelpMenu() pour afficher un écran dédié avec les touches directionnelles.
- * Sinon, elle affiche le jeu normalement :
- * - Serpent (vert)
- * - Nourriture (rouge)
- * - Score (blocs blancs)
- * - Obstacles (gris foncé)
+ * Sinon, elle affiche le jeu normalement avec le BoardRenderer :
+ * - Fond et obstacles (gris foncé), pré-rendus dans une texture
+ * - Serpent (vert, tête bleue), nourriture (rouge), score (blocs blancs),
+ *   un appel par couleur
  * 
  * Le rendu final est affiché avec SDL_RenderPresent().
  * 
  * @param state L'état actuel du jeu à afficher.
  */
-void	GuiSDL::render(const GameState& state)
+void	GuiSDL::render(const Frame& state)
 {
 	if (state.isHelpMenuActive())
 	{
@@ -153,47 +161,44 @@ void	GuiSDL::render(const GameState& state)
 	}
 
 	// 🎮 Affichage normal du jeu (quand le menu n'est pas actif)
-	SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 255); // fond noir
-	SDL_RenderClear(_renderer);
+	ScopedTimer draw(_stats, StatsPhase::DRAW);
+	_board.draw(state, _alpha);
+	draw.stop();
 
-	// Dessine le serpent
-	for (size_t i = 0; i < state.getSnake().getBody().size(); ++i)
-	{
-		if (i == 0) // tête du serpent
-			SDL_SetRenderDrawColor(_renderer, 0, 0, 200, 255); // bleu foncé
-		else
-			SDL_SetRenderDrawColor(_renderer, 0, 200, 0, 255); // vert foncé
-		SDL_Rect rect = { state.getSnake().getBody()[i].x * 20,
-						  state.getSnake().getBody()[i].y * 20, 20, 20 };
-		SDL_RenderFillRect(_renderer, &rect);
-	}
-
-	// Dessine la nourriture
-	SDL_SetRenderDrawColor(_renderer, 255, 0, 0, 255); // rouge
-	Point food = state.getFood();
-	SDL_Rect foodRect = { food.x * 20, food.y * 20, 20, 20 };
-	SDL_RenderFillRect(_renderer, &foodRect);
+	// Affiche la frame finale
+	ScopedTimer present(_stats, StatsPhase::PRESENT);
+	SDL_RenderPresent(_renderer);
+}
 
-	// Affiche le score avec des blocs
-	int score = state.getScore();
-	int nbBlocks = score / 10; // 1 bloc = 10 points
-	SDL_SetRenderDrawColor(_renderer, 255, 255, 255, 255); // blanc
-	for (int i = 0; i < nbBlocks; ++i)
-	{
-		SDL_Rect block = { 10 + i * 25, 10, 20, 20 };
-		SDL_RenderFillRect(_renderer, &block);
-	}
+/**
+ * @brief Mesure la construction (DRAW) et l'affichage (PRESENT) de chaque frame.
+ *
+ * @param stats Destination des mesures, ou nullptr.
+ */
+void	GuiSDL::setStats(FrameStats* stats)
+{
+	_stats = stats;
+}
 
-	// Dessine les obstacles
-	SDL_SetRenderDrawColor(_renderer, 100, 100, 100, 255);
-	for (const Point& p : state.getObstacles())
-	{
-		SDL_Rect rect = { p.x * 20, p.y * 20, 20, 20 };
-		SDL_RenderFillRect(_renderer, &rect);
-	}
+/**
+ * @brief Mémorise la fraction du tick écoulée pour le prochain rendu.
+ *
+ * @param alpha Entre 0 (tick précédent) et 1 (tick courant).
+ */
+void	GuiSDL::setInterpolation(float alpha)
+{
+	_alpha = alpha;
+}
 
-	// Affiche la frame finale
-	SDL_RenderPresent(_renderer);
+/**
+ * @brief Le rendu SDL interpole le serpent : il veut des images entre les ticks.
+ *
+ * Le renderer n'attend pas la synchronisation verticale ; la cadence des
+ * images est limitée par la boucle principale (`--fps`, 0 pour aucune limite).
+ */
+bool	GuiSDL::isSmooth() const
+{
+	return true;
 }
 
 /**
@@ -214,52 +219,105 @@ Input	GuiSDL::getInput()
 	SDL_Event event;
 	while (SDL_PollEvent(&event))
 	{
+		handleRenderReset(event);
 		if (event.type == SDL_QUIT)
 			return Input::EXIT;
 
 		if (event.type == SDL_KEYDOWN)
 		{
-			switch (event.key.keysym.sym)
-			{
-				case SDLK_UP:
-					return Input::UP;
-				case SDLK_DOWN:
-					return Input::DOWN;
-				case SDLK_LEFT:
-					return Input::LEFT;
-				case SDLK_RIGHT:
-					return Input::RIGHT;
-				case SDLK_1: 
-					return Input::SWITCH_TO_1;
-				case SDLK_2: 
-					return Input::SWITCH_TO_2;
-				case SDLK_3: 
-					return Input::SWITCH_TO_3;
-				case SDLK_ESCAPE:
-				case SDLK_q:     
-					return Input::EXIT;
-				case SDLK_h: 
-					return Input::HELP; 
-			}
+			Input input = translateKey(event.key.keysym.sym);
+			if (input != Input::NONE)
+				return input;
 		}
 	}
 	return Input::NONE;
 }
 
 /**
- * @brief Libère les ressources SDL et réinitialise le terminal.
+ * @brief Vide la file d'événements SDL et dépose chaque touche dans la file d'entrées.
+ *
+ * Contrairement à getInput(), aucune touche n'est laissée en attente dans
+ * SDL : toutes celles reçues depuis l'image précédente sont transmises, dans
+ * l'ordre, chacune horodatée.
+ *
+ * @param queue File d'entrées de la boucle de jeu.
+ */
+void	GuiSDL::pollInputs(InputQueue& queue)
+{
+	SDL_Event event;
+	while (SDL_PollEvent(&event))
+	{
+		handleRenderReset(event);
+		if (event.type == SDL_QUIT)
+			queue.push(Input::EXIT);
+		else if (event.type == SDL_KEYDOWN && !event.key.repeat)
+		{
+			Input input = translateKey(event.key.keysym.sym);
+			if (input != Input::NONE)
+				queue.push(input);
+		}
+	}
+}
+
+/**
+ * @brief Redessine le fond pré-rendu lorsque SDL a perdu le contenu des textures cibles.
+ *
+ * @param event Événement SDL reçu.
+ */
+void	GuiSDL::handleRenderReset(const SDL_Event& event)
+{
+	if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+		_board.invalidate();
+}
+
+/**
+ * @brief Associe une touche SDL à une entrée du jeu.
+ *
+ * @param key Code de la touche.
+ * @return L'entrée correspondante, ou Input::NONE.
+ */
+Input	GuiSDL::translateKey(SDL_Keycode key)
+{
+	switch (key)
+	{
+		case SDLK_UP:
+			return Input::UP;
+		case SDLK_DOWN:
+			return Input::DOWN;
+		case SDLK_LEFT:
+			return Input::LEFT;
+		case SDLK_RIGHT:
+			return Input::RIGHT;
+		case SDLK_1: 
+			return Input::SWITCH_TO_1;
+		case SDLK_2: 
+			return Input::SWITCH_TO_2;
+		case SDLK_3: 
+			return Input::SWITCH_TO_3;
+		case SDLK_ESCAPE:
+		case SDLK_q:     
+			return Input::EXIT;
+		case SDLK_h: 
+			return Input::HELP; 
+		default:
+			return Input::NONE;
+	}
+}
+
+/**
+ * @brief Libère les ressources SDL.
  * 
- * Détruit le renderer et la fenêtre s'ils existent, quitte SDL
- * et restaure l'état du terminal avec la commande `stty sane`.
+ * Détruit le renderer et la fenêtre s'ils existent et quitte SDL. Le
+ * terminal est restauré par le GuiManager qui a ouvert la GUI.
  */
 void GuiSDL::cleanup() 
 {
+	_board.release();
 	if (_renderer) 
 		SDL_DestroyRenderer(_renderer);
 	if (_window) 
 		SDL_DestroyWindow(_window);
 	SDL_Quit();
-	system("stty sane");
 }
 
 /**
@@ -8,9 +8,10 @@
 
 #pragma once
 #include "../includes/IGui.hpp"
+#include "BoardRenderer.hpp"
 #include <SDL2/SDL.h>
 
-#include "../core/GameState.hpp"
+#include "../core/Frame.hpp"
 
 /**
  * @class GuiSDL
@@ -19,6 +20,7 @@
  * Cette classe hérite de l'interface IGui et fournit une version SDL de l'affichage
  * du jeu Snake. Elle gère l'initialisation de la fenêtre, le rendu du jeu, les
  * entrées clavier, l'affichage de messages de fin (victoire ou défaite) et le nettoyage.
+ * Le plateau est dessiné par un BoardRenderer (fond pré-rendu, cases groupées par couleur).
  * 
  * Elle est compilée en bibliothèque dynamique (.so) et chargée à l'exécution.
  */
@@ -32,18 +34,27 @@ class GuiSDL : public IGui
 
 		// ===== Méthodes existantes =====
 		void	init(int width, int height) override;
-		void	render(const GameState& state) override;
+		void	render(const Frame& state) override;
 		Input	getInput() override;
 		void	showVictory() override;
 		void	showGameOver() override;
 		void	cleanup() override;
+		void	setInterpolation(float alpha) override;
+		bool	isSmooth() const override;
+		void	pollInputs(InputQueue& queue) override;
+		void	setStats(FrameStats* stats) override;
 
 	private:
+		static Input	translateKey(SDL_Keycode key);
+		void	handleRenderReset(const SDL_Event& event);
 		void checkTerminalSize(int requiredWidth, int requiredHeight);
 		void drawHelpMenu();
 
 		int	_screenWidth;					///< Largeur de l'écran en pixels.
 		int	_screenHeight;					///< Hauteur de l'écran en pixels.
+		float	_alpha;						///< Fraction du tick écoulée (interpolation du serpent).
 		SDL_Window* _window = nullptr;		///< Pointeur vers la fenêtre SDL.
 		SDL_Renderer* _renderer = nullptr;	///< Pointeur vers le renderer SDL.
+		BoardRenderer	_board;				///< Rendu du plateau.
+		FrameStats*	_stats;					///< Mesures du rendu (nul : aucune).
 };
@@ -17,4 +17,14 @@
 extern "C" IGui* createGui() 
 { 
 	return new GuiSDL();
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Détruit une GUI créée par createGui(), dans la bibliothèque qui l'a allouée.
+ *
+ * @param gui La GUI à détruire (peut être nul).
+ */
+extern "C" void destroyGui(IGui* gui)
+{
+	delete gui;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file BoardView.hpp
+ * @brief Vue à plat, en lecture seule, d'une partie en cours.
+ *
+ * C'est tout ce qu'un contrôleur chargé dynamiquement (IBoardController)
+ * voit de la partie : des pointeurs vers la grille d'occupation et le corps
+ * du serpent tels que GameState les stocke, sans aucune copie. Une
+ * bibliothèque `libai_*.so` n'a donc besoin que des en-têtes, pas du moteur.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Point.hpp"
+#include "../core/Grid.hpp"
+#include "../core/Snake.hpp"
+
+/**
+ * @brief État d'une partie au moment de choisir une direction.
+ *
+ * Les pointeurs ne sont valides que pendant l'appel à
+ * IBoardController::decide() qui reçoit la vue : la partie avance ensuite.
+ */
+struct BoardView
+{
+	int			width;		///< Largeur du plateau, bords compris.
+	int			height;		///< Hauteur du plateau, bords compris.
+	const Cell*	cells;		///< width * height cases, ligne par ligne (bords marqués WALL).
+	BodyView	body;		///< Corps du serpent, de la tête vers la queue.
+	Point		food;		///< Case de la nourriture.
+	Direction	direction;	///< Direction courante (son opposé n'est pas un coup).
+	int			score;		///< Score courant.
+	int			scoreLimit;	///< Score qui termine la partie (0 : plateau plein).
+
+	/**
+	 * @brief Contenu d'une case (WALL hors du plateau).
+	 */
+	Cell at(int x, int y) const
+	{
+		if (x < 0 || y < 0 || x >= width || y >= height)
+			return Cell::WALL;
+		return cells[static_cast<size_t>(y) * width + x];
+	}
+
+	/**
+	 * @brief Tête du serpent.
+	 */
+	const Point& head() const
+	{
+		return body.first.data[0];
+	}
+
+	/**
+	 * @brief Queue du serpent.
+	 */
+	const Point& tail() const
+	{
+		return body.second.size > 0 ? body.second.data[body.second.size - 1]
+			: body.first.data[body.first.size - 1];
+	}
+};
@@ -0,0 +1,65 @@
+/**
+ * @file GridCells.hpp
+ * @brief Cases du plateau désignées par leur indice linéaire, pour les joueurs automatiques.
+ *
+ * Les contrôleurs (Autopilot, HamiltonPilot...) parcourent la grille par
+ * indices (y * largeur + x) plutôt que par Point : une case voisine est à
+ * ±1 ou ±largeur, et les bords étant des murs, aucun pas ne sort du plateau.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "Input.hpp"
+#include "Point.hpp"
+#include "../core/Grid.hpp"
+
+/**
+ * @brief Indice d'une case dans la grille (ligne par ligne).
+ *
+ * @param p Case du plateau.
+ * @param width Largeur du plateau.
+ */
+inline uint32_t cellIndex(const Point& p, int width)
+{
+	return static_cast<uint32_t>(p.y) * static_cast<uint32_t>(width) + static_cast<uint32_t>(p.x);
+}
+
+/**
+ * @brief Direction d'une case vers sa voisine.
+ *
+ * @param from Case de départ.
+ * @param to Case voisine de `from`.
+ * @param width Largeur du plateau.
+ */
+inline Input directionTo(uint32_t from, uint32_t to, int width)
+{
+	if (to + static_cast<uint32_t>(width) == from)
+		return Input::UP;
+	if (to == from + static_cast<uint32_t>(width))
+		return Input::DOWN;
+	return to < from ? Input::LEFT : Input::RIGHT;
+}
+
+/**
+ * @brief Distance de Manhattan entre deux cases.
+ *
+ * @param a Première case.
+ * @param b Seconde case.
+ * @param width Largeur du plateau.
+ */
+inline uint32_t cellDistance(uint32_t a, uint32_t b, int width)
+{
+	uint32_t w = static_cast<uint32_t>(width);
+	uint32_t dx = a % w > b % w ? a % w - b % w : b % w - a % w;
+	uint32_t dy = a / w > b / w ? a / w - b / w : b / w - a / w;
+	return dx + dy;
+}
+
+/**
+ * @brief Case que la tête peut occuper sans mourir : vide ou nourriture.
+ */
+inline bool isPassableCell(Cell cell)
+{
+	return cell == Cell::EMPTY || cell == Cell::FOOD;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file IBoardController.hpp
+ * @brief Interface des joueurs automatiques chargés dynamiquement (`libai_*.so`).
+ *
+ * Comme les GUI, un contrôleur externe est une bibliothèque partagée qui
+ * exporte une fabrique et un destructeur en `extern "C"` ; le jeu la charge
+ * avec `--ai chemin.so` (voir ControllerPlugin).
+ */
+
+#pragma once
+
+#include "BoardView.hpp"
+#include "Input.hpp"
+
+/**
+ * @class IBoardController
+ * @brief Choisit une direction à chaque tick à partir d'une vue à plat du plateau.
+ *
+ * decide() est appelée une fois par tick, avant la mise à jour, depuis le
+ * thread qui fait avancer la partie ; elle renvoie UP, DOWN, LEFT, RIGHT,
+ * ou NONE pour garder la direction courante (toute autre valeur compte
+ * comme NONE). Une nouvelle partie peut commencer entre deux appels, sur un
+ * plateau de même taille.
+ */
+class IBoardController
+{
+	public:
+		virtual Input decide(const BoardView& board) = 0;
+		virtual ~IBoardController(){};
+};
+
+/**
+ * @brief Fabrique exportée par chaque bibliothèque de contrôleur : `extern "C" IBoardController* createController()`.
+ */
+using CreateControllerFunc = IBoardController* (*)();
+
+/**
+ * @brief Destructeur exporté par chaque bibliothèque de contrôleur : `extern "C" void destroyController(IBoardController*)`.
+ *
+ * Le contrôleur est détruit par la bibliothèque qui l'a créé, avec le même
+ * allocateur.
+ */
+using DestroyControllerFunc = void (*)(IBoardController*);
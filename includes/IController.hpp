@@ -0,0 +1,28 @@
+/**
+ * @file IController.hpp
+ * @brief Interface des joueurs automatiques.
+ *
+ * Un contrôleur remplace le joueur : avant chaque tick, la simulation lui
+ * présente la partie et met en attente la direction qu'il choisit.
+ */
+
+#pragma once
+
+#include "Input.hpp"
+
+class GameState;
+
+/**
+ * @class IController
+ * @brief Choisit une direction à chaque tick à partir de l'état de la partie.
+ *
+ * nextInput() est appelée une fois par tick, avant la mise à jour, depuis
+ * le thread qui fait avancer la partie ; elle renvoie UP, DOWN, LEFT,
+ * RIGHT, ou NONE pour garder la direction courante.
+ */
+class IController
+{
+	public:
+		virtual Input nextInput(const GameState& game) = 0;
+		virtual ~IController(){};
+};
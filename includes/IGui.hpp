@@ -7,8 +7,12 @@
 
 #pragma once
 
-#include "../core/GameState.hpp"
+#include "../core/Frame.hpp"
 #include "Input.hpp"
+#include "InputQueue.hpp"
+#include "RenderEvent.hpp"
+
+class FrameStats;
 
 /**
  * @class IGui
@@ -26,10 +30,78 @@ class IGui
 {
 	public:
 		virtual void init(int width, int height) = 0;
-		virtual void render(const GameState& state) = 0;
+		virtual void render(const Frame& state) = 0;
 		virtual Input getInput() = 0;
 		virtual void cleanup() = 0;
 		virtual void showVictory() = 0;
 		virtual void showGameOver() = 0;
 		virtual ~IGui(){};
-};
\ No newline at end of file
+
+		/**
+		 * @brief Fraction du tick écoulée depuis la dernière mise à jour (0 à 1).
+		 *
+		 * Appelée avant chaque render() ; les GUI qui interpolent le serpent
+		 * entre deux ticks s'en servent, les autres l'ignorent.
+		 */
+		virtual void setInterpolation(float alpha) { (void)alpha; }
+
+		/**
+		 * @brief Indique si la GUI veut des images entre les ticks (interpolation).
+		 *
+		 * Sinon, render() n'est appelée qu'après un tick ou une entrée.
+		 */
+		virtual bool isSmooth() const { return false; }
+
+		/**
+		 * @brief Met à jour l'affichage à partir des seuls changements d'un tick.
+		 *
+		 * Appelée à la place de render() lorsque l'instantané suit directement
+		 * celui qui est affiché : une GUI qui garde sa scène peut alors se
+		 * mettre à jour en O(changements) au lieu de parcourir tout le plateau.
+		 *
+		 * @param events Changements depuis l'instantané affiché, dans l'ordre.
+		 * @return false si la GUI ne sait pas appliquer ces changements ;
+		 * render() est alors appelée avec l'instantané complet.
+		 */
+		virtual bool apply(const RenderEventList& events) { (void)events; return false; }
+
+		/**
+		 * @brief Donne à la GUI où enregistrer ses mesures (`--stats`).
+		 *
+		 * Les GUI qui le gèrent mesurent, dans render(), la construction de
+		 * l'image (StatsPhase::DRAW) et son envoi à l'écran
+		 * (StatsPhase::PRESENT). nullptr désactive les mesures.
+		 */
+		virtual void setStats(FrameStats* stats) { (void)stats; }
+
+		/**
+		 * @brief Dépose dans la file toutes les entrées reçues depuis l'appel précédent.
+		 *
+		 * Par défaut, appelle getInput() jusqu'à ce qu'elle ne renvoie plus
+		 * rien (au plus InputQueue::CAPACITY fois). Les GUI qui reçoivent
+		 * leurs touches par événements redéfinissent cette méthode pour les
+		 * horodater dès leur réception.
+		 */
+		virtual void pollInputs(InputQueue& queue)
+		{
+			for (size_t i = 0; i < InputQueue::CAPACITY; ++i)
+			{
+				Input input = getInput();
+				if (input == Input::NONE)
+					break;
+				queue.push(input);
+			}
+		}
+};
+/**
+ * @brief Fabrique exportée par chaque bibliothèque de GUI : `extern "C" IGui* createGui()`.
+ */
+using CreateGuiFunc = IGui* (*)();
+
+/**
+ * @brief Destructeur exporté par chaque bibliothèque de GUI : `extern "C" void destroyGui(IGui*)`.
+ *
+ * La GUI est détruite par la bibliothèque qui l'a créée, avec le même
+ * allocateur.
+ */
+using DestroyGuiFunc = void (*)(IGui*);
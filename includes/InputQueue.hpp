@@ -0,0 +1,122 @@
+/**
+ * @file InputQueue.hpp
+ * @brief File d'entrées sans verrou entre la GUI et la boucle de jeu.
+ *
+ * La GUI (producteur) y dépose chaque touche dès qu'elle la reçoit, avec
+ * l'instant de réception ; la boucle de jeu (consommateur) vide la file à
+ * chaque image. Aucune touche n'est perdue entre deux images, même quand
+ * plusieurs arrivent pendant le même tick.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Input.hpp"
+
+/**
+ * @brief Entrée utilisateur horodatée.
+ */
+struct InputEvent
+{
+	Input		input;		///< Touche ou action reçue.
+	uint64_t	timeNs;		///< Instant de réception (InputQueue::now()).
+};
+
+/**
+ * @class InputQueue
+ * @brief Tampon circulaire à un producteur et un consommateur, sans verrou.
+ *
+ * Les index de lecture et d'écriture ne font que croître ; chacun n'est
+ * écrit que par un seul côté et publié avec une sémantique release/acquire,
+ * ce qui suffit à transmettre les événements entre deux threads. Quand la
+ * file est pleine, les nouvelles entrées sont refusées et comptées
+ * (getDropped()).
+ */
+class InputQueue
+{
+	public:
+		static const size_t CAPACITY = 64;	///< Nombre maximal d'événements en attente (puissance de deux).
+
+		InputQueue() : head(0), tail(0), dropped(0) {}
+		InputQueue(const InputQueue&) = delete;
+		InputQueue& operator=(const InputQueue&) = delete;
+		~InputQueue() {}
+
+		/**
+		 * @brief Instant courant, en nanosecondes d'horloge monotone.
+		 */
+		static uint64_t now()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		/**
+		 * @brief Dépose une entrée horodatée maintenant (côté producteur).
+		 *
+		 * @return false si la file est pleine (l'entrée est perdue).
+		 */
+		bool push(Input input)
+		{
+			return push(InputEvent{ input, now() });
+		}
+
+		/**
+		 * @brief Dépose un événement (côté producteur).
+		 *
+		 * @return false si la file est pleine (l'événement est perdu).
+		 */
+		bool push(const InputEvent& event)
+		{
+			size_t write = tail.load(std::memory_order_relaxed);
+			if (write - head.load(std::memory_order_acquire) == CAPACITY)
+			{
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			events[write & (CAPACITY - 1)] = event;
+			tail.store(write + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Retire l'événement le plus ancien (côté consommateur).
+		 *
+		 * @param event [out] Événement retiré.
+		 * @return false si la file est vide.
+		 */
+		bool pop(InputEvent& event)
+		{
+			size_t read = head.load(std::memory_order_relaxed);
+			if (read == tail.load(std::memory_order_acquire))
+				return false;
+			event = events[read & (CAPACITY - 1)];
+			head.store(read + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Indique si la file est vide (valeur indicative hors du consommateur).
+		 */
+		bool empty() const
+		{
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Nombre d'entrées refusées parce que la file était pleine.
+		 */
+		uint64_t getDropped() const
+		{
+			return dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		alignas(64) std::atomic<size_t>	head;				///< Prochain événement à lire (consommateur).
+		alignas(64) std::atomic<size_t>	tail;				///< Prochaine place à écrire (producteur).
+		InputEvent						events[CAPACITY];	///< Événements en attente.
+		std::atomic<uint64_t>			dropped;			///< Entrées refusées (écrit par le producteur).
+};
@@ -0,0 +1,43 @@
+/**
+ * @file Interpolation.hpp
+ * @brief Position des segments du serpent entre deux ticks.
+ *
+ * Les GUI en pixels affichent plus d'images que la simulation ne produit de
+ * ticks : chaque segment est dessiné entre sa position au tick précédent et
+ * sa position actuelle, selon la fraction de tick écoulée.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "../core/Snake.hpp"
+
+/**
+ * @brief Point en coordonnées de cases non entières.
+ */
+struct PointF
+{
+	float x;
+	float y;
+};
+
+/**
+ * @brief Position interpolée d'un segment du serpent.
+ *
+ * Au tick précédent, le segment `index` occupait la place du segment
+ * `index + 1` (et le dernier, celle de l'ancienne queue).
+ *
+ * @param snake Serpent à afficher.
+ * @param index Indice du segment (0 pour la tête).
+ * @param alpha Fraction du tick écoulée, entre 0 (tick précédent) et 1 (tick courant).
+ * @return La position du segment, en cases.
+ */
+inline PointF interpolateSegment(const Snake& snake, size_t index, float alpha)
+{
+	const Point& current = snake.getSegment(index);
+	const Point& previous = index + 1 < snake.getLength()
+		? snake.getSegment(index + 1) : snake.getPreviousTail();
+
+	return PointF{ previous.x + (current.x - previous.x) * alpha,
+		previous.y + (current.y - previous.y) * alpha };
+}
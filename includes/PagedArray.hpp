@@ -0,0 +1,196 @@
+/**
+ * @file PagedArray.hpp
+ * @brief Tableau de capacité fixe, alloué ou projeté depuis un fichier.
+ *
+ * Sert de stockage à la grille : sa capacité est fixée à la construction
+ * (aucune réallocation en cours de partie), et son contenu peut être
+ * projeté en copie privée depuis une sauvegarde (map()). Une projection
+ * ne copie rien : les pages sont chargées à leur premier accès et copiées
+ * à leur première écriture. Le coût d'une restauration est donc celui de
+ * la lecture des pages que l'appelant parcourt, et non d'une copie.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <type_traits>
+#include <unistd.h>
+
+/**
+ * @class PagedArray
+ * @brief Suite d'éléments de type T, de taille variable dans une capacité fixe.
+ *
+ * La mémoire allouée (calloc) est initialement à zéro ; au-delà de size(),
+ * le contenu n'est pas spécifié. Copier un tableau projeté en alloue un
+ * nouveau : la copie ne dépend plus du fichier.
+ */
+template <typename T>
+class PagedArray
+{
+	static_assert(std::is_trivially_copyable<T>::value, "PagedArray holds raw memory");
+
+	public:
+		PagedArray() : _data(nullptr), _size(0), _capacity(0), _mappedBytes(0) {}
+
+		/**
+		 * @brief Alloue un tableau vide pouvant contenir `capacity` éléments.
+		 */
+		explicit PagedArray(size_t capacity) : PagedArray()
+		{
+			reserve(capacity);
+		}
+
+		PagedArray(const PagedArray& other) : PagedArray()
+		{
+			*this = other;
+		}
+
+		/**
+		 * @brief Copie les éléments (la capacité est celle de l'autre tableau).
+		 */
+		PagedArray& operator=(const PagedArray& other)
+		{
+			if (this != &other)
+			{
+				if (_capacity != other._capacity || _mappedBytes != 0)
+					reserve(other._capacity);
+				if (other._size > 0)
+					std::memcpy(_data, other._data, other._size * sizeof(T));
+				_size = other._size;
+			}
+			return *this;
+		}
+
+		~PagedArray()
+		{
+			release();
+		}
+
+		/**
+		 * @brief Projette `count` éléments d'un fichier en copie privée, dans une capacité de `capacity`.
+		 *
+		 * @param fd Descripteur du fichier (il peut être fermé ensuite).
+		 * @param offset Position des éléments dans le fichier (multiple de la taille de page).
+		 * @param count Nombre d'éléments présents dans le fichier.
+		 * @param capacity Capacité du tableau (au moins `count`).
+		 * @throw std::runtime_error si la projection échoue.
+		 */
+		void map(int fd, uint64_t offset, size_t count, size_t capacity)
+		{
+			if (count > capacity)
+				throw std::runtime_error("PagedArray: more elements than capacity");
+			release();
+
+			size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			size_t bytes = roundUp(capacity * sizeof(T), page);
+			size_t fileBytes = roundUp(count * sizeof(T), page);
+			if (bytes == 0)
+				return;
+			// Réserve toute la capacité en mémoire anonyme, puis place le fichier au début
+			void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (base == MAP_FAILED)
+				throw std::runtime_error(std::string("PagedArray: mmap failed: ") + std::strerror(errno));
+			if (fileBytes > 0 && mmap(base, fileBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+				static_cast<off_t>(offset)) == MAP_FAILED)
+			{
+				int error = errno;
+				munmap(base, bytes);
+				throw std::runtime_error(std::string("PagedArray: mmap failed: ") + std::strerror(error));
+			}
+			_data = static_cast<T*>(base);
+			_size = count;
+			_capacity = capacity;
+			_mappedBytes = bytes;
+		}
+
+		T*			data()							{ return _data; }
+		const T*	data() const					{ return _data; }
+		size_t		size() const					{ return _size; }
+		size_t		capacity() const				{ return _capacity; }
+		bool		isMapped() const				{ return _mappedBytes != 0; }
+		T&			operator[](size_t i)			{ return _data[i]; }
+		const T&	operator[](size_t i) const		{ return _data[i]; }
+		T&			back()							{ return _data[_size - 1]; }
+		T*			begin()							{ return _data; }
+		T*			end()							{ return _data + _size; }
+		const T*	begin() const					{ return _data; }
+		const T*	end() const						{ return _data + _size; }
+
+		/**
+		 * @brief Ajoute un élément (la capacité doit le permettre).
+		 */
+		void push_back(const T& value)
+		{
+			_data[_size++] = value;
+		}
+
+		/**
+		 * @brief Retire le dernier élément.
+		 */
+		void pop_back()
+		{
+			--_size;
+		}
+
+		/**
+		 * @brief Change le nombre d'éléments, sans initialiser les nouveaux.
+		 *
+		 * @throw std::length_error au-delà de la capacité.
+		 */
+		void resize(size_t size)
+		{
+			if (size > _capacity)
+				throw std::length_error("PagedArray: size exceeds capacity");
+			_size = size;
+		}
+
+		/**
+		 * @brief Remplace le contenu par un tableau vide, alloué, de `capacity` éléments.
+		 */
+		void reserve(size_t capacity)
+		{
+			T* storage = nullptr;
+			if (capacity > 0)
+			{
+				storage = static_cast<T*>(std::calloc(capacity, sizeof(T)));
+				if (!storage)
+					throw std::bad_alloc();
+			}
+			release();
+			_data = storage;
+			_capacity = capacity;
+		}
+
+	private:
+		static size_t roundUp(size_t value, size_t multiple)
+		{
+			return (value + multiple - 1) / multiple * multiple;
+		}
+
+		/**
+		 * @brief Libère la mémoire, allouée ou projetée.
+		 */
+		void release()
+		{
+			if (_mappedBytes != 0)
+				munmap(_data, _mappedBytes);
+			else
+				std::free(_data);
+			_data = nullptr;
+			_size = 0;
+			_capacity = 0;
+			_mappedBytes = 0;
+		}
+
+		T*		_data;			///< Premier élément.
+		size_t	_size;			///< Nombre d'éléments.
+		size_t	_capacity;		///< Nombre d'éléments au plus.
+		size_t	_mappedBytes;	///< Taille de la projection (0 : mémoire allouée par calloc()).
+};
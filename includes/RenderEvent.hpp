@@ -0,0 +1,44 @@
+/**
+ * @file RenderEvent.hpp
+ * @brief Définition des événements de rendu produits par GameState::update().
+ */
+
+#pragma once
+
+#include "Point.hpp"
+#include <vector>
+
+/**
+ * @brief Nature d'un changement visible de la partie.
+ */
+enum class RenderEventType
+{
+	HEAD_ADDED,		///< Une case devient la tête du serpent (l'ancienne tête devient du corps).
+	TAIL_REMOVED,	///< La queue du serpent libère une case.
+	FOOD_MOVED,		///< La nourriture est placée sur une case ((-1, -1) : plus de nourriture).
+	SCORE_CHANGED,	///< Le score prend la valeur `value`.
+	OBSTACLE_ADDED,	///< Un obstacle est posé sur une case.
+	GAME_OVER		///< La partie est terminée.
+};
+
+/**
+ * @brief Un changement visible, dans l'ordre où la partie l'a produit.
+ *
+ * Appliqués dans l'ordre à l'affichage du tick précédent, les événements
+ * d'un tick donnent l'affichage du tick courant.
+ */
+struct RenderEvent
+{
+	RenderEventType	type;	///< Nature du changement.
+	Point			cell;	///< Case concernée (sauf SCORE_CHANGED et GAME_OVER).
+	int				value;	///< Nouveau score pour SCORE_CHANGED, 0 sinon.
+
+	RenderEvent(RenderEventType type_, const Point& cell_, int value_ = 0)
+		: type(type_), cell(cell_), value(value_) {}
+	RenderEvent() : type(RenderEventType::GAME_OVER), cell(), value(0) {}
+};
+
+/**
+ * @brief Événements produits entre deux instantanés.
+ */
+using RenderEventList = std::vector<RenderEvent>;
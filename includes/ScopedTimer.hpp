@@ -0,0 +1,56 @@
+/**
+ * @file ScopedTimer.hpp
+ * @brief Chronomètre de portée qui enregistre sa durée dans un FrameStats.
+ */
+
+#pragma once
+
+#include "InputQueue.hpp"
+#include "../core/FrameStats.hpp"
+
+/**
+ * @class ScopedTimer
+ * @brief Mesure (horloge monotone) le temps passé entre sa construction et sa destruction.
+ *
+ * Sans FrameStats (pointeur nul), ne lit même pas l'horloge : les mesures
+ * ne coûtent rien quand `--stats` n'est pas demandé.
+ */
+class ScopedTimer
+{
+	public:
+		/**
+		 * @brief Démarre la mesure d'une phase.
+		 *
+		 * @param stats Destination des mesures, ou nullptr pour ne rien mesurer.
+		 * @param phase Phase mesurée.
+		 */
+		ScopedTimer(FrameStats* stats, StatsPhase phase)
+			: _stats(stats), _phase(phase), _start(stats ? InputQueue::now() : 0)
+		{}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		/**
+		 * @brief Enregistre la durée écoulée, si stop() ne l'a pas déjà fait.
+		 */
+		~ScopedTimer()
+		{
+			stop();
+		}
+
+		/**
+		 * @brief Enregistre la durée écoulée dès maintenant ; la destruction n'enregistre plus rien.
+		 */
+		void stop()
+		{
+			if (_stats)
+				_stats->record(_phase, InputQueue::now() - _start);
+			_stats = nullptr;
+		}
+
+	private:
+		FrameStats*	_stats;	///< Destination des mesures (nulle : inactif).
+		StatsPhase	_phase;	///< Phase mesurée.
+		uint64_t	_start;	///< Instant de départ.
+};
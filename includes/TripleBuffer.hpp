@@ -0,0 +1,79 @@
+/**
+ * @file TripleBuffer.hpp
+ * @brief Triple tampon sans verrou entre un écrivain et un lecteur.
+ *
+ * L'écrivain (la simulation) remplit un tampon pendant que le lecteur (le
+ * rendu) lit le sien ; le troisième, au milieu, contient la dernière valeur
+ * publiée. Aucun des deux côtés n'attend jamais l'autre.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Trois valeurs de type T échangées par un seul index atomique.
+ *
+ * L'index du tampon du milieu porte un bit « nouveau » : publish() échange
+ * le tampon d'écriture avec celui du milieu en positionnant ce bit, et
+ * acquire() échange le tampon de lecture avec celui du milieu seulement si
+ * le bit est présent. Le lecteur obtient toujours la valeur la plus récente ;
+ * les valeurs intermédiaires qu'il n'a pas eu le temps de lire sont écrasées.
+ */
+template <typename T>
+class TripleBuffer
+{
+	public:
+		TripleBuffer() : writeIndex(0), middle(1), readIndex(2) {}
+		TripleBuffer(const TripleBuffer&) = delete;
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+		~TripleBuffer() {}
+
+		/**
+		 * @brief Tampon à remplir (côté écrivain).
+		 */
+		T& back()
+		{
+			return slots[writeIndex];
+		}
+
+		/**
+		 * @brief Publie le tampon rempli et en récupère un autre (côté écrivain).
+		 */
+		void publish()
+		{
+			writeIndex = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		/**
+		 * @brief Récupère la dernière valeur publiée, s'il y en a une nouvelle (côté lecteur).
+		 *
+		 * @return true si front() a changé.
+		 */
+		bool acquire()
+		{
+			if (!(middle.load(std::memory_order_relaxed) & FRESH))
+				return false;
+			readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & INDEX;
+			return true;
+		}
+
+		/**
+		 * @brief Dernière valeur obtenue par acquire() (côté lecteur).
+		 */
+		const T& front() const
+		{
+			return slots[readIndex];
+		}
+
+	private:
+		static const uint8_t INDEX = 0x3;	///< Bits de l'index du tampon.
+		static const uint8_t FRESH = 0x4;	///< Bit « valeur non lue » du tampon du milieu.
+
+		T						slots[3];	///< Les trois tampons.
+		uint8_t					writeIndex;	///< Tampon de l'écrivain.
+		std::atomic<uint8_t>	middle;		///< Tampon du milieu et bit FRESH.
+		uint8_t					readIndex;	///< Tampon du lecteur.
+};
@@ -8,60 +8,88 @@
  * (ncurses, SDL, OpenGL) en fonction des préférences de l'utilisateur.
  */
 
+#include "ai/Autopilot.hpp"
+#include "ai/HamiltonCycle.hpp"
+#include "ai/HamiltonPilot.hpp"
+#include "ai/MctsPilot.hpp"
+#include "core/ControllerPlugin.hpp"
 #include "core/Game.hpp"
+#include "core/FrameStats.hpp"
+#include "core/GuiManager.hpp"
+#include "core/Headless.hpp"
+#include "core/MatchRunner.hpp"
+#include "core/Ranking.hpp"
+#include "core/Replay.hpp"
+#include "core/Snapshot.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Simulation.hpp"
 #include "includes/IGui.hpp"
+#include "includes/ScopedTimer.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
+#include <climits>
+#include <cstdint>
 #include <cstdlib>
-#include <dlfcn.h>
+#include <stdexcept>
 #include <locale.h>
-#include <unistd.h>
-#include <ncurses.h>
-#include <SDL2/SDL.h>
 
 /**
- * @brief Charge dynamiquement un module GUI depuis une bibliothèque partagée.
- * 
- * @param path Chemin vers la bibliothèque partagée (.so).
- * @param width Largeur initiale du plateau de jeu.
- * @param height Hauteur initiale du plateau de jeu.
- * @return Pointeur vers l’instance IGui créée.
- * @note Quitte le programme en cas d’échec du chargement.
+ * @brief Nom de la GUI associée à une touche de changement 1, 2 ou 3.
+ *
+ * @param target SWITCH_TO_1 (SDL), SWITCH_TO_2 (ncurses) ou SWITCH_TO_3 (OpenGL).
+ * @return Nom de la GUI pour GuiManager.
  */
-IGui* loadGui(const std::string& path, int width, int height)
+static const char*	switchTarget(Input target)
 {
-	void* handle = dlopen(path.c_str(), RTLD_LAZY);
-	if (!handle)
+	switch (target)
 	{
-		std::cerr << "❌ Failed to load " << path << ": " << dlerror() << std::endl;
-		exit(1);
+		case Input::SWITCH_TO_1: return "sdl";
+		case Input::SWITCH_TO_2: return "ncurses";
+		default:                 return "opengl";
 	}
+}
 
-	using CreateGuiFunc = IGui* (*)();
-	CreateGuiFunc create = (CreateGuiFunc)dlsym(handle, "createGui");
-	if (!create)
-	{
-		std::cerr << "❌ Failed to find createGui() in " << path << std::endl;
-		dlclose(handle);
-		exit(1);
+/**
+ * @brief Remplace la GUI courante, ou la garde si la nouvelle est indisponible.
+ *
+ * @param guis Gestionnaire des GUI.
+ * @param name Nom de la nouvelle GUI.
+ * @param width Largeur du plateau.
+ * @param height Hauteur du plateau.
+ * @return La GUI ouverte après le changement.
+ * @throw std::runtime_error si plus aucune GUI n'est ouverte.
+ */
+static IGui*	switchGui(GuiManager &guis, const char* name, int width, int height)
+{
+	if (guis.currentName() == name)
+		return guis.current();
+	try {
+		return guis.open(name, width, height);
+	} catch (const std::runtime_error&) {
+		// Bibliothèque absente : la GUI courante est restée ouverte
+		if (!guis.current())
+			throw;
+		return guis.current();
 	}
-	IGui* gui = create();
-	gui->init(width, height);
-	return gui;
 }
 
 /**
  * @brief Affiche l’écran de fin approprié selon le résultat de la partie.
  * 
- * @param game Référence vers l’état actuel du jeu.
+ * @param game Dernier instantané de la partie.
  * @param gui Référence vers le pointeur de l’interface graphique.
  * @param quitByPlayer Indique si le joueur a quitté volontairement.
  */
-void	showEndScreen(GameState &game, IGui* &gui, bool quitByPlayer)
+void	showEndScreen(const Frame &game, IGui* &gui, bool quitByPlayer)
 {
 	if (!quitByPlayer)
 	{
-		if (game.getScore() >= 200)
+		if (game.isWon())
 			gui->showVictory();
 		else
 			gui->showGameOver();
@@ -79,12 +107,37 @@ void	showEndScreen(GameState &game, IGui* &gui, bool quitByPlayer)
 static void	printUsage(const char* prog) 
 {
     std::cout << "Usage: " << prog << " <width> <height> [options]\n"
+              << "       " << prog << " --replay FILE [--headless] [-n|-sdl|-gl] [--fps N]\n"
+              << "       " << prog << " --load FILE [options]\n"
               << "Options:\n"
               << "  -o         : enable obstacles\n"
               << "  -chaos     : invert directions (chaos mode)\n"
               << "  -n         : start with ncurses GUI (default)\n"
               << "  -sdl       : start with SDL GUI\n"
               << "  -gl        : start with OpenGL GUI\n"
+              << "  --seed N   : seed the game (identical seeds give identical games)\n"
+              << "  --tick-rate HZ : simulation ticks per second (default 10)\n"
+              << "  --fps N    : frame cap for smooth GUIs, 0 for uncapped (default 60)\n"
+              << "  --tick-stats : print tick timing statistics on exit\n"
+              << "  --stats FILE : write per-phase frame timings on exit (JSON if FILE ends in .json, else CSV)\n"
+              << "  --headless : run without display as fast as possible (null GUI)\n"
+              << "  --ticks N  : ticks to simulate in headless mode (per-game cap with --matches)\n"
+              << "  --matches N: play N seeded games in parallel and report games/sec\n"
+              << "  --threads N: worker threads for --matches and --mcts (default: one per core)\n"
+              << "  --record FILE : record the game's inputs to a compact replay file\n"
+              << "  --replay FILE : replay a recorded game (board, seed and tick rate come from FILE);\n"
+              << "                  with --headless, as fast as possible, exiting 1 on a mismatch\n"
+              << "  --save FILE   : save the full game state to FILE on exit\n"
+              << "  --load FILE   : resume a game saved with --save (board comes from FILE)\n"
+              << "  --autopilot   : let the built-in pathfinder steer (interactive or headless)\n"
+              << "  --hamilton    : follow a Hamiltonian cycle with safe shortcuts (fills the board)\n"
+              << "  --cycle-cache DIR : where --hamilton caches its cycles, a directory only you can access\n"
+              << "                      (default $XDG_CACHE_HOME/nibbler or ~/.cache/nibbler)\n"
+              << "  --mcts MS     : Monte Carlo tree search with an MS-millisecond budget per move (--threads)\n"
+              << "  --ai FILE     : let a controller plugin (libai_*.so exporting createController) steer\n"
+              << "  --rank N      : play N seeded games with each --ai plugin and built-in pilot given,\n"
+              << "                  then rank them by score and by decision latency\n"
+              << "  --score-cap N : score that ends the game (default 200, 0 to play until the board is full)\n"
               << "  -h,--help  : show this help\n";
 }
 
@@ -94,65 +147,253 @@ enum class GuiStart {
 	OpenGL
 };
 
+/**
+ * @brief Options lues sur la ligne de commande.
+ */
+struct Options
+{
+	int			width = 0;					///< Largeur du plateau (en cases).
+	int			height = 0;					///< Hauteur du plateau (en cases).
+	bool		obstacles = false;			///< Active les obstacles.
+	bool		chaos = false;				///< Active le mode chaos.
+	GuiStart	gui = GuiStart::Ncurses;	///< Interface graphique au démarrage.
+	uint64_t	seed = 0;					///< Graine de la partie.
+	bool		hasSeed = false;			///< Vrai si --seed a été fourni.
+	uint64_t	tickRate = 10;				///< Ticks de simulation par seconde.
+	uint64_t	fps = 60;					///< Images par seconde au plus (0 : sans limite).
+	bool		tickStats = false;			///< Affiche les statistiques de cadence en fin de partie.
+	std::string	statsPath;					///< Fichier des mesures par phase (--stats), vide sinon.
+	bool		headless = false;			///< Simulation sans affichage (--headless).
+	uint64_t	ticks = 100000;				///< Ticks à simuler en mode sans affichage.
+	uint64_t	matches = 0;				///< Parties du tournoi (--matches), 0 sinon.
+	uint64_t	threads = 0;				///< Threads du tournoi ou de --mcts (0 : un par cœur).
+	std::string	recordPath;					///< Enregistrement de la partie (--record), vide sinon.
+	std::string	replayPath;					///< Partie à rejouer (--replay), vide sinon.
+	std::string	savePath;					///< Sauvegarde de la partie en fin de jeu (--save), vide sinon.
+	std::string	loadPath;					///< Sauvegarde à reprendre (--load), vide sinon.
+	bool		autopilot = false;			///< Le serpent est dirigé par l'autopilote (--autopilot).
+	bool		hamilton = false;			///< Le serpent suit un circuit hamiltonien (--hamilton).
+	std::string	cycleCache;					///< Dossier du cache des circuits (--cycle-cache).
+	uint64_t	mctsMs = 0;					///< Budget par coup de la recherche Monte-Carlo (--mcts), 0 sinon.
+	std::vector<std::string>	aiPaths;	///< Bibliothèques de contrôleurs (--ai, répétable avec --rank).
+	uint64_t	rankGames = 0;				///< Parties par contrôleur du classement (--rank), 0 sinon.
+	int			scoreCap = GameState::SCORE_LIMIT;	///< Score qui termine la partie (0 : plateau plein).
+	bool		hasScoreCap = false;		///< Vrai si --score-cap a été fourni.
+};
+
+/**
+ * @brief Lit la valeur numérique qui suit une option (`--seed 42`).
+ *
+ * @param argc  Nombre d’arguments.
+ * @param argv  Tableau des arguments.
+ * @param i     [in,out] Indice de l’option, avancé sur sa valeur.
+ * @param value [out] Valeur lue.
+ * @return true si une valeur entière positive suit l’option.
+ */
+static bool	readValue(int argc, char** argv, int &i, uint64_t &value)
+{
+	if (i + 1 >= argc)
+	{
+		std::cout << "Error: " << argv[i] << " expects a value.\n";
+		return false;
+	}
+	try {
+		size_t used = 0;
+		std::string text = argv[++i];
+		value = std::stoull(text, &used);
+		if (used != text.size() || text[0] == '-')
+			throw std::invalid_argument(text);
+	} catch (const std::exception&) {
+		std::cout << "Error: " << argv[i - 1] << " expects a positive integer.\n";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Lit le nom de fichier qui suit une option (`--stats out.csv`).
+ *
+ * @param argc  Nombre d’arguments.
+ * @param argv  Tableau des arguments.
+ * @param i     [in,out] Indice de l’option, avancé sur sa valeur.
+ * @param value [out] Nom lu.
+ * @return true si un nom suit l’option.
+ */
+static bool	readPath(int argc, char** argv, int &i, std::string &value)
+{
+	if (i + 1 >= argc)
+	{
+		std::cout << "Error: " << argv[i] << " expects a file name.\n";
+		return false;
+	}
+	value = argv[++i];
+	return true;
+}
 
 /**
  * @brief Analyse et valide les arguments passés en ligne de commande.
  *
  * Convertit `<width>` et `<height>` en entiers, vérifie la taille minimale (> 30),
- * lit les options (`-o`, `-chaos`, `-n`, `-sdl`, `-gl`) et remplit les sorties.
- * En cas d’option GUI multiple, renvoie une erreur.
+ * lit les options (`-o`, `-chaos`, `-n`, `-sdl`, `-gl`, `--seed`) et remplit
+ * les options. En cas d’option GUI multiple, renvoie une erreur. Une
+ * relecture ou une reprise (`--replay` ou `--load` en premier argument) se
+ * passe de la taille : elle vient du fichier.
  *
- * @param argc              Nombre d’arguments.
- * @param argv              Tableau des arguments.
- * @param width             [out] Largeur du plateau (en cases).
- * @param height            [out] Hauteur du plateau (en cases).
- * @param obstaclesEnabled  [out] Active les obstacles si vrai.
- * @param chaosEnabled      [out] Active le mode chaos si vrai.
- * @param guiStart          [out] Choix de l’interface graphique au démarrage.
+ * @param argc    Nombre d’arguments.
+ * @param argv    Tableau des arguments.
+ * @param options [out] Options lues.
  * @return true si l’analyse est réussie, false sinon.
  */
-bool parseArguments(int argc, char** argv,
-                    int &width, int &height,
-                    bool &obstaclesEnabled, bool &chaosEnabled,
-                    GuiStart &guiStart)
+bool parseArguments(int argc, char** argv, Options &options)
 {
-    if (argc < 3)
+    std::string first = argc >= 2 ? argv[1] : "";
+    bool sized = first != "--replay" && first != "--load";
+    if (sized && argc < 3)
     {
         printUsage(argv[0]);
         return false;
     }
 
-    int  w = 0;
-    int  h = 0;
-    bool obstacles = false;
-    bool chaos = false;
-    GuiStart chosenGui = GuiStart::Ncurses; // défaut
+    Options parsed;
     int guiCount = 0;
 
-    try {
-        w = std::stoi(argv[1]);
-        h = std::stoi(argv[2]);
-    } catch (const std::exception&) {
-        std::cout << "Error: width/height must be integers.\n";
-        printUsage(argv[0]);
-        return false;
-    }
-
-    if (w < 30 || h < 30)
+    if (sized)
     {
-        std::cout << "Error: size must be more than 30.\n";
-        return false;
+        try {
+            parsed.width = std::stoi(argv[1]);
+            parsed.height = std::stoi(argv[2]);
+        } catch (const std::exception&) {
+            std::cout << "Error: width/height must be integers.\n";
+            printUsage(argv[0]);
+            return false;
+        }
+
+        if (parsed.width < 30 || parsed.height < 30)
+        {
+            std::cout << "Error: size must be more than 30.\n";
+            return false;
+        }
     }
 
     // options
-    for (int i = 3; i < argc; ++i)
+    for (int i = sized ? 3 : 1; i < argc; ++i)
     {
         std::string opt = argv[i];
-        if (opt == "-o")                 obstacles = true;
-        else if (opt == "-chaos")        chaos = true;
-        else if (opt == "-n")           { chosenGui = GuiStart::Ncurses; ++guiCount; }
-        else if (opt == "-sdl")         { chosenGui = GuiStart::SDL;     ++guiCount; }
-        else if (opt == "-gl")          { chosenGui = GuiStart::OpenGL;  ++guiCount; }
+        if (opt == "-o")                 parsed.obstacles = true;
+        else if (opt == "-chaos")        parsed.chaos = true;
+        else if (opt == "-n")           { parsed.gui = GuiStart::Ncurses; ++guiCount; }
+        else if (opt == "-sdl")         { parsed.gui = GuiStart::SDL;     ++guiCount; }
+        else if (opt == "-gl")          { parsed.gui = GuiStart::OpenGL;  ++guiCount; }
+        else if (opt == "--seed")
+        {
+            if (!readValue(argc, argv, i, parsed.seed))
+                return false;
+            parsed.hasSeed = true;
+        }
+        else if (opt == "--tick-rate")
+        {
+            if (!readValue(argc, argv, i, parsed.tickRate))
+                return false;
+            if (parsed.tickRate == 0)
+            {
+                std::cout << "Error: --tick-rate must be positive.\n";
+                return false;
+            }
+        }
+        else if (opt == "--fps")
+        {
+            if (!readValue(argc, argv, i, parsed.fps))
+                return false;
+        }
+        else if (opt == "--tick-stats")  parsed.tickStats = true;
+        else if (opt == "--stats")
+        {
+            if (!readPath(argc, argv, i, parsed.statsPath))
+                return false;
+        }
+        else if (opt == "--record")
+        {
+            if (!readPath(argc, argv, i, parsed.recordPath))
+                return false;
+        }
+        else if (opt == "--replay")
+        {
+            if (!readPath(argc, argv, i, parsed.replayPath))
+                return false;
+        }
+        else if (opt == "--save")
+        {
+            if (!readPath(argc, argv, i, parsed.savePath))
+                return false;
+        }
+        else if (opt == "--load")
+        {
+            if (!readPath(argc, argv, i, parsed.loadPath))
+                return false;
+        }
+        else if (opt == "--headless")    parsed.headless = true;
+        else if (opt == "--autopilot")   parsed.autopilot = true;
+        else if (opt == "--hamilton")    parsed.hamilton = true;
+        else if (opt == "--cycle-cache")
+        {
+            if (!readPath(argc, argv, i, parsed.cycleCache))
+                return false;
+        }
+        else if (opt == "--mcts")
+        {
+            if (!readValue(argc, argv, i, parsed.mctsMs))
+                return false;
+            if (parsed.mctsMs == 0)
+            {
+                std::cout << "Error: --mcts must be positive.\n";
+                return false;
+            }
+        }
+        else if (opt == "--ai")
+        {
+            std::string path;
+            if (!readPath(argc, argv, i, path))
+                return false;
+            parsed.aiPaths.push_back(path);
+        }
+        else if (opt == "--rank")
+        {
+            if (!readValue(argc, argv, i, parsed.rankGames))
+                return false;
+            if (parsed.rankGames == 0)
+            {
+                std::cout << "Error: --rank must be positive.\n";
+                return false;
+            }
+        }
+        else if (opt == "--score-cap")
+        {
+            uint64_t cap = 0;
+            if (!readValue(argc, argv, i, cap))
+                return false;
+            if (cap > INT_MAX)
+            {
+                std::cout << "Error: --score-cap is too large.\n";
+                return false;
+            }
+            parsed.scoreCap = static_cast<int>(cap);
+            parsed.hasScoreCap = true;
+        }
+        else if (opt == "--ticks")
+        {
+            if (!readValue(argc, argv, i, parsed.ticks))
+                return false;
+        }
+        else if (opt == "--matches")
+        {
+            if (!readValue(argc, argv, i, parsed.matches))
+                return false;
+        }
+        else if (opt == "--threads")
+        {
+            if (!readValue(argc, argv, i, parsed.threads))
+                return false;
+        }
         else if (opt == "-h" || opt == "--help") { printUsage(argv[0]); return false; }
         else {
             std::cout << "Unknown option: " << opt << "\n";
@@ -166,12 +407,70 @@ bool parseArguments(int argc, char** argv,
         std::cout << "Error: choose at most one GUI option among -n, -sdl, -gl.\n";
         return false;
     }
+    if (!parsed.recordPath.empty() && (parsed.headless || parsed.matches > 0 || !parsed.replayPath.empty()))
+    {
+        std::cout << "Error: --record only applies to an interactive game.\n";
+        return false;
+    }
+    bool mcts = parsed.mctsMs > 0;
+    size_t pilots = parsed.autopilot + parsed.hamilton + mcts + parsed.aiPaths.size();
+    if (parsed.rankGames > 0)
+    {
+        if (pilots == 0)
+        {
+            std::cout << "Error: --rank needs at least one --ai, --autopilot, --hamilton or --mcts.\n";
+            return false;
+        }
+        if (parsed.headless || parsed.matches > 0 || !parsed.replayPath.empty() || !parsed.recordPath.empty()
+            || !parsed.loadPath.empty())
+        {
+            std::cout << "Error: --rank cannot be combined with --headless, --matches, --replay, --record or --load.\n";
+            return false;
+        }
+    }
+    else if (pilots > 1)
+    {
+        std::cout << "Error: choose at most one of --autopilot, --hamilton, --mcts and --ai (or rank them with --rank).\n";
+        return false;
+    }
+    if (pilots > 0 && (parsed.matches > 0 || !parsed.replayPath.empty()))
+    {
+        std::cout << "Error: --autopilot, --hamilton, --mcts and --ai cannot be combined with --matches or --replay.\n";
+        return false;
+    }
+    if (parsed.hamilton && (parsed.headless || parsed.rankGames > 0) && parsed.obstacles)
+    {
+        // Chaque nouvelle partie sans affichage tire d'autres obstacles : un seul circuit ne suffit pas
+        std::cout << "Error: --hamilton cannot be combined with -o in --headless or --rank.\n";
+        return false;
+    }
+    if (parsed.hasScoreCap && !parsed.replayPath.empty())
+    {
+        std::cout << "Error: a replay's score cap comes from the replay file.\n";
+        return false;
+    }
+    if (!parsed.replayPath.empty() && parsed.matches > 0)
+    {
+        std::cout << "Error: --replay and --matches cannot be combined.\n";
+        return false;
+    }
+    bool interactive = !parsed.headless && parsed.matches == 0 && parsed.replayPath.empty();
+    if ((!parsed.savePath.empty() || !parsed.loadPath.empty()) && !interactive)
+    {
+        std::cout << "Error: --save and --load only apply to an interactive game.\n";
+        return false;
+    }
+    if (!parsed.loadPath.empty() && !parsed.recordPath.empty())
+    {
+        std::cout << "Error: a resumed game cannot be recorded (replays start from the seed).\n";
+        return false;
+    }
 
-    width = w; 
-	height = h;
-    obstaclesEnabled = obstacles;
-    chaosEnabled = chaos;
-    guiStart = chosenGui;
+    if (!parsed.hasSeed)
+        parsed.seed = Rng::randomSeed();
+    if (parsed.hamilton && parsed.cycleCache.empty())
+        parsed.cycleCache = HamiltonCycle::defaultCacheDirectory();
+    options = parsed;
     return true;
 }
 
@@ -198,11 +497,157 @@ Input applyChaosMode(Input input)
     }
 }
 
+/**
+ * @brief Exécute la simulation sans affichage et affiche ses mesures.
+ *
+ * Charge la GUI nulle (aucun rendu, entrées scriptées ou aléatoires) et
+ * enchaîne `--ticks` ticks sans pause ; avec `--autopilot`, `--hamilton`,
+ * `--mcts` ou `--ai`, le joueur automatique choisit les directions à la
+ * place de la GUI.
+ *
+ * @param options Options de la ligne de commande.
+ * @return Code de sortie.
+ */
+static int	runHeadlessMode(const Options &options)
+{
+	GuiManager guis(".");
+	IGui* gui = guis.open("null", options.width, options.height);
+	std::unique_ptr<Autopilot> autopilot;
+	if (options.autopilot)
+		autopilot.reset(new Autopilot(options.width, options.height));
+	IController* controller = autopilot.get();
+	std::unique_ptr<HamiltonCycle> cycle;
+	std::unique_ptr<HamiltonPilot> hamilton;
+	bool cached = false;
+	if (options.hamilton)
+	{
+		cycle = HamiltonCycle::load(GameState(options.width, options.height, options.obstacles, options.seed),
+			options.cycleCache, &cached);
+		hamilton.reset(new HamiltonPilot(*cycle));
+		controller = hamilton.get();
+	}
+	std::unique_ptr<ThreadPool> pool;
+	std::unique_ptr<MctsPilot> mcts;
+	if (options.mctsMs > 0)
+	{
+		pool.reset(new ThreadPool(static_cast<unsigned>(options.threads)));
+		mcts.reset(new MctsPilot(*pool, options.mctsMs * 1000000));
+		controller = mcts.get();
+	}
+	std::unique_ptr<ControllerPlugin> plugin;
+	if (!options.aiPaths.empty())
+	{
+		plugin.reset(new ControllerPlugin(options.aiPaths[0]));
+		controller = plugin.get();
+	}
+	HeadlessConfig config = { options.width, options.height, options.obstacles,
+		options.seed, options.ticks, controller, options.scoreCap };
+
+	HeadlessReport report = runHeadless(*gui, config);
+	std::cout << "seed: " << options.seed << "\n";
+	if (cycle)
+		std::cout << "cycle_cells: " << cycle->getLength() << "\n"
+		          << "cycle_cached: " << (cached ? "yes" : "no") << "\n"
+		          << "shortcuts: " << hamilton->getShortcuts() << "\n";
+	if (mcts)
+		std::cout << "mcts_threads: " << pool->getThreadCount() << "\n"
+		          << "playouts: " << mcts->getPlayouts() << "\n"
+		          << "playouts_per_sec: " << mcts->getPlayouts() * 1e9 / std::max<uint64_t>(mcts->getSearchNs(), 1)
+		          << "\n";
+	printHeadlessReport(report, std::cout);
+	return 0;
+}
+
+/**
+ * @brief Rejoue un enregistrement aussi vite que possible et vérifie son résultat.
+ *
+ * @param reader Enregistrement ouvert.
+ * @return 0 si le score et l’empreinte finale sont ceux de l’enregistrement, 1 sinon.
+ */
+static int	runReplayMode(ReplayReader &reader)
+{
+	ReplayReport report = playReplay(reader);
+	printReplayReport(reader, report, std::cout);
+	return report.matches ? 0 : 1;
+}
+
+/**
+ * @brief Joue `--matches` parties en parallèle et affiche le débit obtenu.
+ *
+ * @param options Options de la ligne de commande.
+ * @return Code de sortie.
+ */
+static int	runMatchMode(const Options &options)
+{
+	ThreadPool pool(static_cast<unsigned>(options.threads));
+	MatchConfig config = { options.width, options.height, options.obstacles,
+		options.seed, options.matches, options.ticks, options.scoreCap };
+
+	MatchReport report = runMatches(pool, config);
+	std::cout << "seed: " << options.seed << "\n";
+	printMatchReport(report, std::cout);
+	return 0;
+}
+
+/**
+ * @brief Fait jouer `--rank` parties à chaque joueur automatique demandé, puis les classe.
+ *
+ * Les parties sont celles du tournoi de même graine ; `--ticks` borne
+ * chacune d'elles.
+ *
+ * @param options Options de la ligne de commande.
+ * @return Code de sortie.
+ */
+static int	runRankMode(const Options &options)
+{
+	std::vector<RankingEntry> entries;
+	std::unique_ptr<Autopilot> autopilot;
+	if (options.autopilot)
+	{
+		autopilot.reset(new Autopilot(options.width, options.height));
+		entries.push_back(RankingEntry{ "astar", autopilot.get() });
+	}
+	std::unique_ptr<HamiltonCycle> cycle;
+	std::unique_ptr<HamiltonPilot> hamilton;
+	if (options.hamilton)
+	{
+		cycle = HamiltonCycle::load(GameState(options.width, options.height, false, options.seed),
+			options.cycleCache);
+		hamilton.reset(new HamiltonPilot(*cycle));
+		entries.push_back(RankingEntry{ "hamilton", hamilton.get() });
+	}
+	std::unique_ptr<ThreadPool> pool;
+	std::unique_ptr<MctsPilot> mcts;
+	if (options.mctsMs > 0)
+	{
+		pool.reset(new ThreadPool(static_cast<unsigned>(options.threads)));
+		mcts.reset(new MctsPilot(*pool, options.mctsMs * 1000000));
+		entries.push_back(RankingEntry{ "mcts", mcts.get() });
+	}
+	std::vector<std::unique_ptr<ControllerPlugin>> plugins;
+	for (const std::string& path : options.aiPaths)
+	{
+		plugins.push_back(std::unique_ptr<ControllerPlugin>(new ControllerPlugin(path)));
+		entries.push_back(RankingEntry{ path, plugins.back().get() });
+	}
+
+	RankingConfig config = { options.width, options.height, options.obstacles,
+		options.seed, options.rankGames, options.ticks, options.scoreCap };
+	std::cout << "seed: " << options.seed << "\n";
+	printRanking(rankControllers(entries, config), std::cout);
+	return 0;
+}
+
 /**
  * @brief Point d’entrée du jeu Nibbler.
  *
  * 1) Parse les arguments et sélectionne la GUI initiale.
- * 2) Boucle de jeu : lit l’input, met à jour l’état, rend l’affichage.
+ * 2) Boucle de jeu : la simulation tourne sur son propre thread à la
+ *    fréquence `--tick-rate` ; ce thread lit les entrées, les lui transmet
+ *    et affiche le dernier instantané publié (à chaque nouveau tick, ou
+ *    jusqu’à `--fps` images par seconde pour une GUI qui interpole) ; si
+ *    l’instantané suit celui qui est affiché, seuls ses événements sont
+ *    transmis à la GUI (IGui::apply()).
  * 3) Permet le switching à chaud entre GUI (1/2/3), gère le mode chaos, et l’aide.
  *
  * @param argc Nombre d’arguments.
@@ -211,79 +656,247 @@ Input applyChaosMode(Input input)
  */
 int main(int argc, char **argv) {
 	try {
-		int width = 0;
-		int	height = 0;
-		bool obstaclesEnabled = false;
-		bool chaosEnabled = false;
-		GuiStart guiStart = GuiStart::Ncurses;
+		Options options;
 
-		if (!parseArguments(argc, argv, width, height, obstaclesEnabled, chaosEnabled, guiStart))
+		if (!parseArguments(argc, argv, options))
 			return 1;
+		if (options.matches > 0)
+			return runMatchMode(options);
+		if (options.rankGames > 0)
+			return runRankMode(options);
+
+		// Relecture : le plateau, la graine et la cadence viennent de l’enregistrement
+		std::unique_ptr<ReplayReader> replay;
+		if (!options.replayPath.empty())
+		{
+			replay.reset(new ReplayReader(options.replayPath));
+			if (options.headless)
+				return runReplayMode(*replay);
+			const ReplayHeader& header = replay->getHeader();
+			options.width = header.width;
+			options.height = header.height;
+			options.obstacles = header.obstacles;
+			options.seed = header.seed;
+			options.tickRate = header.tickRate;
+			options.scoreCap = static_cast<int>(header.scoreLimit);
+			options.hasScoreCap = true;
+			options.chaos = false;
+		}
+		if (options.headless)
+			return runHeadlessMode(options);
+
+		// Reprise : la partie sauvegardée fixe le plateau et les obstacles
+		std::unique_ptr<GameState> loaded;
+		if (!options.loadPath.empty())
+		{
+			loaded.reset(new GameState(loadSnapshot(options.loadPath)));
+			options.width = loaded->getGrid().getWidth();
+			options.height = loaded->getGrid().getHeight();
+			options.obstacles = !loaded->getObstacles().empty();
+			options.seed = loaded->getSeed();
+		}
+
+		int width = options.width;
+		int	height = options.height;
+		bool chaosEnabled = options.chaos;
 
 		setlocale(LC_ALL, "");
 
-		// Sélection initiale de la lib en fonction de l’option
-		const char* initialLibPath = "./libgui_ncurses.so";
-		switch (guiStart)
+		// Sélection initiale de la lib en fonction de l’option ; les autres
+		// bibliothèques se chargent en arrière-plan pendant ce temps
+		const char* initialGui = "ncurses";
+		switch (options.gui)
 		{
-			case GuiStart::Ncurses: initialLibPath = "./libgui_ncurses.so"; break;
-			case GuiStart::SDL:     initialLibPath = "./libgui_sdl.so";     break;
-			case GuiStart::OpenGL:  initialLibPath = "./libgui_opengl.so";  break;
+			case GuiStart::Ncurses: initialGui = "ncurses"; break;
+			case GuiStart::SDL:     initialGui = "sdl";     break;
+			case GuiStart::OpenGL:  initialGui = "opengl";  break;
 		}
-		IGui* gui = loadGui(initialLibPath, width, height);
+		GuiManager guis(".");
+		guis.preload(true);
+		IGui* gui = guis.open(initialGui, width, height);
+		std::string guiNames = initialGui;
+
+		// Mesures par phase (--stats) : sans fichier demandé, rien n'est mesuré
+		FrameStats frameStats;
+		FrameStats* stats = options.statsPath.empty() ? nullptr : &frameStats;
+		gui->setStats(stats);
 
-		GameState game(width, height, obstaclesEnabled);
+		// Une partie reprise garde son score limite, sauf --score-cap explicite
+		double tickRate = static_cast<double>(options.tickRate);
+		GameState start = loaded ? *loaded : GameState(width, height, options.obstacles, options.seed);
+		if (!loaded || options.hasScoreCap)
+			start.setScoreLimit(options.scoreCap);
+		loaded.reset();
+		std::unique_ptr<Autopilot> autopilot;
+		if (options.autopilot)
+			autopilot.reset(new Autopilot(width, height));
+		std::unique_ptr<HamiltonCycle> cycle;
+		std::unique_ptr<HamiltonPilot> hamilton;
+		if (options.hamilton)
+		{
+			cycle = HamiltonCycle::load(start, options.cycleCache);
+			hamilton.reset(new HamiltonPilot(*cycle));
+		}
+		std::unique_ptr<ThreadPool> pool;
+		std::unique_ptr<MctsPilot> mcts;
+		if (options.mctsMs > 0)
+		{
+			pool.reset(new ThreadPool(static_cast<unsigned>(options.threads)));
+			mcts.reset(new MctsPilot(*pool, options.mctsMs * 1000000));
+		}
+		std::unique_ptr<ControllerPlugin> plugin;
+		if (!options.aiPaths.empty())
+			plugin.reset(new ControllerPlugin(options.aiPaths[0]));
+		std::unique_ptr<Simulation> simulationOwner(new Simulation(start, tickRate));
+		Simulation& simulation = *simulationOwner;
+		simulation.setStats(stats);
+		std::unique_ptr<ReplayWriter> recorder;
+		if (!options.recordPath.empty())
+		{
+			ReplayHeader header = { width, height, options.obstacles, options.seed,
+				static_cast<uint32_t>(options.tickRate), static_cast<uint32_t>(start.getScoreLimit()) };
+			recorder.reset(new ReplayWriter(header));
+			simulation.setRecorder(recorder.get());
+		}
+		simulation.setReplay(replay.get());
+		if (options.autopilot)
+			simulation.setController(autopilot.get());
+		else if (hamilton)
+			simulation.setController(hamilton.get());
+		else if (mcts)
+			simulation.setController(mcts.get());
+		else if (plugin)
+			simulation.setController(plugin.get());
+		std::chrono::nanoseconds frameInterval(options.fps > 0 ? 1000000000 / options.fps : 0);
+		InputQueue inputs;
 		bool quitByPlayer = false;
+		uint64_t shownSequence = 0;		// Instantané affiché (0 : à redessiner en entier)
+		bool shownHelp = false;
 
-		while (!game.isFinished())
+		simulation.start();
+		for (;;)
 		{
-			Input input = gui->getInput();
-
-			switch (input) {
-				case Input::HELP:
-					game.toggleHelpMenu();
-					break;
-				case Input::SWITCH_TO_1:
-					gui->cleanup();
-					delete gui;
-					gui = loadGui("./libgui_sdl.so", width, height);
-					usleep(500000);
-					continue;
-				case Input::SWITCH_TO_2:
-					gui->cleanup();
-					delete gui;
-					SDL_Quit();  // au cas où SDL n'a pas bien quitté
-					system("stty sane");  // restaure le terminal
-					system("clear");
-					gui = loadGui("./libgui_ncurses.so", width, height);
-					continue;
-				case Input::SWITCH_TO_3:
-					gui->cleanup();
-					delete gui;
-					gui = loadGui("./libgui_opengl.so", width, height);
-					usleep(500000);
-					continue;
-				case Input::EXIT:
-					quitByPlayer = true;
-					break;
-				default:
-					if (chaosEnabled)
-						input = applyChaosMode(input);
-					if (!game.isHelpMenuActive()) {
-						game.setDirection(input);
-						game.update();
-					}
+			std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+			Input guiSwitch = Input::NONE;
+			InputEvent event;
+
+			// Entrées : changement de GUI et sortie ici, le reste pour la simulation
+			ScopedTimer inputTimer(stats, StatsPhase::INPUT);
+			gui->pollInputs(inputs);
+			while (inputs.pop(event))
+			{
+				switch (event.input) {
+					case Input::SWITCH_TO_1:
+					case Input::SWITCH_TO_2:
+					case Input::SWITCH_TO_3:
+						guiSwitch = event.input;
+						break;
+					case Input::EXIT:
+						quitByPlayer = true;
+						break;
+					case Input::NONE:
+						break;
+					default:
+						if (chaosEnabled)
+							event.input = applyChaosMode(event.input);
+						simulation.getInputs().push(event);
+				}
 			}
+			inputTimer.stop();
 			if (quitByPlayer)
 				break;
+			if (guiSwitch != Input::NONE)
+			{
+				simulation.setPaused(true);
+				IGui* previous = gui;
+				gui = switchGui(guis, switchTarget(guiSwitch), width, height);
+				if (gui != previous)
+				{
+					gui->setStats(stats);
+					guiNames += "+" + guis.currentName();
+				}
+				shownSequence = 0;
+				simulation.setPaused(false);
+				continue;
+			}
 
-			gui->render(game);
-			usleep(100000);
+			// Rendu du dernier instantané publié par la simulation
+			bool fresh = simulation.acquireFrame();
+			const Frame& frame = simulation.getFrame();
+			bool smooth = gui->isSmooth();
+			if (fresh || smooth)
+			{
+				ScopedTimer renderTimer(stats, StatsPhase::RENDER);
+				gui->setInterpolation(simulation.getAlpha());
+				// Instantané suivant celui affiché : ses seuls changements suffisent
+				bool incremental = fresh && frame.follows(shownSequence)
+					&& !frame.isHelpMenuActive() && !shownHelp;
+				bool applied = incremental && gui->apply(frame.getEvents());
+				if (!applied)
+					gui->render(frame);
+				if (stats)
+					stats->count(applied ? StatsCounter::APPLIES : StatsCounter::RENDERS);
+				shownSequence = frame.getSequence();
+				shownHelp = frame.isHelpMenuActive();
+			}
+			// Fin de partie, ou enregistrement rejoué jusqu’à son dernier instantané
+			if (frame.isFinished() || (simulation.isDone() && !fresh))
+				break;
+
+			std::chrono::nanoseconds wait = frameInterval;
+			if (wait.count() == 0 && !smooth)
+				wait = std::chrono::milliseconds(1);
+			ScopedTimer sleepTimer(stats, StatsPhase::SLEEP);
+			std::this_thread::sleep_until(frameStart + wait);
+		}
+		simulation.stop();
+		simulation.acquireFrame();
+		showEndScreen(simulation.getFrame(), gui, quitByPlayer);
+		guis.close();
+		if (recorder)
+			recorder->save(options.recordPath, simulation.getTicks(), simulation.getGame());
+		if (!options.savePath.empty())
+			saveSnapshot(simulation.getGame(), options.savePath);
+		bool replayMatches = true;
+		if (replay && !quitByPlayer)
+		{
+			const GameState& game = simulation.getGame();
+			replayMatches = simulation.getTicks() == replay->getTicks()
+				&& game.getScore() == replay->getScore() && game.hash() == replay->getHash();
+			std::cout << "replay: " << (replayMatches ? "match" : "MISMATCH") << "\n";
+		}
+		if (stats)
+		{
+			stats->count(StatsCounter::DROPPED_INPUTS,
+				inputs.getDropped() + simulation.getInputs().getDropped());
+			stats->setInfo("gui", guiNames);
+			stats->setInfo("board", std::to_string(width) + "x" + std::to_string(height));
+			stats->setInfo("obstacles", options.obstacles ? "yes" : "no");
+			stats->setInfo("seed", std::to_string(options.seed));
+			stats->setInfo("tick_rate_hz", std::to_string(options.tickRate));
+			stats->setInfo("fps", std::to_string(options.fps));
+			stats->setInfo("autopilot", options.autopilot ? "astar" : options.hamilton ? "hamilton"
+				: mcts ? "mcts" : plugin ? plugin->getPath() : "no");
+			stats->setInfo("score_cap", std::to_string(simulation.getGame().getScoreLimit()));
+			stats->save(options.statsPath);
+		}
+		if (options.tickStats)
+		{
+			simulation.getScheduler().printReport(std::cout);
+			std::cout << "input_latency_p50_ns: " << simulation.getInputLatency().percentile(50) << "\n"
+			          << "input_latency_p99_ns: " << simulation.getInputLatency().percentile(99) << "\n";
+			const Histogram* plan = autopilot ? &autopilot->getPlanTimes()
+				: hamilton ? &hamilton->getPlanTimes() : mcts ? &mcts->getPlanTimes()
+				: plugin ? &plugin->getPlanTimes() : nullptr;
+			if (plan)
+				std::cout << "plan_p50_ns: " << plan->percentile(50) << "\n"
+				          << "plan_p99_ns: " << plan->percentile(99) << "\n"
+				          << "plan_max_ns: " << plan->getMax() << "\n";
+			if (mcts)
+				std::cout << "playouts_per_sec: "
+				          << mcts->getPlayouts() * 1e9 / std::max<uint64_t>(mcts->getSearchNs(), 1) << "\n";
 		}
-		showEndScreen(game, gui, quitByPlayer);
-		gui->cleanup();
-		delete gui;
-		return 0;
+		return replayMatches ? 0 : 1;
 	} catch (const std::exception& e) {
 		std::cerr << "❌ Error: " << e.what() << std::endl;
 		return 1;